@@ -0,0 +1,61 @@
+"""
+Compare benchmark results written by run_benchmark.py against a baseline.
+Return a nonzero exit status if the trials or pairs per second decreased, or
+the peak resident set size increased, by more than the tolerance.
+
+Usage:
+
+    python3 compare_benchmark.py --baseline baseline.json --current benchmark.json
+"""
+
+import argparse
+import json
+import sys
+
+PARSER = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+PARSER.add_argument('--baseline', type=str, required=True, help='baseline JSON file')
+PARSER.add_argument('--current', type=str, required=True, help='current JSON file')
+PARSER.add_argument('--tolerance', type=float, default=0.1,
+                    help='allowed fractional change before a regression is reported')
+ARGS, UNKNOWN_ARGS = PARSER.parse_known_args()
+assert len(UNKNOWN_ARGS) == 0, 'An unknown argument was included: '+str(UNKNOWN_ARGS)
+
+# metrics and whether larger values are better
+METRICS = [('trials_per_second', True),
+           ('pairs_per_second', True),
+           ('peak_rss_kb', False)]
+
+def read(filename):
+    """ Return the benchmarks in the file as a dictionary by name. """
+    with open(filename, 'r', encoding='utf-8') as file1:
+        return {bench['name']: bench for bench in json.load(file1)['benchmarks']}
+
+baseline = read(ARGS.baseline)
+current = read(ARGS.current)
+num_regressions = 0
+print('{:<16} {:<18} {:>14} {:>14} {:>8}'.format(
+    'name', 'metric', 'baseline', 'current', 'ratio'))
+for name, bench in current.items():
+    if name not in baseline:
+        print(name, 'is not in the baseline')
+        continue
+    for metric, larger_is_better in METRICS:
+        old = baseline[name][metric]
+        new = bench[metric]
+        if old == 0:
+            continue
+        ratio = new/old
+        regression = (larger_is_better and ratio < 1 - ARGS.tolerance) or \
+                     (not larger_is_better and ratio > 1 + ARGS.tolerance)
+        flag = ''
+        if regression:
+            flag = ' REGRESSION'
+            num_regressions += 1
+        print('{:<16} {:<18} {:>14.6g} {:>14.6g} {:>8.3f}{}'.format(
+            name, metric, old, new, ratio, flag))
+for name in baseline:
+    if name not in current:
+        print(name, 'is in the baseline but was not run')
+if num_regressions > 0:
+    print(num_regressions, 'regressions beyond a tolerance of', ARGS.tolerance)
+    sys.exit(1)
@@ -0,0 +1,61 @@
+"""
+Run each benchmark input file with the feasst_benchmark executable and write
+the results to a JSON file.
+
+Usage (typically through "make benchmark" in the build directory):
+
+    python3 run_benchmark.py --executable bin/feasst_benchmark --output benchmark.json
+"""
+
+import argparse
+import datetime
+import json
+import platform
+import subprocess
+from pathlib import Path
+
+PARSER = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+PARSER.add_argument('--executable', type=str, default='bin/feasst_benchmark',
+                    help='path to the feasst_benchmark executable')
+PARSER.add_argument('--inputs', type=str, default=str(Path(__file__).parent),
+                    help='directory of the benchmark input files')
+PARSER.add_argument('--filter', type=str, default='',
+                    help='only run benchmarks whose name contains this string')
+PARSER.add_argument('--repeat', type=int, default=1,
+                    help='run each benchmark this many times and keep the fastest')
+PARSER.add_argument('--output', type=str, default='benchmark.json',
+                    help='name of the JSON file to write')
+ARGS, UNKNOWN_ARGS = PARSER.parse_known_args()
+assert len(UNKNOWN_ARGS) == 0, 'An unknown argument was included: '+str(UNKNOWN_ARGS)
+
+def is_input(filename):
+    """ Return True if the file is a benchmark input (not a TrialGrowFile). """
+    with open(filename, 'r', encoding='utf-8') as file1:
+        for line in file1:
+            if line.strip() != '' and line[0] != '#':
+                return line.strip() == 'MonteCarlo'
+    return False
+
+def run(filename):
+    """ Return the fastest result of the benchmark. """
+    best = None
+    for _ in range(ARGS.repeat):
+        proc = subprocess.run([ARGS.executable, str(filename), filename.stem],
+                              capture_output=True, text=True, check=True)
+        result = json.loads(proc.stdout.strip().split('\n')[-1])
+        if best is None or result['seconds'] < best['seconds']:
+            best = result
+    return best
+
+results = list()
+for filename in sorted(Path(ARGS.inputs).glob('*.txt')):
+    if ARGS.filter in filename.stem and is_input(filename):
+        print('Running:', filename.stem, flush=True)
+        results.append(run(filename))
+        print(json.dumps(results[-1]), flush=True)
+with open(ARGS.output, 'w', encoding='utf-8') as file1:
+    json.dump({'date': datetime.datetime.now().isoformat(),
+               'host': platform.node(),
+               'processor': platform.processor(),
+               'benchmarks': results}, file1, indent=2)
+print('Wrote:', ARGS.output)
@@ -12,6 +12,7 @@
 #include "configuration/include/domain.h"
 #include "configuration/include/configuration.h"
 #include "system/include/model_two_body.h"
+#include "system/include/visit_counters.h"
 #include "aniso/include/visit_model_inner_table.h"
 
 namespace feasst {
@@ -440,6 +441,7 @@ void VisitModelInnerTable::compute(
   const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
   double squared_distance;
   config->domain().wrap_opt(site1.position(), site2.position(), relative, pbc, &squared_distance);
+  FEASST_VISIT_COUNT(pairs_tested);
   TRACE("squared_distance " << squared_distance);
   TRACE("relative " << relative->str());
   TRACE("cutoff " << cutoff);
@@ -447,6 +449,7 @@ void VisitModelInnerTable::compute(
     return;
   }
   TRACE("inside global cut");
+  FEASST_VISIT_COUNT(pairs_in_cutoff);
 
   // compute scaled coordinates
   const int dimen = config->dimension();
@@ -55,6 +55,10 @@ class Ewald : public VisitModel {
     - kzmax: same as above, but in the third dimension.
     - kmax_squared: optionally set the squared maximum integer wave vector for
       cubic domains only, which also sets kxmax, etc.
+    - VisitModel arguments, where parallel computes the structure factors of
+      the entire configuration in parallel.
+      The particles are divided into blocks independent of the number of
+      threads, and the structure factors of the blocks are summed in order.
    */
   explicit Ewald(argtype args = argtype());
   explicit Ewald(argtype * args);
@@ -106,7 +110,9 @@ class Ewald : public VisitModel {
     const double vy, const double vz, const double wz,
     std::vector<double> * struct_fact_real,
     std::vector<double> * struct_fact_imag,
-    std::vector<std::vector<std::vector<double> > > * eik_new) const;
+    std::vector<std::vector<std::vector<double> > > * eik_new,
+    /// If true and compiled with OpenMP, compute the particles in parallel.
+    const bool is_parallel = false) const;
 
   /// Process tolerance arguments and initialize wave vectors.
   void precompute(Configuration * config) override;
@@ -294,6 +300,19 @@ class Ewald : public VisitModel {
   /// If Configuraiton has no particles but num_sites != 0, assume first particle type.
   double sum_squared_charge_(const Configuration& config, const int num_sites);
 
+  // Compute the new eik of one particle in the selection and update the given
+  // structure factor.
+  void update_particle_struct_fact_eik_(const int select_index,
+    const Select& selection,
+    const Configuration& config,
+    const std::vector<double>& wave_prefactor,
+    const std::vector<int>& wave_num,
+    const double ux, const double uy, const double uz,
+    const double vy, const double vz, const double wz,
+    std::vector<double> * struct_fact_real,
+    std::vector<double> * struct_fact_imag,
+    std::vector<std::vector<std::vector<double> > > * eik_new) const;
+
   /// Return the Fourier root mean squared accuracy for a given dimension.
   double fourier_rms_(
       const double alpha,
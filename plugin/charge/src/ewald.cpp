@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cmath>  // isnan, pow
+#include <algorithm>  // min
 #include "utils/include/arguments.h"
 #include "utils/include/serialize.h"
 #include "utils/include/utils.h"  // find_in_list
@@ -17,7 +18,7 @@ namespace feasst {
 
 FEASST_MAPPER(Ewald,);
 
-Ewald::Ewald(argtype * args) {
+Ewald::Ewald(argtype * args) : VisitModel(args) {
   class_name_ = "Ewald";
   if (used("tolerance", *args)) {
     tolerance_ = std::make_shared<double>(dble("tolerance", args));
@@ -229,7 +230,8 @@ void Ewald::update_struct_fact_eik(const Select& selection,
     const double vy, const double vz, const double wz,
     std::vector<double> * sf_real,
     std::vector<double> * sf_imag,
-    std::vector<std::vector<std::vector<double> > > * eik_new) const {
+    std::vector<std::vector<std::vector<double> > > * eik_new,
+    const bool is_parallel) const {
   ASSERT(charge_index() != -1,
     "The particle does not have charge as a Site Property");
   DEBUG("select " << selection.str());
@@ -247,7 +249,6 @@ void Ewald::update_struct_fact_eik(const Select& selection,
 //  const double twopilx = 2.*PI/lx,
 //               twopily = 2.*PI/ly,
 //               twopilz = 2.*PI/lz;
-  const int state = selection.trial_state();
 
   // resize eik_new
   {
@@ -278,122 +279,166 @@ void Ewald::update_struct_fact_eik(const Select& selection,
     }
   }
 
-  for (int select_index = 0;
-       select_index < selection.num_particles();
-       ++select_index) {
-    const int part_index = selection.particle_index(select_index);
-    const double struct_sign = sign_(selection, select_index);
-    for (int ss_index = 0; ss_index < selection.num_sites(select_index); ++ss_index) {
-      const int site_index = selection.site_index(select_index, ss_index);
-      const Site& site = config.select_particle(part_index).site(site_index);
-      if (site.is_physical()) {
-        const int eikrx0_index = 0.;
-        const int eikry0_index = eikrx0_index + kxmax_ + kymax_ + 1;//num_kx_ + kmax_;
-        const int eikrz0_index = eikry0_index + kymax_ + kzmax_ + 1;//num_ky_;
-        const int eikix0_index = eikrz0_index + kzmax_ + 1;//num_kx_ + num_ky_ + num_kz_;
-        const int eikiy0_index = eikix0_index + kxmax_ + kymax_ + 1;//num_kx_ + kmax_;
-        const int eikiz0_index = eikiy0_index + kymax_ + kzmax_ + 1;//num_ky_;
-        TRACE(eikrx0_index << " " << eikry0_index << " " << eikrz0_index << " "
-          << eikix0_index << " " << eikiy0_index << " " << eikiz0_index);
-        const std::vector<double> * const_eikn;
-
-        // update the eik of the selection
-        if (state == 0 || state == 2) {
-          const_eikn = const_cast<const std::vector<double>*>(
-            &(eik()[part_index][site_index]));
-        } else {
-          std::vector<double> * eikn = &(*eik_new)[select_index][ss_index];
-          const_eikn = const_cast<std::vector<double>*>(eikn);
-          (*eikn)[eikrx0_index] = 1.;
-          (*eikn)[eikix0_index] = 0.;
-          (*eikn)[eikry0_index] = 1.;
-          (*eikn)[eikiy0_index] = 0.;
-          (*eikn)[eikrz0_index] = 1.;
-          (*eikn)[eikiz0_index] = 0.;
-
-          // calculate eik of kx = +/-1 explicitly
-          const std::vector<double>& pos = config.select_particle(part_index).site(site_index).position().coord();
-          const double x = pos[0];
-          const double y = pos[1];
-          const double z = pos[2];
-          //const double udotr = 2.*PI*(x/lx - y*xy/lx/ly + z*(xy*yz/lx/ly/lz - xz/lx/lz));
-          const double udotr = ux*x + uy*y + uz*z;
-          //const double vdotr = 2.*PI*(y/ly - z*yz/ly/lz);
-          const double vdotr = vy*y + vz*z;
-          //const double wdotr = 2.*PI*z/lz;
-          const double wdotr = wz*z;
-          (*eikn)[eikrx0_index + 1] = std::cos(udotr);
-          (*eikn)[eikix0_index + 1] = std::sin(udotr);
-          (*eikn)[eikry0_index + 1] = std::cos(vdotr);
-          (*eikn)[eikiy0_index + 1] = std::sin(vdotr);
-          (*eikn)[eikrz0_index + 1] = std::cos(wdotr);
-          (*eikn)[eikiz0_index + 1] = std::sin(wdotr);
-          (*eikn)[eikry0_index - 1] = (*eikn)[eikry0_index + 1];
-          (*eikn)[eikiy0_index - 1] = -(*eikn)[eikiy0_index + 1];
-          (*eikn)[eikrz0_index - 1] = (*eikn)[eikrz0_index + 1];
-          (*eikn)[eikiz0_index - 1] = -(*eikn)[eikiz0_index + 1];
-
-          // compute remaining eik by recursion
-          for (int kx = 2; kx <= kxmax_; ++kx) {
-            const double eikr2 = (*eikn)[eikrx0_index + kx - 1]*(*eikn)[eikrx0_index + 1] -
-              (*eikn)[eikix0_index + kx - 1]*(*eikn)[eikix0_index + 1];
-            (*eikn)[eikrx0_index + kx] = eikr2;
-            const double eiki2 = (*eikn)[eikrx0_index + kx - 1]*(*eikn)[eikix0_index + 1] +
-              (*eikn)[eikix0_index + kx - 1]*(*eikn)[eikrx0_index + 1];
-            (*eikn)[eikix0_index + kx] = eiki2;
-          }
-          for (int ky = 2; ky <= kymax_; ++ky) {
-            const double eikr2 = (*eikn)[eikry0_index + ky - 1]*(*eikn)[eikry0_index + 1] -
-              (*eikn)[eikiy0_index + ky - 1]*(*eikn)[eikiy0_index + 1];
-            (*eikn)[eikry0_index + ky] = eikr2;
-            const double eiki2 = (*eikn)[eikry0_index + ky - 1]*(*eikn)[eikiy0_index + 1] +
-              (*eikn)[eikiy0_index + ky - 1]*(*eikn)[eikry0_index + 1];
-            (*eikn)[eikiy0_index + ky] = eiki2;
-            (*eikn)[eikry0_index - ky] = eikr2;
-            (*eikn)[eikiy0_index - ky] = -eiki2;
-          }
-          for (int kz = 2; kz <= kzmax_; ++kz) {
-            const double eikr2 = (*eikn)[eikrz0_index + kz - 1]*(*eikn)[eikrz0_index + 1] -
-              (*eikn)[eikiz0_index + kz - 1]*(*eikn)[eikiz0_index + 1];
-            (*eikn)[eikrz0_index + kz] = eikr2;
-            const double eiki2 = (*eikn)[eikrz0_index + kz - 1]*(*eikn)[eikiz0_index + 1] +
-              (*eikn)[eikiz0_index + kz - 1]*(*eikn)[eikrz0_index + 1];
-            (*eikn)[eikiz0_index + kz] = eiki2;
-            (*eikn)[eikrz0_index - kz] = eikr2;
-            (*eikn)[eikiz0_index - kz] = -eiki2;
-          }
-        }
+  const int num_select = selection.num_particles();
+#ifdef _OPENMP
+  // the particles are divided into a number of blocks that does not depend
+  // on the number of threads. Each block accumulates a separate structure
+  // factor, which are summed in the order of the blocks.
+  if (is_parallel && num_select > 1) {
+    const int num_vectors = static_cast<int>(sf_real->size());
+    const int num_blocks = std::min(num_select, 64);
+    std::vector<std::vector<double> > sf_reals(num_blocks,
+      std::vector<double>(num_vectors, 0.));
+    std::vector<std::vector<double> > sf_imags = sf_reals;
+    #pragma omp parallel for schedule(dynamic)
+    for (int block = 0; block < num_blocks; ++block) {
+      const int first = block*num_select/num_blocks;
+      const int last = (block + 1)*num_select/num_blocks;
+      for (int select_index = first; select_index < last; ++select_index) {
+        update_particle_struct_fact_eik_(select_index, selection, config,
+          wave_prefactor, wave_num, ux, uy, uz, vy, vz, wz,
+          &sf_reals[block], &sf_imags[block], eik_new);
+      }
+    }
+    for (int block = 0; block < num_blocks; ++block) {
+      for (int k_index = 0; k_index < num_vectors; ++k_index) {
+        (*sf_real)[k_index] += sf_reals[block][k_index];
+        (*sf_imag)[k_index] += sf_imags[block][k_index];
+      }
+    }
+    return;
+  }
+#endif // _OPENMP
+  for (int select_index = 0; select_index < num_select; ++select_index) {
+    update_particle_struct_fact_eik_(select_index, selection, config,
+      wave_prefactor, wave_num, ux, uy, uz, vy, vz, wz,
+      sf_real, sf_imag, eik_new);
+  }
+}
 
-        // compute structure factor
-        const int type = site.type();
-        const double charge = config.model_params().select(charge_index()).value(type);
-        for (int k_index = 0; k_index < static_cast<int>(wave_prefactor.size()); ++k_index) {
-          const int kdim = dimension_*k_index;
-          const double kx = wave_num[kdim];
-          const double ky = wave_num[kdim + 1];
-          const double kz = wave_num[kdim + 2];
-          TRACE("k " << k_index << " kx " << kx << " ky " << ky << " kz " << kz << " size " << wave_prefactor.size() << " kdim " << kdim);
-          const double eikrx = (*const_eikn)[eikrx0_index + kx];
-          const double eikix = (*const_eikn)[eikix0_index + kx];
-          const double eikry = (*const_eikn)[eikry0_index + ky];
-          const double eikiy = (*const_eikn)[eikiy0_index + ky];
-          const double eikrz = (*const_eikn)[eikrz0_index + kz];
-          const double eikiz = (*const_eikn)[eikiz0_index + kz];
-          TRACE("eik[r,i]x " << eikrx << " " << eikix << " y " << eikry << " " << eikiy << " z " << eikrz << " " << eikiz << " sz " << const_eikn->size());
-          const double eikr = eikrx*eikry*eikrz
-                     - eikix*eikiy*eikrz
-                     - eikix*eikry*eikiz
-                     - eikrx*eikiy*eikiz;
-          const double eiki = -eikix*eikiy*eikiz
-                     + eikrx*eikry*eikiz
-                     + eikrx*eikiy*eikrz
-                     + eikix*eikry*eikrz;
-          TRACE("charge " << charge << " eikr " << eikr << " eiki " << eiki << " sign " << struct_sign);
-          TRACE(sf_real->size());
-          (*sf_real)[k_index] += struct_sign*charge*eikr;
-          (*sf_imag)[k_index] += struct_sign*charge*eiki;
+void Ewald::update_particle_struct_fact_eik_(const int select_index,
+    const Select& selection,
+    const Configuration& config,
+    const std::vector<double>& wave_prefactor,
+    const std::vector<int>& wave_num,
+    const double ux, const double uy, const double uz,
+    const double vy, const double vz, const double wz,
+    std::vector<double> * sf_real,
+    std::vector<double> * sf_imag,
+    std::vector<std::vector<std::vector<double> > > * eik_new) const {
+  const int state = selection.trial_state();
+  const int part_index = selection.particle_index(select_index);
+  const double struct_sign = sign_(selection, select_index);
+  for (int ss_index = 0; ss_index < selection.num_sites(select_index); ++ss_index) {
+    const int site_index = selection.site_index(select_index, ss_index);
+    const Site& site = config.select_particle(part_index).site(site_index);
+    if (site.is_physical()) {
+      const int eikrx0_index = 0.;
+      const int eikry0_index = eikrx0_index + kxmax_ + kymax_ + 1;//num_kx_ + kmax_;
+      const int eikrz0_index = eikry0_index + kymax_ + kzmax_ + 1;//num_ky_;
+      const int eikix0_index = eikrz0_index + kzmax_ + 1;//num_kx_ + num_ky_ + num_kz_;
+      const int eikiy0_index = eikix0_index + kxmax_ + kymax_ + 1;//num_kx_ + kmax_;
+      const int eikiz0_index = eikiy0_index + kymax_ + kzmax_ + 1;//num_ky_;
+      TRACE(eikrx0_index << " " << eikry0_index << " " << eikrz0_index << " "
+        << eikix0_index << " " << eikiy0_index << " " << eikiz0_index);
+      const std::vector<double> * const_eikn;
+
+      // update the eik of the selection
+      if (state == 0 || state == 2) {
+        const_eikn = const_cast<const std::vector<double>*>(
+          &(eik()[part_index][site_index]));
+      } else {
+        std::vector<double> * eikn = &(*eik_new)[select_index][ss_index];
+        const_eikn = const_cast<std::vector<double>*>(eikn);
+        (*eikn)[eikrx0_index] = 1.;
+        (*eikn)[eikix0_index] = 0.;
+        (*eikn)[eikry0_index] = 1.;
+        (*eikn)[eikiy0_index] = 0.;
+        (*eikn)[eikrz0_index] = 1.;
+        (*eikn)[eikiz0_index] = 0.;
+
+        // calculate eik of kx = +/-1 explicitly
+        const std::vector<double>& pos = config.select_particle(part_index).site(site_index).position().coord();
+        const double x = pos[0];
+        const double y = pos[1];
+        const double z = pos[2];
+        //const double udotr = 2.*PI*(x/lx - y*xy/lx/ly + z*(xy*yz/lx/ly/lz - xz/lx/lz));
+        const double udotr = ux*x + uy*y + uz*z;
+        //const double vdotr = 2.*PI*(y/ly - z*yz/ly/lz);
+        const double vdotr = vy*y + vz*z;
+        //const double wdotr = 2.*PI*z/lz;
+        const double wdotr = wz*z;
+        (*eikn)[eikrx0_index + 1] = std::cos(udotr);
+        (*eikn)[eikix0_index + 1] = std::sin(udotr);
+        (*eikn)[eikry0_index + 1] = std::cos(vdotr);
+        (*eikn)[eikiy0_index + 1] = std::sin(vdotr);
+        (*eikn)[eikrz0_index + 1] = std::cos(wdotr);
+        (*eikn)[eikiz0_index + 1] = std::sin(wdotr);
+        (*eikn)[eikry0_index - 1] = (*eikn)[eikry0_index + 1];
+        (*eikn)[eikiy0_index - 1] = -(*eikn)[eikiy0_index + 1];
+        (*eikn)[eikrz0_index - 1] = (*eikn)[eikrz0_index + 1];
+        (*eikn)[eikiz0_index - 1] = -(*eikn)[eikiz0_index + 1];
+
+        // compute remaining eik by recursion
+        for (int kx = 2; kx <= kxmax_; ++kx) {
+          const double eikr2 = (*eikn)[eikrx0_index + kx - 1]*(*eikn)[eikrx0_index + 1] -
+            (*eikn)[eikix0_index + kx - 1]*(*eikn)[eikix0_index + 1];
+          (*eikn)[eikrx0_index + kx] = eikr2;
+          const double eiki2 = (*eikn)[eikrx0_index + kx - 1]*(*eikn)[eikix0_index + 1] +
+            (*eikn)[eikix0_index + kx - 1]*(*eikn)[eikrx0_index + 1];
+          (*eikn)[eikix0_index + kx] = eiki2;
+        }
+        for (int ky = 2; ky <= kymax_; ++ky) {
+          const double eikr2 = (*eikn)[eikry0_index + ky - 1]*(*eikn)[eikry0_index + 1] -
+            (*eikn)[eikiy0_index + ky - 1]*(*eikn)[eikiy0_index + 1];
+          (*eikn)[eikry0_index + ky] = eikr2;
+          const double eiki2 = (*eikn)[eikry0_index + ky - 1]*(*eikn)[eikiy0_index + 1] +
+            (*eikn)[eikiy0_index + ky - 1]*(*eikn)[eikry0_index + 1];
+          (*eikn)[eikiy0_index + ky] = eiki2;
+          (*eikn)[eikry0_index - ky] = eikr2;
+          (*eikn)[eikiy0_index - ky] = -eiki2;
+        }
+        for (int kz = 2; kz <= kzmax_; ++kz) {
+          const double eikr2 = (*eikn)[eikrz0_index + kz - 1]*(*eikn)[eikrz0_index + 1] -
+            (*eikn)[eikiz0_index + kz - 1]*(*eikn)[eikiz0_index + 1];
+          (*eikn)[eikrz0_index + kz] = eikr2;
+          const double eiki2 = (*eikn)[eikrz0_index + kz - 1]*(*eikn)[eikiz0_index + 1] +
+            (*eikn)[eikiz0_index + kz - 1]*(*eikn)[eikrz0_index + 1];
+          (*eikn)[eikiz0_index + kz] = eiki2;
+          (*eikn)[eikrz0_index - kz] = eikr2;
+          (*eikn)[eikiz0_index - kz] = -eiki2;
         }
       }
+
+      // compute structure factor
+      const int type = site.type();
+      const double charge = config.model_params().select(charge_index()).value(type);
+      for (int k_index = 0; k_index < static_cast<int>(wave_prefactor.size()); ++k_index) {
+        const int kdim = dimension_*k_index;
+        const double kx = wave_num[kdim];
+        const double ky = wave_num[kdim + 1];
+        const double kz = wave_num[kdim + 2];
+        TRACE("k " << k_index << " kx " << kx << " ky " << ky << " kz " << kz << " size " << wave_prefactor.size() << " kdim " << kdim);
+        const double eikrx = (*const_eikn)[eikrx0_index + kx];
+        const double eikix = (*const_eikn)[eikix0_index + kx];
+        const double eikry = (*const_eikn)[eikry0_index + ky];
+        const double eikiy = (*const_eikn)[eikiy0_index + ky];
+        const double eikrz = (*const_eikn)[eikrz0_index + kz];
+        const double eikiz = (*const_eikn)[eikiz0_index + kz];
+        TRACE("eik[r,i]x " << eikrx << " " << eikix << " y " << eikry << " " << eikiy << " z " << eikrz << " " << eikiz << " sz " << const_eikn->size());
+        const double eikr = eikrx*eikry*eikrz
+                   - eikix*eikiy*eikrz
+                   - eikix*eikry*eikiz
+                   - eikrx*eikiy*eikiz;
+        const double eiki = -eikix*eikiy*eikiz
+                   + eikrx*eikry*eikiz
+                   + eikrx*eikiy*eikrz
+                   + eikix*eikry*eikrz;
+        TRACE("charge " << charge << " eikr " << eikr << " eiki " << eiki << " sign " << struct_sign);
+        TRACE(sf_real->size());
+        (*sf_real)[k_index] += struct_sign*charge*eikr;
+        (*sf_imag)[k_index] += struct_sign*charge*eiki;
+      }
     }
   }
 }
@@ -548,7 +593,8 @@ void Ewald::compute(
                          vy_new(), vz_new_, wz_new(),
                          struct_fact_real_new_(),
                          struct_fact_imag_new_(),
-                         eik_new_());
+                         eik_new_(),
+                         parallel());
   const double conversion = model_params.constants().charge_conversion();
   stored_energy_new_ = conversion*fourier_energy_(struct_fact_real_new(),
                                                   struct_fact_imag_new(),
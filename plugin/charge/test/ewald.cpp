@@ -1,4 +1,7 @@
 #include <cmath>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif // _OPENMP
 #include "utils/test/utils.h"
 #include "configuration/test/config_utils.h"
 #include "math/include/random_mt19937.h"
@@ -60,6 +63,47 @@ TEST(Ewald, ewald) {
   EXPECT_NEAR(ewald2->energy(), en, 1e-12);
 }
 
+TEST(Ewald, parallel) {
+  Configuration config = spce_sample1();
+  const argtype args = {
+    {"alpha", str(5.6/config.domain().inscribed_sphere_diameter())},
+    {"kmax_squared", "27"}};
+  auto ewald = MakeEwald(args);
+  ewald->precompute(&config);
+  ModelEmpty model;
+  model.compute(&config, ewald.get());
+  ewald->finalize(config.selection_of_all(), &config);
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+#endif  // _OPENMP
+  std::vector<double> energies;
+  for (const int threads : {2, 3}) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+    EXPECT_EQ(threads, omp_get_max_threads());
+#endif  // _OPENMP
+    argtype parallel_args = args;
+    parallel_args.insert({"parallel", "true"});
+    auto parallel_ewald = MakeEwald(parallel_args);
+    parallel_ewald->precompute(&config);
+    model.compute(&config, parallel_ewald.get());
+    parallel_ewald->finalize(config.selection_of_all(), &config);
+    EXPECT_NEAR(parallel_ewald->eik()[0][0][1], ewald->eik()[0][0][1],
+                NEAR_ZERO);
+    EXPECT_NEAR(parallel_ewald->struct_fact_real()[0],
+                ewald->struct_fact_real()[0], 1e-13);
+    EXPECT_NEAR(parallel_ewald->struct_fact_imag()[0],
+                ewald->struct_fact_imag()[0], 1e-13);
+    EXPECT_NEAR(parallel_ewald->energy(), ewald->energy(), 1e-12);
+    energies.push_back(parallel_ewald->energy());
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif  // _OPENMP
+  // the sum does not depend on the number of threads
+  EXPECT_EQ(energies[0], energies[1]);
+}
+
 TEST(Ewald, system) {
   const double en_lrc = -6.84874714555147;
   {
@@ -130,6 +130,10 @@ class Configuration {
   /// Return the number of particle types.
   int num_particle_types() const;
 
+  /// Return a number that changes whenever the particle types are changed.
+  /// A copy of a Configuration has the same revision.
+  int particle_types_revision() const { return particle_types_revision_; }
+
   /// Return the number of site types.
   int num_site_types() const;
 
@@ -284,6 +288,8 @@ class Configuration {
   //@{
 
   /// Add a particle of a given type.
+  /// If there are ghosts of the type, the most recently removed ghost is
+  /// reused in constant time.
   void add_particle_of_type(const int type);
 
   /// Return particle by index. Note this index is contiguous from values
@@ -358,7 +364,10 @@ class Configuration {
   void update_positions(const std::vector<std::vector<double> > coords,
                         const std::vector<std::vector<double> > eulers);
 
-  /// Update the positions and properties from a selection.
+  /// Update the positions from a selection, and the site properties if
+  /// Select::is_site_properties_modified.
+  /// Only the site properties are tracked. Changed positions are not, so the
+  /// positions of every site in the selection are always copied.
   /// Includes euler angles.
   void update_positions(const Select& select,
     /// If true, do not wrap. If false, defer to default behavior.
@@ -384,6 +393,10 @@ class Configuration {
   void replace_position(const Select& select, const Particle& replacement);
 
   /// Remove particle(s) in selection.
+  /// Groups other than selection_of_all and the ghosts are updated in
+  /// constant time.
+  /// But selection_of_all keeps its order, so its update is linear in the
+  /// number of particles.
   void remove_particles(const Select& selection);
 
   /// Same as above except for only one particle that is selected.
@@ -643,9 +656,11 @@ class Configuration {
   void add_to_selection_(const int particle_index,
                          Select * select) const;
 
-  /// Update particle in selection.
-  void update_selection_(const int particle_index,
-                         Select * select) const;
+  /// Add particle to a group, in constant time.
+  void add_to_group_(const int particle_index, const int group);
+
+  /// Update particle in a group, in constant time.
+  void update_group_(const int particle_index, const int group);
 
   /// Initialize selection based on groups
   /// Initialize selection based on groups
@@ -668,6 +683,28 @@ class Configuration {
   /// Return the number of ghost particles.
   int num_ghosts_() const;
 
+  // The index of each particle in each group select, or -1 if not in the
+  // group. The first index is the group, and the second is the particle.
+  // Likewise, the index of each particle in the ghosts of its type.
+  // These allow particles to be added or removed in constant time.
+  // The first group, selection_of_all, keeps its order and has no slots.
+  // Not serialized, but rebuilt from the selects.
+  std::vector<std::vector<int> > group_slot_;
+  std::vector<int> ghost_slot_;
+
+  // Not serialized, but revised upon deserialization.
+  int particle_types_revision_ = 0;
+  void revise_particle_types_();
+
+  void add_with_slot_(const int particle_index,
+                      const std::vector<int>& site_indices,
+                      Select * select,
+                      std::vector<int> * slots);
+  void remove_with_slot_(const int particle_index,
+                         Select * select,
+                         std::vector<int> * slots);
+  void build_slots_();
+
   const Particle& particle_(const int index);
 
   /// Store the files used to initialize particle types.
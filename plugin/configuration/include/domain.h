@@ -163,7 +163,10 @@ class Domain {
   double yz() const { return yz_; }
 
   /// Disable periodicity in a given dimension.
-  void disable(const int dimension) { periodic_[dimension] = false; }
+  void disable(const int dimension) {
+    periodic_[dimension] = false;
+    update_h_();
+  }
 
   /// Return true if given dimension is periodic.
   bool periodic(const int dimension) const { return periodic_[dimension]; }
@@ -212,6 +215,16 @@ class Domain {
   /// Return the largest possible diameter of a sphere inscribed inside domain.
   double inscribed_sphere_diameter() const;
 
+  /**
+    Return the perpendicular distance between the two faces of the domain
+    that are crossed by the given dimension of the scaled coordinates.
+    This is the side length if the domain is not tilted.
+    Cells of a cell list which are at least this wide, divided by the number
+    of cells in the given dimension, contain all neighbors within that width
+    in the adjacent cells.
+   */
+  double perpendicular_width(const int dimension) const;
+
   /// Return true if the given cutoff follows the minimum image convention in
   /// the periodic boundaries.
   bool is_minimum_image_for_cutoff(const double cutoff) const;
@@ -257,6 +270,8 @@ class Domain {
   bool is_tilted_ = false;
   std::vector<bool> periodic_;
   Matrix h_, h_inv_; // Section 4.1 of https://doi.org/10.1080/08927022.2013.819102
+  // inverse side length if periodic, otherwise zero.
+  std::vector<double> periodic_inv_side_;  // not serialized
 
   /// used for optimized pbc
   Position opt_origin_, opt_rel_, opt_pbc_;
@@ -151,7 +151,7 @@ class Particle : public PropertiedEntity {
   const Bond& bond(const int index) const { return bonds_[index]; }
 
   /// Return the bonds.
-  const std::vector<Bond> bonds() const { return bonds_; }
+  const std::vector<Bond>& bonds() const { return bonds_; }
 
   /// Add a bond.
   void add_bond(const Bond& bond);
@@ -186,7 +186,7 @@ class Particle : public PropertiedEntity {
   const Angle& angle(const int index) const { return angles_[index]; }
 
   /// Return the angles.
-  const std::vector<Angle> angles() const { return angles_; }
+  const std::vector<Angle>& angles() const { return angles_; }
 
   /// Add an angle.
   void add_angle(const Angle& angle);
@@ -219,7 +219,7 @@ class Particle : public PropertiedEntity {
   const Dihedral& dihedral(const int index) const { return dihedrals_[index]; }
 
   /// Return the dihedrals.
-  const std::vector<Dihedral> dihedrals() const { return dihedrals_; }
+  const std::vector<Dihedral>& dihedrals() const { return dihedrals_; }
 
   /// Add a dihedral.
   void add_dihedral(const Dihedral& dihedral);
@@ -7,9 +7,34 @@
 
 namespace feasst {
 
+/**
+  An interned property name, which is resolved once to an integer that is
+  the same for all Properties.
+  Accessing Properties by PropertyKey avoids the construction and comparison
+  of strings, and is intended for repeated lookups such as in energy
+  functions (e.g., a function-local static PropertyKey).
+ */
+class PropertyKey {
+ public:
+  /// Intern the name of the property.
+  explicit PropertyKey(const std::string& name);
+
+  /// Return the integer key.
+  int key() const { return key_; }
+
+  /// Return the name of the property.
+  std::string name() const;
+
+ private:
+  int key_;
+};
+
 /**
   Manage custom properties (sites, bonds, etc), typically for use in plugins.
+  The names are stored as interned integer keys, such that each property
+  requires only an integer and a value.
   There is a performance cost associated with accessing the properties by name.
+  Instead, use PropertyKey for repeated lookups.
   But accessing the values by index should be done carefully.
  */
 class Properties {
@@ -40,11 +65,37 @@ class Properties {
     return value(name, &val);
   }
 
+  /// Return the index of the property key, or -1 if not found.
+  int index(const PropertyKey& key) const {
+    for (int index = 0; index < static_cast<int>(keys_.size()); ++index) {
+      if (keys_[index] == key.key()) {
+        return index;
+      }
+    }
+    return -1;
+  }
+
+  /// Return property value by key.
+  double value(const PropertyKey& key) const;
+
+  /// Return true if property key exists, and its value.
+  bool value(const PropertyKey& key, double * value) const {
+    const int ind = index(key);
+    if (ind == -1) {
+      return false;
+    }
+    *value = values_[ind];
+    return true;
+  }
+
+  /// Return true if property key exists.
+  bool has(const PropertyKey& key) const { return index(key) != -1; }
+
   /// Check that the property values and names are consistent.
   void check() const;
 
   /// Return all property names.
-  const std::vector<std::string>& names() const { return names_; }
+  std::vector<std::string> names() const;
 
   /// Return all property values.
   const std::vector<double>& values() const { return values_; }
@@ -72,7 +123,7 @@ class Properties {
 
  private:
   std::vector<double> values_;
-  std::vector<std::string> names_;
+  std::vector<int> keys_;
 };
 
 class PropertiedEntity {
@@ -102,6 +153,14 @@ class PropertiedEntity {
   bool has_property(const std::string name) const {
     return properties_.has(name); }
 
+  /// Return the property value by key.
+  double property(const PropertyKey& key) const {
+    return properties_.value(key); }
+
+  /// Return true if entity has property of key.
+  bool has_property(const PropertyKey& key) const {
+    return properties_.has(key); }
+
   /// Set value of property by index.
   void set_property(const int index, const double value) {
     properties_.set_value(index, value); }
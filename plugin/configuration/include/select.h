@@ -2,6 +2,7 @@
 #ifndef FEASST_CONFIGURATION_SELECT_H_
 #define FEASST_CONFIGURATION_SELECT_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -70,7 +71,7 @@ class Select {
 
   /// Add particle index and site indices of that particle.
   void add_particle(const int particle_index,
-    std::vector<int> site_indices,
+    const std::vector<int>& site_indices,
     /// optionally prevent duplicates (slower)
     const bool prevent_duplicate = false);
 
@@ -115,6 +116,11 @@ class Select {
   /// Remove particle by index.
   void remove_particle(const int particle_index);
 
+  /// Remove the particle with the given index of the selection (not the
+  /// particle index) in constant time by replacing it with the last particle.
+  /// Thus, the order of the particles is not preserved.
+  void remove_particle_unordered(const int select_index);
+
   /// Return the particle indices.
   const std::vector<int>& particle_indices() const { return particle_indices_; }
 
@@ -207,6 +213,18 @@ class Select {
                            const int site_index,
                            const Properties& properties);
 
+  /**
+    Return true if the site properties may differ from those of the
+    Configuration from which the positions were last loaded.
+    For example, when set_site_properties or the constructors with a
+    Particle or ParticleFactory are used.
+    Otherwise, Configuration::update_positions only replaces the positions,
+    because a trial does not change the site properties.
+    Positions and eulers are not tracked, and are always copied in full.
+   */
+  bool is_site_properties_modified() const {
+    return is_site_properties_modified_; }
+
   /// Load the positions of a particle with existing selection indices.
   void load_position(const int pindex, const Particle& particle);
 
@@ -307,6 +325,20 @@ class Select {
   /// Sort from lowest to highest particle index.
   void sort();
 
+  /**
+    Return the number of Select constructed by the current thread, including
+    copies, since the last reset.
+    Trials reuse their Select (e.g., TrialSelect::mobile and
+    Acceptance::perturbed) by assignment, which retains the capacity of the
+    vectors, such that this number should not increase with the number of
+    trials.
+    Always zero unless compiled with "cmake -DUSE_VISIT_COUNTERS=ON ..".
+   */
+  static int64_t num_constructed();
+
+  /// Set the number of Select constructed by the current thread to zero.
+  static void reset_num_constructed();
+
   virtual void serialize(std::ostream& ostr) const;
   explicit Select(std::istream& istr);
   virtual ~Select() {}
@@ -322,6 +354,18 @@ class Select {
   std::vector<std::vector<Position> > site_positions_;
   std::vector<std::vector<Properties> > site_properties_;
   std::vector<std::vector<Euler> > site_eulers_;
+  bool is_site_properties_modified_ = false;  // not serialized
+
+#ifdef FEASST_VISIT_COUNTERS
+  // count the constructors, but not the assignments.
+  struct ConstructionCounter_ {
+    ConstructionCounter_();
+    ConstructionCounter_(const ConstructionCounter_& counter);
+    ConstructionCounter_& operator=(const ConstructionCounter_& counter) {
+      return *this; }
+  };
+  ConstructionCounter_ construction_counter_;  // not serialized
+#endif  // FEASST_VISIT_COUNTERS
 
   // remove particle by selection index.
   void remove_particle_(const int select_index);
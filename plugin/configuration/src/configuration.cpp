@@ -1,3 +1,4 @@
+#include <atomic>
 #include "utils/include/arguments.h"
 #include "utils/include/utils.h"
 #include "utils/include/debug.h"
@@ -17,6 +18,13 @@
 
 namespace feasst {
 
+// The last revision of the particle types of any Configuration.
+static std::atomic<int> last_particle_types_revision_(0);
+
+void Configuration::revise_particle_types_() {
+  particle_types_revision_ = ++last_particle_types_revision_;
+}
+
 Configuration::Configuration(argtype args) : Configuration(&args) {
   feasst_check_all_used(args);
 }
@@ -26,6 +34,7 @@ Configuration::Configuration(argtype * args) {
   particle_types_->unique_particles();
   unique_types_ = std::make_shared<ParticleFactory>();
   unique_types_->unique_types();
+  revise_particle_types_();
   particles_ = std::make_shared<ParticleFactory>();
   // reset_unique_indices_();
   add(MakeGroup());  // add empty group which represents all particles
@@ -203,6 +212,7 @@ void Configuration::add_particle_type(const std::string file_name,
   ASSERT(particles_->num() == 0, "types cannot be added after particles");
   particle_types_->add(file_name);
   unique_types_->add(file_name, name);
+  revise_particle_types_();
   ghosts_.push_back(std::make_shared<Select>());
   ASSERT(ghosts_.back()->is_group_empty(), "no ghosts in brand new type");
   type_to_file_.push_back(file_name);
@@ -213,8 +223,8 @@ void Configuration::add_particle_type(const std::string file_name,
 void Configuration::add_(const Particle particle) {
   Particle part = particle;
   particles_->add(part);
-  for (std::shared_ptr<Select> select : group_selects_) {
-    add_to_selection_(particles_->num() - 1, select.get());
+  for (int group = 0; group < num_groups(); ++group) {
+    add_to_group_(particles_->num() - 1, group);
   }
   position_tracker_(particles_->num() - 1);
 }
@@ -236,10 +246,12 @@ void Configuration::add_particle_of_type(const int type) {
   if (ghosts_[type]->num_particles() == 0) {
     add_non_ghost_particle_of_type(type);
   } else {
-    const int index = ghosts_[type]->particle_index(0);
-    ghosts_[type]->remove_particle(index);
-    for (std::shared_ptr<Select> select : group_selects_) {
-      add_to_selection_(index, select.get());
+    // the last ghost is removed in constant time.
+    const Select& ghosts = *ghosts_[type];
+    const int index = ghosts.particle_index(ghosts.num_particles() - 1);
+    remove_with_slot_(index, ghosts_[type].get(), &ghost_slot_);
+    for (int group = 0; group < num_groups(); ++group) {
+      add_to_group_(index, group);
     }
     newest_particle_index_ = index;
     ++num_particles_of_type_[type];
@@ -251,12 +263,19 @@ void Configuration::remove_particle_(const int particle_index) {
   // reset_unique_indices_();
   const int type = particles_->particle(particle_index).type();
   --num_particles_of_type_[type];
-  ghosts_[type]->add_particle(select_particle(particle_index), particle_index);
+  std::vector<int> sites(select_particle(particle_index).num_sites());
+  for (int site = 0; site < static_cast<int>(sites.size()); ++site) {
+    sites[site] = site;
+  }
+  add_with_slot_(particle_index, sites, ghosts_[type].get(), &ghost_slot_);
   DEBUG("type " << type);
   DEBUG("particle index " << particle_index);
   DEBUG("num particles " << num_particles());
-  for (std::shared_ptr<Select> select : group_selects_) {
-    select->remove_particle(particle_index);
+  // selection_of_all keeps its order, so its removal is not constant time.
+  group_selects_[0]->remove_particle(particle_index);
+  for (int group = 1; group < num_groups(); ++group) {
+    remove_with_slot_(particle_index, group_selects_[group].get(),
+                      &group_slot_[group]);
   }
 }
 
@@ -338,6 +357,7 @@ void Configuration::add(std::shared_ptr<Group> group, std::string name) {
   group_select.set_group(group);
   init_selection_(&group_select);
   group_selects_.push_back(std::make_shared<Select>(group_select));
+  build_slots_();
 }
 
 void Configuration::position_tracker_(const int particle_index,
@@ -368,6 +388,15 @@ void Configuration::set(std::shared_ptr<Domain> domain) {
   position_tracker_();
 }
 
+// Return the index of the particle in a Select given its slots, or -1.
+static int find_slot_(const int particle_index,
+                      const std::vector<int>& slots) {
+  if (particle_index < static_cast<int>(slots.size())) {
+    return slots[particle_index];
+  }
+  return -1;
+}
+
 /// HWH add check .. domain, positions, particles, etc
 void Configuration::check() const {
   particles_->check();
@@ -406,6 +435,21 @@ void Configuration::check() const {
       "the same particle cannot be listed as a ghost twice");
   }
 
+  // check the index of each particle in the groups and ghosts
+  for (int group = 1; group < num_groups(); ++group) {
+    const Select& select = *group_selects_[group];
+    for (int index = 0; index < select.num_particles(); ++index) {
+      ASSERT(find_slot_(select.particle_index(index), group_slot_[group]) ==
+        index, "group: " << group << " slot error");
+    }
+  }
+  for (const std::shared_ptr<Select>& ghost : ghosts_) {
+    for (int index = 0; index < ghost->num_particles(); ++index) {
+      ASSERT(find_slot_(ghost->particle_index(index), ghost_slot_) == index,
+        "ghost slot error");
+    }
+  }
+
   model_params().check();
 }
 
@@ -505,14 +549,83 @@ void Configuration::add_to_selection_(const int particle_index,
   }
 }
 
-void Configuration::update_selection_(const int particle_index,
-                                      Select * select) const {
+void Configuration::add_with_slot_(const int particle_index,
+    const std::vector<int>& site_indices,
+    Select * select,
+    std::vector<int> * slots) {
+  if (site_indices.size() == 0) {
+    return;
+  }
+  ASSERT(find_slot_(particle_index, *slots) == -1,
+    "particle: " << particle_index << " is already selected");
+  if (particle_index >= static_cast<int>(slots->size())) {
+    slots->resize(particle_index + 1, -1);
+  }
+  (*slots)[particle_index] = select->num_particles();
+  select->add_particle(particle_index, site_indices);
+}
+
+void Configuration::remove_with_slot_(const int particle_index,
+    Select * select,
+    std::vector<int> * slots) {
+  const int slot = find_slot_(particle_index, *slots);
+  if (slot != -1) {
+    const int last_index = select->particle_index(select->num_particles() - 1);
+    select->remove_particle_unordered(slot);
+    (*slots)[last_index] = slot;
+    (*slots)[particle_index] = -1;
+  }
+}
+
+void Configuration::add_to_group_(const int particle_index, const int group) {
+  Select * select = group_selects_[group].get();
+  if (group == 0) {
+    add_to_selection_(particle_index, select);
+    return;
+  }
   const Particle& part = select_particle(particle_index);
-  const Group& group = select->group();
-  if (group.is_in(part, particle_index)) {
-    select->add_particle(particle_index, group.site_indices(part), true);
+  const Group& grp = select->group();
+  if (grp.is_in(part, particle_index)) {
+    add_with_slot_(particle_index, grp.site_indices(part), select,
+                   &group_slot_[group]);
+  }
+}
+
+void Configuration::update_group_(const int particle_index, const int group) {
+  Select * select = group_selects_[group].get();
+  const Particle& part = select_particle(particle_index);
+  const Group& grp = select->group();
+  if (group == 0) {
+    if (grp.is_in(part, particle_index)) {
+      select->add_particle(particle_index, grp.site_indices(part), true);
+    } else {
+      select->remove_particle(particle_index);
+    }
+  } else if (grp.is_in(part, particle_index)) {
+    if (find_slot_(particle_index, group_slot_[group]) == -1) {
+      add_with_slot_(particle_index, grp.site_indices(part), select,
+                     &group_slot_[group]);
+    }
   } else {
-    select->remove_particle(particle_index);
+    remove_with_slot_(particle_index, select, &group_slot_[group]);
+  }
+}
+
+void Configuration::build_slots_() {
+  group_slot_.resize(group_selects_.size());
+  for (int group = 1; group < num_groups(); ++group) {
+    const Select& select = *group_selects_[group];
+    std::vector<int> * slots = &group_slot_[group];
+    slots->assign(particles_->num(), -1);
+    for (int index = 0; index < select.num_particles(); ++index) {
+      (*slots)[select.particle_index(index)] = index;
+    }
+  }
+  ghost_slot_.assign(particles_->num(), -1);
+  for (const std::shared_ptr<Select>& ghost : ghosts_) {
+    for (int index = 0; index < ghost->num_particles(); ++index) {
+      ghost_slot_[ghost->particle_index(index)] = index;
+    }
   }
 }
 
@@ -531,9 +644,11 @@ void Configuration::update_positions(const Select& select,
     int sindex = 0;
     for (int site_index : select.site_indices(pindex)) {
       // DEBUG(select.site_properties()[pindex][sindex].str());
-      replace_properties_(particle_index,
-                          site_index,
-                          select.site_properties()[pindex][sindex]);
+      if (select.is_site_properties_modified()) {
+        replace_properties_(particle_index,
+                            site_index,
+                            select.site_properties()[pindex][sindex]);
+      }
       replace_position_(particle_index,
                         site_index,
                         select.site_positions()[pindex][sindex]);
@@ -648,13 +763,13 @@ void Configuration::revive(const Select& selection) {
     const Particle& part = select_particle(particle_index);
     const int type = part.type();
     DEBUG("ghosts " << feasst_str(ghosts_[type]->particle_indices()));
-    ASSERT(find_in_list(particle_index, ghosts_[type]->particle_indices()),
+    ASSERT(find_slot_(particle_index, ghost_slot_) != -1,
       "attempting to revive a particle that isn't a ghost");
     ++num_particles_of_type_[type];
     DEBUG("ghost particles " << ghosts_[type]->num_particles());
-    ghosts_[type]->remove_particle(particle_index);
-    for (std::shared_ptr<Select> select : group_selects_) {
-      add_to_selection_(particle_index, select.get());
+    remove_with_slot_(particle_index, ghosts_[type].get(), &ghost_slot_);
+    for (int group = 0; group < num_groups(); ++group) {
+      add_to_group_(particle_index, group);
     }
     position_tracker_(particle_index);
   }
@@ -771,6 +886,7 @@ void Configuration::set_site_type(const int particle_type,
     }
   }
   particle_types_->set_site_type(particle_type, site, site_type);
+  revise_particle_types_();
   for (int particle = 0; particle < particles_->num(); ++particle) {
     if (particles_->particle(particle).type() == particle_type) {
       particles_->set_site_type(particle, site, site_type);
@@ -878,6 +994,7 @@ Configuration::Configuration(std::istream& istr) {
       unique_types_ = std::make_shared<ParticleFactory>(istr);
     }
   }
+  revise_particle_types_();
   {
     int existing;
     istr >> existing;
@@ -943,6 +1060,7 @@ Configuration::Configuration(std::istream& istr) {
     feasst_deserialize(&name_, istr);
   }
   feasst_deserialize_endcap("Configuration", istr);
+  build_slots_();
 }
 
 void Configuration::copy_particles(const Configuration& config,
@@ -1012,8 +1130,8 @@ void Configuration::set_particle_type(const int ptype,
     for (int isite = 0; isite < part->num_sites(); ++isite) {
       part->get_site(isite)->set_type(particle_type(ptype).site(isite).type());
     }
-    for (std::shared_ptr<Select> sel : group_selects_) {
-      update_selection_(particle_index, sel.get());
+    for (int group = 0; group < num_groups(); ++group) {
+      update_group_(particle_index, group);
     }
     // HWH doesn't update type-based cell lists, groups, etc.
   }
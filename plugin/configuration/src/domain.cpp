@@ -342,62 +342,74 @@ void Domain::wrap_opt(const Position& pos1,
   }
 }
 
+// Wrap the z, y and then x dimensions of the relative position, where the
+// number of wraps is computed with the inverse of the side lengths, which is
+// zero for non-periodic dimensions, to avoid divisions and branches.
 void Domain::wrap_triclinic_opt(const Position& pos1,
     const Position& pos2,
     Position * rel,
     Position * pbc,
     double * r2) const {
   DEBUG("wrapping triclinc opt " << pos1.str() << " " << pos2.str());
-  *r2 = 0;
-  const std::vector<double>& side = side_lengths_.coord();
-  std::vector<double>* dxv = (*rel).get_coord();
-  std::vector<double>* dbc = (*pbc).get_coord();
-  (*dbc)[0] = 0.;
-  (*dbc)[1] = 0.;
-  (*dxv)[0] = pos1.coord()[0] - pos2.coord()[0];
-  (*dxv)[1] = pos1.coord()[1] - pos2.coord()[1];
+  const double * side = side_lengths_.coord().data();
+  const double * inv = periodic_inv_side_.data();
+  const double * x1 = pos1.coord().data();
+  const double * x2 = pos2.coord().data();
+  double * dxv = (*rel).get_coord()->data();
+  double * dbc = (*pbc).get_coord()->data();
+  double dx = x1[0] - x2[0];
+  double dy = x1[1] - x2[1];
+  double bx = 0., by = 0.;
+  *r2 = 0.;
   if (pos1.dimension() >= 3) {
-    (*dxv)[2] = pos1.coord()[2] - pos2.coord()[2];
-    if (periodic_[2]) {
-      (*dbc)[2] = 0.;
-      const double side_length = side[2];
-      const int num_wrap = std::rint((*dxv)[2]/side_length);
-      const double dz = num_wrap*side_length;
-      const double dy = num_wrap*yz_;
-      const double dx = num_wrap*xz_;
-      (*dbc)[2] -= dz;
-      (*dbc)[1] -= dy;
-      (*dbc)[0] -= dx;
-      (*dxv)[2] -= dz;
-      (*dxv)[1] -= dy;
-      (*dxv)[0] -= dx;
-    }
-    const double dxv2 = (*dxv)[2];
-    *r2 += dxv2*dxv2;
+    double dz = x1[2] - x2[2];
+    const double wrapz = std::rint(dz*inv[2]);
+    const double bz = -wrapz*side[2];
+    by = -wrapz*yz_;
+    bx = -wrapz*xz_;
+    dz += bz;
+    dy += by;
+    dx += bx;
+    dxv[2] = dz;
+    dbc[2] = bz;
+    *r2 = dz*dz;
   }
-  if (periodic_[1]) {
-    const double side_length = side[1];
-    const int num_wrap = std::rint((*dxv)[1]/side_length);
-    const double dy = num_wrap*side_length;
-    const double dx = num_wrap*xy_;
-    (*dbc)[1] -= dy;
-    (*dbc)[0] -= dx;
-    (*dxv)[1] -= dy;
-    (*dxv)[0] -= dx;
+  const double wrapy = std::rint(dy*inv[1]);
+  by -= wrapy*side[1];
+  dy -= wrapy*side[1];
+  bx -= wrapy*xy_;
+  dx -= wrapy*xy_;
+  const double wrapx = std::rint(dx*inv[0]);
+  bx -= wrapx*side[0];
+  dx -= wrapx*side[0];
+  dxv[0] = dx;
+  dxv[1] = dy;
+  dbc[0] = bx;
+  dbc[1] = by;
+  *r2 += dx*dx + dy*dy;
+}
+
+double Domain::perpendicular_width(const int dimension) const {
+  if (!is_tilted()) {
+    return side_length(dimension);
   }
-  if (periodic_[0]) {
-    const double side_length = side[0];
-    const double dx = side_length*std::rint((*dxv)[0]/side_length);
-    (*dbc)[0] -= dx;
-    (*dxv)[0] -= dx;
+  double norm2 = 0.;
+  for (int dim = 0; dim < h_inv_.num_columns(); ++dim) {
+    const double value = h_inv_.value(dimension, dim);
+    norm2 += value*value;
   }
-  const double dxv0 = (*dxv)[0];
-  const double dxv1 = (*dxv)[1];
-  *r2 += dxv0*dxv0 + dxv1*dxv1;
+  return 1./std::sqrt(norm2);
 }
 
 void Domain::update_h_() {
   DEBUG("dim " << dimension());
+  periodic_inv_side_.resize(dimension());
+  for (int dim = 0; dim < dimension(); ++dim) {
+    periodic_inv_side_[dim] = 0.;
+    if (periodic_[dim]) {
+      periodic_inv_side_[dim] = 1./side_lengths_.coord(dim);
+    }
+  }
   if (dimension() == 2) {
     const double lx = side_lengths_.coord(0);
     const double ly = side_lengths_.coord(1);
@@ -1,3 +1,7 @@
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include "configuration/include/properties.h"
 #include "utils/include/io.h"
 #include "utils/include/debug.h"
@@ -7,20 +11,108 @@
 
 namespace feasst {
 
+// The interned names of all properties, shared by all threads.
+// Because a key never changes once interned, each thread caches the names
+// and keys that it has seen, and takes the lock only upon a miss.
+class PropertyNames {
+ public:
+  static PropertyNames * instance() {
+    static PropertyNames names;
+    return &names;
+  }
+
+  int key(const std::string& name) {
+    const int found = find(name);
+    if (found != -1) {
+      return found;
+    }
+    std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+    int key;
+    const auto existing = keys_.find(name);
+    if (existing != keys_.end()) {
+      key = existing->second;
+    } else {
+      key = static_cast<int>(names_.size());
+      names_.push_back(name);
+      keys_[name] = key;
+    }
+    thread_keys_()[name] = key;
+    return key;
+  }
+
+  // Return the key of the name, or -1 if the name was never interned.
+  int find(const std::string& name) {
+    std::unordered_map<std::string, int>& cache = thread_keys_();
+    const auto cached = cache.find(name);
+    if (cached != cache.end()) {
+      return cached->second;
+    }
+    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    const auto found = keys_.find(name);
+    if (found != keys_.end()) {
+      cache[name] = found->second;
+      return found->second;
+    }
+    return -1;
+  }
+
+  std::string name(const int key) {
+    std::vector<std::string>& cache = thread_names_();
+    if (key >= static_cast<int>(cache.size())) {
+      std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+      cache = names_;
+    }
+    return cache[key];
+  }
+
+ private:
+  // Reads share the lock, while interning a new name is exclusive.
+  std::shared_timed_mutex mutex_;
+  std::vector<std::string> names_;
+  std::map<std::string, int> keys_;
+
+  static std::unordered_map<std::string, int>& thread_keys_() {
+    static thread_local std::unordered_map<std::string, int> keys;
+    return keys;
+  }
+
+  static std::vector<std::string>& thread_names_() {
+    static thread_local std::vector<std::string> names;
+    return names;
+  }
+};
+
+PropertyKey::PropertyKey(const std::string& name) {
+  key_ = PropertyNames::instance()->key(name);
+}
+
+std::string PropertyKey::name() const {
+  return PropertyNames::instance()->name(key_);
+}
+
 void Properties::check() const {
-  ASSERT(values_.size() == names_.size(),
+  ASSERT(values_.size() == keys_.size(),
     "size error");
   // make sure there are no spaces in property names
-  for (const std::string& name : names_) {
+  for (const std::string& name : names()) {
     ASSERT(num_spaces(name) == 0, "spaces are not allowed in property names");
   }
 }
 
+std::vector<std::string> Properties::names() const {
+  std::vector<std::string> nms;
+  for (const int key : keys_) {
+    nms.push_back(PropertyNames::instance()->name(key));
+  }
+  return nms;
+}
+
 void Properties::add(const std::string name, const double value) {
-  ASSERT(!find_in_list(name, names_),
+  const PropertyKey key(name);
+  ASSERT(index(key) == -1,
     "property(" << name << ") already exists");
   values_.push_back(value);
-  names_.push_back(name);
+  keys_.push_back(key.key());
 }
 
 double Properties::value(const std::string name) const {
@@ -30,6 +122,12 @@ double Properties::value(const std::string name) const {
   return val;
 }
 
+double Properties::value(const PropertyKey& key) const {
+  const int ind = index(key);
+  ASSERT(ind != -1, "property(" << key.name() << ") not found");
+  return values_[ind];
+}
+
 bool Properties::value(const std::string name, double * val) const {
   int index;
   return value(name, val, &index);
@@ -38,8 +136,13 @@ bool Properties::value(const std::string name, double * val) const {
 bool Properties::value(const std::string name,
     double * val,
     int * index) const {
-  TRACE("finding " << name << " in " << feasst_str(names_));
-  bool is_found = find_in_list(name, names_, index);
+  TRACE("finding " << name << " in " << feasst_str(names()));
+  // a name that was never interned is not in any Properties.
+  const int key = PropertyNames::instance()->find(name);
+  bool is_found = false;
+  if (key != -1) {
+    is_found = find_in_list(key, keys_, index);
+  }
   if (is_found) {
     *val = values_[*index];
   }
@@ -47,27 +150,29 @@ bool Properties::value(const std::string name,
 }
 
 void Properties::set(const std::string name, const double value) {
-  int index = 0;
-  const bool is_found = find_in_list(name, names_, &index);
-  ASSERT(is_found, "property(" << name << ") not found");
+  const int ind = index(PropertyKey(name));
+  ASSERT(ind != -1, "property(" << name << ") not found");
   TRACE("setting " << name << " value " << value);
-  values_[index] = value;
+  values_[ind] = value;
 }
 
 void Properties::add_or_set(const std::string name, const double value) {
-  int index;
-  if (find_in_list(name, names_, &index)) {
-    values_[index] = value;
+  const PropertyKey key(name);
+  const int ind = index(key);
+  if (ind != -1) {
+    values_[ind] = value;
   } else {
-    add(name, value);
+    values_.push_back(value);
+    keys_.push_back(key.key());
   }
 }
 
 std::string Properties::str() const {
   check();
   std::stringstream ss;
+  const std::vector<std::string> nms = names();
   for (int index = 0; index < static_cast<int>(values_.size()); ++index) {
-    ss << "{" << names_[index] << " : " << values_[index] << "}, ";
+    ss << "{" << nms[index] << " : " << values_[index] << "}, ";
   }
   return ss.str();
 }
@@ -85,14 +190,18 @@ void Properties::serialize(std::ostream& ostr) const {
   check();
   ostr << MAX_PRECISION;
   feasst_serialize_version(847, ostr);
-  feasst_serialize(names_, ostr);
+  feasst_serialize(names(), ostr);
   feasst_serialize(values_, ostr);
 }
 
 Properties::Properties(std::istream& istr) {
   const int version = feasst_deserialize_version(istr);
   ASSERT(847 == version, "version mismatch:" << version);
-  feasst_deserialize(&names_, istr);
+  std::vector<std::string> nms;
+  feasst_deserialize(&nms, istr);
+  for (const std::string& name : nms) {
+    keys_.push_back(PropertyKey(name).key());
+  }
   feasst_deserialize(&values_, istr);
 }
 
@@ -10,6 +10,25 @@
 
 namespace feasst {
 
+#ifdef FEASST_VISIT_COUNTERS
+static thread_local int64_t num_constructed_ = 0;
+
+Select::ConstructionCounter_::ConstructionCounter_() { ++num_constructed_; }
+
+Select::ConstructionCounter_::ConstructionCounter_(
+    const ConstructionCounter_&) {
+  ++num_constructed_;
+}
+
+int64_t Select::num_constructed() { return num_constructed_; }
+
+void Select::reset_num_constructed() { num_constructed_ = 0; }
+#else  // FEASST_VISIT_COUNTERS
+int64_t Select::num_constructed() { return 0; }
+
+void Select::reset_num_constructed() {}
+#endif  // FEASST_VISIT_COUNTERS
+
 void Select::add(const Select& select) {
   TRACE("adding " << select.str() << " to " << this->str());
   for (int select_index = 0;
@@ -33,11 +52,17 @@ void Select::remove(const Select& select) {
 void Select::add_particle(const Particle& particle,
     const int particle_index,
     const bool prevent_duplicate) {
-  std::vector<int> sites;
-  for (int index = 0; index < particle.num_sites(); ++index) {
-    sites.push_back(index);
+  if (particle.num_sites() > 0) {
+    if (!prevent_duplicate ||
+        !find_in_list(particle_index, particle_indices())) {
+      particle_indices_.push_back(particle_index);
+      site_indices_.emplace_back(particle.num_sites());
+      std::vector<int> * sites = &site_indices_.back();
+      for (int index = 0; index < particle.num_sites(); ++index) {
+        (*sites)[index] = index;
+      }
+    }
   }
-  add_particle(particle_index, sites, prevent_duplicate);
 }
 
 std::string Select::str(const bool pos) const {
@@ -136,6 +161,30 @@ void Select::remove_particle(const int particle_index) {
   }
 }
 
+void Select::remove_particle_unordered(const int select_index) {
+  const int last = num_particles() - 1;
+  ASSERT(select_index >= 0 && select_index <= last,
+    "select_index: " << select_index << " out of range");
+  if (select_index != last) {
+    particle_indices_[select_index] = particle_indices_[last];
+    site_indices_[select_index].swap(site_indices_[last]);
+    if (static_cast<int>(site_positions_.size()) > last) {
+      site_positions_[select_index].swap(site_positions_[last]);
+    }
+    if (static_cast<int>(site_properties_.size()) > last) {
+      site_properties_[select_index].swap(site_properties_[last]);
+    }
+  }
+  particle_indices_.pop_back();
+  site_indices_.pop_back();
+  if (static_cast<int>(site_positions_.size()) > last) {
+    site_positions_.pop_back();
+  }
+  if (static_cast<int>(site_properties_.size()) > last) {
+    site_properties_.pop_back();
+  }
+}
+
 void Select::check() const {
   ASSERT(particle_indices_.size() == site_indices_.size(), "size error");
   ASSERT(std::is_sorted(particle_indices_.begin(), particle_indices_.end()),
@@ -146,7 +195,7 @@ void Select::check() const {
 }
 
 void Select::add_particle(const int particle_index,
-    std::vector<int> site_indices,
+    const std::vector<int>& site_indices,
     const bool prevent_duplicate) {
   if (site_indices.size() > 0) {
     if (!prevent_duplicate ||
@@ -298,6 +347,7 @@ void Select::set_site_properties(
     const int site_index,
     const Properties& properties) {
   site_properties_[particle_index][site_index] = properties;
+  is_site_properties_modified_ = true;
 }
 
 void Select::load_position(const int pindex,
@@ -308,7 +358,7 @@ void Select::load_position(const int pindex,
   int sindex = 0;
   for (int site_index : site_indices(pindex)) {
     set_site_position(pindex, sindex, particle.site(site_index).position());
-    set_site_properties(pindex, sindex, particle.site(site_index).properties());
+    site_properties_[pindex][sindex] = particle.site(site_index).properties();
     ++sindex;
   }
 }
@@ -319,6 +369,7 @@ void Select::load_positions(const ParticleFactory& particles) {
     load_position(pindex, particles.particle(particle_index));
     ++pindex;
   }
+  is_site_properties_modified_ = false;
 }
 
 void Select::load_positions_of_last(const Particle& particle,
@@ -360,6 +411,7 @@ void Select::clear() {
   site_indices_.clear();
   site_positions_.clear();
   site_properties_.clear();
+  is_site_properties_modified_ = false;
 }
 
 void Select::resize_positions() {
@@ -376,6 +428,8 @@ Select::Select(const Select& select,
   : Select(select) {
   resize_positions();
   load_positions(particles);
+  // the particles may belong to a different Configuration.
+  is_site_properties_modified_ = true;
 }
 
 Select::Select(const int particle_index,
@@ -383,6 +437,7 @@ Select::Select(const int particle_index,
   add_particle(particle, particle_index);
   resize_positions();
   load_position(0, particle);
+  is_site_properties_modified_ = true;
 }
 
 void Select::set_trial_state(const int state) {
@@ -450,6 +505,7 @@ Select::Select(std::istream& sstr) {
   }
   feasst_deserialize_fstobj(&site_positions_, sstr);
   feasst_deserialize_fstobj(&site_properties_, sstr);
+  is_site_properties_modified_ = true;
   feasst_deserialize_endcap("Select", sstr);
 }
 
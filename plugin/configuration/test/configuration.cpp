@@ -3,6 +3,7 @@
 #include "configuration/test/config_utils.h"
 #include "configuration/include/file_xyz.h"
 #include "configuration/include/domain.h"
+#include "configuration/include/select.h"
 #include "utils/include/debug.h"
 #include "math/include/constants.h"
 #include "math/include/utils_math.h"
@@ -155,6 +156,35 @@ TEST(Configuration, coordinates_and_wrapping) {
   }
 }
 
+TEST(Configuration, update_positions_site_properties) {
+  auto config = MakeConfiguration({{"cubic_side_length", "5"},
+    {"particle_type", "atom:../particle/atom_new.txt"},
+    {"add_num_atom_particles", "2"}});
+  config->add_site_property("banana", 1., 0, 0);
+  Select select(config->selection_of_all());
+  select.resize_positions();
+  select.load_positions(config->particles());
+  EXPECT_FALSE(select.is_site_properties_modified());
+
+  // loaded selections only update the positions
+  config->set_site_property("banana", 2., 0, 0);
+  Position pos = select.site_positions()[0][0];
+  pos.set_coord(0, 1.5);
+  select.set_site_position(0, 0, pos);
+  config->update_positions(select);
+  EXPECT_NEAR(1.5, config->particle(0).site(0).position().coord(0), NEAR_ZERO);
+  EXPECT_NEAR(2., config->particle(0).site(0).property("banana"), NEAR_ZERO);
+
+  // unless the properties of the selection were set
+  select.set_site_properties(0, 0, select.site_properties()[0][0]);
+  EXPECT_TRUE(select.is_site_properties_modified());
+  config->update_positions(select);
+  EXPECT_NEAR(1., config->particle(0).site(0).property("banana"), NEAR_ZERO);
+  select.load_positions(config->particles());
+  EXPECT_FALSE(select.is_site_properties_modified());
+  EXPECT_TRUE(Select(select, config->particles()).is_site_properties_modified());
+}
+
 TEST(Configuration, particle_types_lj) {
   auto config = MakeConfiguration({{"particle_type", "lj:../particle/lj_new.txt"}});
   config->check();
@@ -403,6 +433,63 @@ TEST(Configuration, add_particles_of_type) {
   EXPECT_EQ(1, config->particle(1).type());
 }
 
+TEST(Configuration, ghosts) {
+  auto config = MakeConfiguration({{"cubic_side_length", "8"},
+    {"particle_type", "lj:../particle/lj.txt,atom:../particle/atom.txt"},
+    {"add_num_lj_particles", "4"}, {"add_num_atom_particles", "2"},
+    {"group", "atom"}, {"atom_particle_type", "atom"}});
+  EXPECT_EQ(2, config->group_select(1).num_particles());
+
+  // removal keeps the order of selection_of_all, but replaces the particle
+  // with the last in other groups
+  Select select;
+  select.add_particle(config->select_particle(1), 1);
+  config->remove_particle(select);
+  EXPECT_EQ(std::vector<int>({0, 2, 3, 4, 5}),
+            config->selection_of_all().particle_indices());
+  EXPECT_EQ(std::vector<int>({4, 5}),
+            config->group_select(1).particle_indices());
+  select.clear();
+  select.add_particle(config->select_particle(4), 4);
+  config->remove_particle(select);
+  EXPECT_EQ(std::vector<int>({0, 2, 3, 5}),
+            config->selection_of_all().particle_indices());
+  EXPECT_EQ(std::vector<int>({5}),
+            config->group_select(1).particle_indices());
+  EXPECT_EQ(4, config->num_particles());
+  EXPECT_EQ(1, config->num_particles_of_type(1));
+  config->check();
+
+  // the last ghost of the type is added first
+  select.clear();
+  select.add_particle(config->select_particle(3), 3);
+  config->remove_particle(select);
+  EXPECT_EQ(2, config->ghosts()[0]->num_particles());
+  config->add_particle_of_type(0);
+  EXPECT_EQ(3, config->newest_particle_index());
+  EXPECT_EQ(std::vector<int>({1}), config->ghosts()[0]->particle_indices());
+
+  // revive a ghost
+  select.clear();
+  select.add_particle(config->select_particle(4), 4);
+  config->revive(select);
+  EXPECT_EQ(std::vector<int>({0, 2, 5, 3, 4}),
+            config->selection_of_all().particle_indices());
+  EXPECT_EQ(std::vector<int>({5, 4}),
+            config->group_select(1).particle_indices());
+  TRY(
+    config->revive(select);
+    CATCH_PHRASE("attempting to revive a particle that isn't a ghost");
+  );
+  config->check();
+
+  auto config2 = test_serialize_unique(*config);
+  config2->remove_particle(select);
+  EXPECT_EQ(std::vector<int>({5}),
+            config2->group_select(1).particle_indices());
+  config2->check();
+}
+
 TEST(Configuration, dihedrals) {
   auto config = MakeConfiguration({{"particle_type", "alkane:../particle/n-decane.txt"}, {"add_num_alkane_particles", "1"}});
   EXPECT_EQ(1, config->num_particles());
@@ -1,3 +1,5 @@
+#include <cmath>
+#include <algorithm>
 #include "utils/test/utils.h"
 #include "configuration/include/domain.h"
 #include "math/include/constants.h"
@@ -137,6 +139,68 @@ TEST(Domain, inscribed_sphere_diameter) {
   EXPECT_DOUBLE_EQ(domain->inscribed_sphere_diameter(), 31.17691453623979);
 }
 
+TEST(Domain, perpendicular_width) {
+  auto domain = MakeDomain({{"side_length", "3,4,5"}});
+  EXPECT_DOUBLE_EQ(4., domain->perpendicular_width(1));
+  domain = MakeDomain({
+    {"side_length", "10,9.84807753012208,9.64974312607518"},
+    {"xy", "1.7364817766693041"},
+    {"xz", "2.5881904510252074"},
+    {"yz", "0.42863479791864567"}});
+  double min_width = domain->perpendicular_width(0);
+  for (int dim = 1; dim < 3; ++dim) {
+    min_width = std::min(min_width, domain->perpendicular_width(dim));
+  }
+  EXPECT_NEAR(domain->inscribed_sphere_diameter(), min_width, 1e-12);
+  EXPECT_NEAR(domain->side_length(2), domain->perpendicular_width(2), 1e-12);
+  domain = MakeDomain({{"side_length", "8,5"}, {"xy", "3"}});
+  EXPECT_NEAR(8.*5./std::sqrt(34.), domain->perpendicular_width(0), 1e-12);
+  EXPECT_NEAR(5., domain->perpendicular_width(1), 1e-12);
+}
+
+// Compare the optimized minimum image with a search over the nearby images.
+TEST(Domain, wrap_triclinic_opt) {
+  auto domain = MakeDomain({
+    {"side_length", "10,9.84807753012208,9.64974312607518"},
+    {"xy", "1.7364817766693041"},
+    {"xz", "2.5881904510252074"},
+    {"yz", "0.42863479791864567"}});
+  RandomMT19937 random;
+  Position rel, pbc, image;
+  rel.set_to_origin(3);
+  pbc.set_to_origin(3);
+  const double half_width = 0.5*domain->inscribed_sphere_diameter();
+  for (int trial = 0; trial < 1e3; ++trial) {
+    const Position pos1 = domain->random_position(&random);
+    const Position pos2 = domain->random_position(&random);
+    double r2;
+    domain->wrap_opt(pos1, pos2, &rel, &pbc, &r2);
+    EXPECT_NEAR(r2, rel.squared_distance(), 1e-12);
+    double min_r2 = NEAR_INFINITY;
+    for (int i = -1; i <= 1; ++i) {
+      for (int j = -1; j <= 1; ++j) {
+        for (int k = -1; k <= 1; ++k) {
+          image.set_vector({
+            pos1.coord(0) - pos2.coord(0) + i*domain->side_length(0) +
+              j*domain->xy() + k*domain->xz(),
+            pos1.coord(1) - pos2.coord(1) + j*domain->side_length(1) +
+              k*domain->yz(),
+            pos1.coord(2) - pos2.coord(2) + k*domain->side_length(2)});
+          min_r2 = std::min(min_r2, image.squared_distance());
+        }
+      }
+    }
+    // the minimum image is exact within half of the inscribed sphere
+    if (min_r2 < half_width*half_width) {
+      EXPECT_NEAR(min_r2, r2, 1e-10);
+    }
+    for (int dim = 0; dim < 3; ++dim) {
+      EXPECT_NEAR(rel.coord(dim), pos1.coord(dim) - pos2.coord(dim) +
+                  pbc.coord(dim), 1e-10);
+    }
+  }
+}
+
 TEST(Domain, is_minimum_image_for_cutoff) {
   auto domain = MakeDomain({{"side_length", "3,4,5"}});
   EXPECT_TRUE (domain->is_minimum_image_for_cutoff(1.5));
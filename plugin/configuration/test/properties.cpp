@@ -1,3 +1,4 @@
+#include <vector>
 #include "utils/test/utils.h"
 #include "configuration/include/properties.h"
 #include "utils/include/debug.h"
@@ -36,4 +37,57 @@ TEST(Properties, properties) {
   EXPECT_EQ(prop2.str(), properties.str());
 }
 
+TEST(Properties, key) {
+  const PropertyKey bananas("bananas"), apples("apples");
+  EXPECT_EQ(bananas.key(), PropertyKey("bananas").key());
+  EXPECT_NE(bananas.key(), apples.key());
+  EXPECT_EQ("apples", apples.name());
+  Properties properties;
+  EXPECT_FALSE(properties.has(bananas));
+  properties.add("apples", 1.5);
+  properties.add("bananas", 12);
+  EXPECT_TRUE(properties.has(bananas));
+  EXPECT_EQ(1, properties.index(bananas));
+  EXPECT_NEAR(properties.value(bananas), 12, NEAR_ZERO);
+  properties.set("bananas", 2.3);
+  double value;
+  EXPECT_TRUE(properties.value(bananas, &value));
+  EXPECT_NEAR(value, 2.3, NEAR_ZERO);
+  EXPECT_FALSE(properties.value(PropertyKey("oranges"), &value));
+  TRY(
+    properties.value(PropertyKey("oranges"));
+    CATCH_PHRASE("property(oranges) not found");
+  );
+  EXPECT_EQ(2, static_cast<int>(properties.names().size()));
+  EXPECT_EQ("bananas", properties.names()[1]);
+
+  // keys are interned again upon deserialization
+  Properties prop2 = test_serialize(properties);
+  EXPECT_NEAR(prop2.value(apples), 1.5, NEAR_ZERO);
+}
+
+// Threads that intern and look up the same names agree on their keys.
+TEST(Properties, threads) {
+  const int num_names = 20;
+  std::vector<std::vector<int> > keys(4, std::vector<int>(num_names, -1));
+  std::vector<int> num_errors(4, 0);
+  #pragma omp parallel for num_threads(4)
+  for (int thread = 0; thread < 4; ++thread) {
+    for (int name = 0; name < num_names; ++name) {
+      const std::string str_name = "thread_name" + str(name);
+      Properties properties;
+      properties.add(str_name, name);
+      keys[thread][name] = PropertyKey(str_name).key();
+      if (properties.value(str_name) != name ||
+          PropertyKey(str_name).name() != str_name) {
+        ++num_errors[thread];
+      }
+    }
+  }
+  for (int thread = 0; thread < 4; ++thread) {
+    EXPECT_EQ(0, num_errors[thread]);
+    EXPECT_EQ(keys[0], keys[thread]);
+  }
+}
+
 }  // namespace feasst
@@ -3,6 +3,7 @@
 #include "system/include/rigid_bond.h"
 #include "system/include/thermo_params.h"
 #include "system/include/visit_model_inner.h"
+#include "system/include/visit_counters.h"
 #include "system/include/potential_factory.h"
 #include "system/include/bond_four_body.h"
 #include "system/include/rigid_dihedral.h"
@@ -175,6 +176,7 @@
 #include "chain/include/select_two_sites.h"
 #include "chain/include/trial_particle_pivot.h"
 #include "steppers/include/seek_analyze.h"
+#include "steppers/include/replicas.h"
 #include "flat_histogram/include/clones.h"
 #include "steppers/include/criteria_updater.h"
 #include "steppers/include/num_particles.h"
@@ -182,6 +184,7 @@
 #include "steppers/include/ghost_trial_volume.h"
 #include "steppers/include/log.h"
 #include "steppers/include/profile_cpu.h"
+#include "steppers/include/profile_pairs.h"
 #include "steppers/include/chirality_2d.h"
 #include "steppers/include/increment_phase.h"
 #include "steppers/include/seek_modify.h"
@@ -236,6 +239,7 @@
 #include "utils/include/restart.h"
 #include "utils/include/cache.h"
 #include "utils/include/end_if.h"
+#include "utils/include/profiler.h"
 #include "math/include/spline.h"
 #include "math/include/matrix.h"
 #include "chain/include/perturb_connector.h"
@@ -260,6 +264,7 @@
 #include "shape/include/formula_sine_wave.h"
 #include "math/include/golden_search.h"
 #include "math/include/random_mt19937.h"
+#include "math/include/random_philox.h"
 #include "math/include/histogram.h"
 #include "steppers/include/density_profile.h"
 #include "flat_histogram/include/ensemble.h"
@@ -340,6 +345,11 @@
 #include "confinement/include/henry_coefficient.h"
 #include "flat_histogram/include/collection_matrix.h"
 #include "flat_histogram/include/collection_matrix_splice.h"
+#include "flat_histogram/include/collection_matrix_sparse.h"
+#include "flat_histogram/include/transition_matrix_sparse.h"
+#include "flat_histogram/include/macrostate_product.h"
+#include "flat_histogram/include/reweight.h"
+#include "flat_histogram/include/window_cost.h"
 #include "chain/include/end_to_end_distance.h"
 #include "steppers/include/profile_trials.h"
 #include "math/include/solver.h"
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include "feasst/include/feasst.h"
+
+using namespace feasst;
+
+// Return the sum of the attempts of all trials.
+int64_t num_attempts_(const MonteCarlo& mc) {
+  int64_t num = 0;
+  for (const std::shared_ptr<Trial>& trial : mc.trials().trials()) {
+    num += trial->num_attempts();
+  }
+  return num;
+}
+
+/**
+  Usage: feasst_benchmark file.txt [name]
+
+  Run the MonteCarlo in the text file, which must begin with "MonteCarlo".
+  The arguments before the last Run (e.g., initialization and equilibration)
+  are not timed.
+  The last Run, and any arguments that follow, are timed.
+
+  Print a single line in JSON format with the number of trials per second,
+  the number of pairs of sites per second and the peak resident set size in
+  kilobytes.
+  The pairs are counted by the VisitCounters in a second, untimed pass over
+  a copy of the MonteCarlo, so the counts do not perturb the timing.
+  The pairs are zero unless compiled with the VisitCounters enabled, and do not
+  include the reciprocal space of Ewald or other visitors without pairs.
+  The name defaults to the file name.
+  See dev/benchmark/README.rst.
+ */
+int main(int argc, char ** argv) {
+  ASSERT(argc == 2 || argc == 3, "Usage: feasst_benchmark file.txt [name]");
+  const std::string file_name(argv[1]);
+  std::string name = file_name;
+  if (argc == 3) {
+    name = std::string(argv[2]);
+  }
+  std::ifstream file(file_name);
+  ASSERT(file.good(), "cannot find file: " << file_name);
+  std::string line;
+  std::getline(file, line);
+  while (line.empty() || line[0] == '#') {
+    ASSERT(!file.eof(), "Improperly formatted input: " << file_name);
+    std::getline(file, line);
+  }
+  ASSERT(line == "MonteCarlo", "The first readable line of " << file_name <<
+    " must be MonteCarlo, but is: " << line);
+  std::vector<arglist> lists = parse_mcs(file);
+  ASSERT(lists.size() == 1, "expected one MonteCarlo in: " << file_name);
+  arglist setup = lists[0];
+  int last_run = -1;
+  for (int index = 0; index < static_cast<int>(setup.size()); ++index) {
+    if (setup[index].first == "Run") {
+      last_run = index;
+    }
+  }
+  ASSERT(last_run != -1, "No Run found in: " << file_name);
+  arglist timed(setup.begin() + last_run, setup.end());
+  setup.erase(setup.begin() + last_run, setup.end());
+
+  auto mc = std::make_shared<MonteCarlo>(setup, true);
+  std::stringstream serialized;
+  mc->serialize(serialized);
+  const int64_t attempts_begin = num_attempts_(*mc);
+  const auto begin = std::chrono::steady_clock::now();
+  mc->begin(timed, true);
+  const auto end = std::chrono::steady_clock::now();
+  const double seconds = std::chrono::duration<double>(end - begin).count();
+  const int64_t num_trials = num_attempts_(*mc) - attempts_begin;
+
+  // the peak memory of the timed run, before the copy below
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+
+  // repeat the timed arguments on a copy, untimed, to count the pairs
+  MonteCarlo copy(serialized);
+  VisitCounters * counters = VisitCounters::thread_counters();
+  const int64_t pairs_begin = counters->count(VisitCounters::pairs_tested);
+  copy.begin(timed, true);
+  const int64_t num_pairs =
+    counters->count(VisitCounters::pairs_tested) - pairs_begin;
+  std::cout << "{\"name\": \"" << name << "\", "
+            << "\"version\": \"" << FEASST_VERSION << "\", "
+            << "\"seconds\": " << seconds << ", "
+            << "\"trials\": " << num_trials << ", "
+            << "\"trials_per_second\": " << num_trials/seconds << ", "
+            << "\"pairs\": " << num_pairs << ", "
+            << "\"pairs_per_second\": " << num_pairs/seconds << ", "
+            << "\"peak_rss_kb\": " << usage.ru_maxrss << "}" << std::endl;
+  return 0;
+}
@@ -92,6 +92,19 @@ void parse_prefetch(std::string line) {
   }
 }
 
+// Parse the line containing Replicas
+void parse_replicas(std::string line) {
+  argtype variables;
+  bool assign_to_list;
+  std::pair<std::string, argtype> line_pair = parse_line(line, &variables, &assign_to_list);
+  std::vector<arglist> lists = parse_mcs(std::cin);
+  ASSERT(static_cast<int>(lists.size()) == 1, "Replicas should "
+    << "have no lines beginning as \"MonteCarlo\"");
+  Replicas replicas(line_pair.second);
+  replicas.run(lists[0]);
+  std::cout << replicas.write();
+}
+
 void parse_server(std::string line) {
   argtype variables;
   bool assign_to_list;
@@ -273,6 +286,9 @@ int main() {
   } else if (line.substr(0, 8) == "Prefetch") {
     std::cout << line << std::endl;
     parse_prefetch(line);
+  } else if (line.substr(0, 8) == "Replicas") {
+    std::cout << line << std::endl;
+    parse_replicas(line);
   } else if (line.substr(0, 22) == "CollectionMatrixSplice") {
     parse_cm(line);
   } else if (line.substr(0, 6) == "Server") {
@@ -281,7 +297,7 @@ int main() {
     parse_restart(line);
   } else {
     FATAL("As currently implemented, all FEASST input text files must begin "
-      << "with \"MonteCarlo,\" \"Prefetch\", \"Server\" or \"Restart\". "
+      << "with \"MonteCarlo,\" \"Prefetch\", \"Replicas\", \"Server\" or \"Restart\". "
       << "The first readable line is: " << line);
   }
   return 0;
@@ -0,0 +1,55 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "feasst/include/feasst.h"
+#include "mpi/include/windows_mpi.h"
+
+using namespace feasst;
+
+/**
+  Usage: mpirun -np 4 feasst_mpi file.txt
+
+  Run FlatHistogram windows over MPI ranks with WindowsMPI.
+  The text file must begin with a line beginning with "WindowsMPI", followed by
+  a line beginning with "Window", followed by the MonteCarlo arguments of each
+  window.
+  Because standard input is not given to every rank, each rank reads the file.
+ */
+int main(int argc, char ** argv) {
+  ASSERT(argc == 2, "Usage: mpirun -np 4 feasst_mpi file.txt");
+  std::ifstream file(argv[1]);
+  ASSERT(file.good(), "cannot find " << argv[1]);
+  std::string line;
+  std::getline(file, line);
+  ASSERT(line.substr(0, 10) == "WindowsMPI",
+    "The first line must begin with WindowsMPI. Instead: " << line);
+  argtype variables;
+  bool assign_to_list;
+  std::pair<std::string, argtype> line_pair =
+    parse_line(line, &variables, &assign_to_list);
+  WindowsMPI windows(line_pair.second);
+
+  std::getline(file, line);
+  line_pair = parse_line(line, &variables, &assign_to_list);
+  std::shared_ptr<Window> window;
+  if (line_pair.first == "WindowExponential") {
+    window = std::make_shared<WindowExponential>(line_pair.second);
+  } else if (line_pair.first == "WindowCustom") {
+    window = std::make_shared<WindowCustom>(line_pair.second);
+  } else {
+    FATAL("WindowsMPI must be followed with Window. Instead: " << line);
+  }
+
+  std::vector<arglist> list = parse_mcs(file);
+  ASSERT(static_cast<int>(list.size()) == 1, "WindowsMPI should "
+    << "have no lines beginning as \"MonteCarlo\"");
+  windows.run(list[0], *window);
+  if (windows.rank() == 0) {
+    for (int index = 0; index < windows.num_windows() - 1; ++index) {
+      std::cout << "# swaps accepted between windows " << index << " and "
+                << index + 1 << ": " << windows.num_swaps_accepted(index)
+                << " of " << windows.num_swaps_attempted(index) << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+
+#ifndef FEASST_FFTW_DENSITY_GRID_FFTW_H_
+#define FEASST_FFTW_DENSITY_GRID_FFTW_H_
+
+#include <vector>
+#include "math/include/accumulator.h"
+#include "monte_carlo/include/analyze.h"
+#include <complex>
+#include <fftw3.h>
+
+namespace feasst {
+
+/**
+  Compute the three dimensional density field and the structure factor using
+  FFTW (fftw.org).
+
+  Each physical site is spread onto the nodes of a periodic grid using the
+  cloud-in-cell (trilinear) assignment.
+  The time-averaged number density on each node is written to
+  density_output_file.
+
+  The Fourier transform of the gridded density, \f$\rho(\vec{q})\f$, gives the
+  structure factor
+
+  \f$S(\vec{q}) = |\rho(\vec{q})|^2 / (N W(\vec{q})^2)\f$,
+
+  where \f$N\f$ is the number of sites and the cloud-in-cell window,
+  \f$W(\vec{q}) = \prod_d \mathrm{sinc}^2(\pi m_d / n_d)\f$, for the integer
+  wave number \f$m_d\f$ and number of nodes \f$n_d\f$ in each dimension,
+  corrects for the smoothing of the assignment.
+  \f$S(\vec{q})\f$ is then spherically averaged into bins of \f$|\vec{q}|\f$
+  and block averaged with an Accumulator for each bin.
+  For M grid nodes, each update costs O(M log M) rather than the O(N K) of the
+  direct sum in Scattering.
+ */
+class DensityGridFFTW : public Analyze {
+ public:
+  //@{
+  /** @name Arguments
+    - bin_spacing: maximum spacing of the grid nodes in each dimension
+      (default: 0.1).
+    - bins_per_side: if != -1, ignore bin_spacing (default: -1).
+      Instead, set the number of nodes per side.
+      Powers of two are faster for FFTW (assumes cubic Domain).
+    - delta_rho: bin width of \f$|\vec{q}|\f$ in units of 2pi divided by the
+      minimum side length of the Domain (default: 1).
+    - site_type: if != -1, only consider sites of this type (default: -1).
+    - density_output_file: if not empty, write the time-averaged density
+      field as "x,y,z,rho" to this file whenever writing (default: empty).
+    - Stepper arguments.
+  */
+  explicit DensityGridFFTW(argtype args = argtype());
+  explicit DensityGridFFTW(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  void initialize(MonteCarlo * mc) override;
+  std::string header(const MonteCarlo& mc) const override;
+  void update(const MonteCarlo& mc) override;
+  std::string write(const MonteCarlo& mc) override;
+
+  /// Return the number of grid nodes in each dimension.
+  const std::vector<int>& num_bin() const { return num_bin_; }
+
+  /// Return the number of updates.
+  int num_updates() const { return updates_; }
+
+  /// Return the time-averaged number density on each grid node.
+  std::vector<double> density() const;
+
+  /// Return the magnitude of the wave vector of each bin.
+  std::vector<double> q() const;
+
+  /// Return the block averaged structure factor of each bin.
+  const std::vector<Accumulator>& sq() const { return sq_; }
+
+  // serialize
+  std::string class_name() const override {
+    return std::string("DensityGridFFTW"); }
+  void serialize(std::ostream& ostr) const override;
+  std::shared_ptr<Analyze> create(std::istream& istr) const override {
+    return std::make_shared<DensityGridFFTW>(istr); }
+  std::shared_ptr<Analyze> create(argtype * args) const override {
+    return std::make_shared<DensityGridFFTW>(args); }
+  explicit DensityGridFFTW(std::istream& istr);
+  ~DensityGridFFTW();
+
+  //@}
+ private:
+  bool fftw_initialized_ = false;
+  double bin_spacing_;
+  int bins_per_side_;
+  double delta_rho_;
+  int site_type_;
+  std::string density_output_file_;
+  int updates_ = 0;
+  double delta_q_ = 0.;
+  std::vector<int> num_bin_;  // number of nodes in each dimension
+  std::vector<double> bin_dist_;  // distance between nodes in each dimension
+  std::vector<double> lower_bound_;  // position of the first node (half box)
+  std::vector<double> density_sum_;
+  std::vector<Accumulator> sq_;
+
+  // fftw - not serializable
+  double *in_;
+  fftw_complex *out_;
+  fftw_plan plan_;
+
+  // temporary and not serialized
+  std::vector<double> sq_sum_, sq_count_;
+
+  // return the number of nodes in the grid.
+  int num_nodes_() const { return num_bin_[0]*num_bin_[1]*num_bin_[2]; }
+
+  // return the number of wave vectors (accounting for symmetry along z)
+  int num_q_() const {
+    return num_bin_[0]*num_bin_[1]*(num_bin_[2]/2+1);
+  }
+
+  // resize fftw according to num_bin_
+  void resize_fftw_variables_();
+
+  // fill the in_ grid with the cloud-in-cell assignment. Return the number of
+  // sites assigned.
+  int fill_grid_(const Configuration& config);
+};
+
+inline std::shared_ptr<DensityGridFFTW> MakeDensityGridFFTW(
+    argtype args = argtype()) {
+  return std::make_shared<DensityGridFFTW>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_FFTW_DENSITY_GRID_FFTW_H_
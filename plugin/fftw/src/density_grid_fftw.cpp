@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include "utils/include/arguments.h"
+#include "utils/include/serialize.h"
+#include "math/include/constants.h"
+#include "math/include/utils_math.h"
+#include "configuration/include/select.h"
+#include "configuration/include/particle.h"
+#include "configuration/include/site.h"
+#include "configuration/include/domain.h"
+#include "configuration/include/configuration.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "fftw/include/density_grid_fftw.h"
+
+namespace feasst {
+
+FEASST_MAPPER(DensityGridFFTW,);
+
+DensityGridFFTW::DensityGridFFTW(argtype * args) : Analyze(args) {
+  bin_spacing_ = dble("bin_spacing", args, 0.1);
+  bins_per_side_ = integer("bins_per_side", args, -1);
+  delta_rho_ = dble("delta_rho", args, 1);
+  site_type_ = integer("site_type", args, -1);
+  density_output_file_ = str("density_output_file", args, "");
+}
+DensityGridFFTW::DensityGridFFTW(argtype args) : DensityGridFFTW(&args) {
+  feasst_check_all_used(args);
+}
+
+void DensityGridFFTW::resize_fftw_variables_() {
+  if (fftw_initialized_) {
+    fftw_destroy_plan(plan_);
+    fftw_free(in_);
+    fftw_free(out_);
+  }
+  in_  = reinterpret_cast<double*>(fftw_malloc(sizeof(double) * num_nodes_()));
+  out_ = reinterpret_cast<fftw_complex*>(fftw_malloc(sizeof(fftw_complex) * num_q_()));
+  plan_ = fftw_plan_dft_r2c_3d(num_bin_[0], num_bin_[1], num_bin_[2], in_, out_, FFTW_MEASURE);
+  fftw_initialized_ = true;
+}
+
+void DensityGridFFTW::initialize(MonteCarlo * mc) {
+  Analyze::initialize(mc);
+  const Configuration& config = configuration(mc->system());
+  ASSERT(config.dimension() == 3, "only implemented for 3d.");
+  ASSERT(!config.domain().is_tilted(), "not implemented for tilted domains.");
+  updates_ = 0;
+  num_bin_.resize(config.dimension());
+  bin_dist_.resize(config.dimension());
+  lower_bound_.resize(config.dimension());
+  for (int dim = 0; dim < config.dimension(); ++dim) {
+    const double side_length = config.domain().side_length(dim);
+    if (bins_per_side_ > 0) {
+      ASSERT(config.domain().is_cubic(), "bins_per_side assumes cubic Domain.");
+      num_bin_[dim] = bins_per_side_;
+    } else {
+      num_bin_[dim] = static_cast<int>(side_length/bin_spacing_);
+      if (num_bin_[dim] % 2 != 0) ++num_bin_[dim];
+    }
+    bin_dist_[dim] = side_length/static_cast<double>(num_bin_[dim]);
+    lower_bound_[dim] = -side_length/2.;
+  }
+  DEBUG("num_bin " << feasst_str(num_bin_));
+  delta_q_ = delta_rho_*2.*PI/config.domain().min_side_length();
+  density_sum_.assign(num_nodes_(), 0.);
+  sq_.clear();
+  resize_fftw_variables_();
+}
+
+std::string DensityGridFFTW::header(const MonteCarlo& mc) const {
+  std::stringstream ss;
+  ss << "q,s,s_block_stdev,num_values" << std::endl;
+  return ss.str();
+}
+
+// unnormalized sinc, sin(x)/x
+static double sinc_(const double x) {
+  if (std::abs(x) < NEAR_ZERO) {
+    return 1.;
+  }
+  return std::sin(x)/x;
+}
+
+int DensityGridFFTW::fill_grid_(const Configuration& config) {
+  const int nx = num_bin_[0];
+  const int ny = num_bin_[1];
+  const int nz = num_bin_[2];
+  for (int node = 0; node < num_nodes_(); ++node) {
+    in_[node] = 0.;
+  }
+  int num_sites = 0;
+  std::vector<int> lower(config.dimension());
+  std::vector<double> frac(config.dimension());
+  const Select& selection = config.group_select(0);
+  for (int select_index = 0;
+       select_index < selection.num_particles();
+       ++select_index) {
+    const int part_index = selection.particle_index(select_index);
+    const Particle& part = config.select_particle(part_index);
+    for (int site_index : selection.site_indices(select_index)) {
+      const Site& site = part.site(site_index);
+      if (site.is_physical() &&
+          (site_type_ == -1 || site.type() == site_type_)) {
+        for (int dim = 0; dim < config.dimension(); ++dim) {
+          const int num_bin = num_bin_[dim];
+          const double scaled = (site.position().coord(dim) -
+                                 lower_bound_[dim])/bin_dist_[dim];
+          const double node = std::floor(scaled);
+          frac[dim] = scaled - node;
+          // wrap the lower node in the periodic grid
+          lower[dim] = (static_cast<int>(node) % num_bin + num_bin) % num_bin;
+        }
+        // distribute the site over the eight surrounding nodes
+        for (int corner = 0; corner < 8; ++corner) {
+          const int bx = corner & 1;
+          const int by = (corner >> 1) & 1;
+          const int bz = (corner >> 2) & 1;
+          const double weight = (bx == 1 ? frac[0] : 1. - frac[0])*
+                                (by == 1 ? frac[1] : 1. - frac[1])*
+                                (bz == 1 ? frac[2] : 1. - frac[2]);
+          const int ix = (lower[0] + bx) % nx;
+          const int iy = (lower[1] + by) % ny;
+          const int iz = (lower[2] + bz) % nz;
+          in_[iz + nz*(iy + ny*ix)] += weight;
+        }
+        ++num_sites;
+      }
+    }
+  }
+  return num_sites;
+}
+
+void DensityGridFFTW::update(const MonteCarlo& mc) {
+  const Configuration& config = configuration(mc.system());
+  for (int dim = 0; dim < config.dimension(); ++dim) {
+    ASSERT(std::abs(config.domain().side_length(dim) -
+                    num_bin_[dim]*bin_dist_[dim]) < NEAR_ZERO,
+      "DensityGridFFTW assumes a constant Domain");
+  }
+
+  // density field
+  const int num_sites = fill_grid_(config);
+  for (int node = 0; node < num_nodes_(); ++node) {
+    density_sum_[node] += in_[node];
+  }
+  ++updates_;
+  if (num_sites == 0) {
+    return;
+  }
+
+  // structure factor
+  fftw_execute(plan_);
+  const int nx = num_bin_[0];
+  const int ny = num_bin_[1];
+  const int nz = num_bin_[2];
+  const int nzq = nz/2 + 1;
+  std::vector<double> side(3);
+  for (int dim = 0; dim < 3; ++dim) {
+    side[dim] = num_bin_[dim]*bin_dist_[dim];
+  }
+  std::fill(sq_sum_.begin(), sq_sum_.end(), 0.);
+  std::fill(sq_count_.begin(), sq_count_.end(), 0.);
+  for (int ix = 0; ix < nx; ++ix) {
+    const int mx = (2*ix <= nx) ? ix : ix - nx;
+    const double wx = std::pow(sinc_(PI*mx/static_cast<double>(nx)), 2);
+    for (int iy = 0; iy < ny; ++iy) {
+      const int my = (2*iy <= ny) ? iy : iy - ny;
+      const double wy = std::pow(sinc_(PI*my/static_cast<double>(ny)), 2);
+      for (int iz = 0; iz < nzq; ++iz) {
+        if (mx != 0 || my != 0 || iz != 0) {
+          const double wz = std::pow(sinc_(PI*iz/static_cast<double>(nz)), 2);
+          const double window = wx*wy*wz;
+          const double qx = mx/side[0];
+          const double qy = my/side[1];
+          const double qz = iz/side[2];
+          const double q = 2.*PI*std::sqrt(qx*qx + qy*qy + qz*qz);
+          const int bin = static_cast<int>(std::round(q/delta_q_));
+          if (bin >= static_cast<int>(sq_sum_.size())) {
+            sq_sum_.resize(bin + 1, 0.);
+            sq_count_.resize(bin + 1, 0.);
+          }
+          const int index = iz + nzq*(iy + ny*ix);
+          const double fq2 = out_[index][0]*out_[index][0] +
+                             out_[index][1]*out_[index][1];
+          // the half-complex output stores only one of each +/- iz pair
+          double multiplicity = 2.;
+          if (iz == 0 || 2*iz == nz) {
+            multiplicity = 1.;
+          }
+          sq_sum_[bin] += multiplicity*fq2/num_sites/window/window;
+          sq_count_[bin] += multiplicity;
+        }
+      }
+    }
+  }
+  if (sq_.size() < sq_sum_.size()) {
+    sq_.resize(sq_sum_.size());
+  }
+  for (int bin = 0; bin < static_cast<int>(sq_sum_.size()); ++bin) {
+    if (sq_count_[bin] > 0) {
+      sq_[bin].accumulate(sq_sum_[bin]/sq_count_[bin]);
+    }
+  }
+}
+
+std::vector<double> DensityGridFFTW::density() const {
+  std::vector<double> dens(density_sum_.size(), 0.);
+  if (updates_ > 0) {
+    const double node_volume = product(bin_dist_);
+    for (int node = 0; node < static_cast<int>(dens.size()); ++node) {
+      dens[node] = density_sum_[node]/static_cast<double>(updates_)/
+                   node_volume;
+    }
+  }
+  return dens;
+}
+
+std::vector<double> DensityGridFFTW::q() const {
+  std::vector<double> qs(sq_.size());
+  for (int bin = 0; bin < static_cast<int>(qs.size()); ++bin) {
+    qs[bin] = delta_q_*static_cast<double>(bin);
+  }
+  return qs;
+}
+
+std::string DensityGridFFTW::write(const MonteCarlo& mc) {
+  std::stringstream ss;
+  if (rewrite_header()) {
+    ss << header(mc);
+  }
+  const std::vector<double> qs = q();
+  for (int bin = 0; bin < static_cast<int>(sq_.size()); ++bin) {
+    const Accumulator& sq = sq_[bin];
+    if (sq.num_values() > 0) {
+      ss << qs[bin] << ","
+         << sq.average() << ","
+         << sq.block_stdev() << ","
+         << sq.num_values() << std::endl;
+    }
+  }
+  if (!density_output_file_.empty() && updates_ > 0) {
+    const std::vector<double> dens = density();
+    std::ofstream file(density_output_file_);
+    file << "x,y,z,rho" << std::endl;
+    const int ny = num_bin_[1];
+    const int nz = num_bin_[2];
+    for (int ix = 0; ix < num_bin_[0]; ++ix) {
+      for (int iy = 0; iy < ny; ++iy) {
+        for (int iz = 0; iz < nz; ++iz) {
+          file << lower_bound_[0] + ix*bin_dist_[0] << ","
+               << lower_bound_[1] + iy*bin_dist_[1] << ","
+               << lower_bound_[2] + iz*bin_dist_[2] << ","
+               << dens[iz + nz*(iy + ny*ix)] << std::endl;
+        }
+      }
+    }
+  }
+  return ss.str();
+}
+
+DensityGridFFTW::~DensityGridFFTW() {
+  if (fftw_initialized_) {
+    fftw_destroy_plan(plan_);
+    fftw_free(in_);
+    fftw_free(out_);
+  }
+}
+
+void DensityGridFFTW::serialize(std::ostream& ostr) const {
+  Stepper::serialize(ostr);
+  feasst_serialize_version(2481, ostr);
+  feasst_serialize(fftw_initialized_, ostr);
+  feasst_serialize(bin_spacing_, ostr);
+  feasst_serialize(bins_per_side_, ostr);
+  feasst_serialize(delta_rho_, ostr);
+  feasst_serialize(site_type_, ostr);
+  feasst_serialize(density_output_file_, ostr);
+  feasst_serialize(updates_, ostr);
+  feasst_serialize(delta_q_, ostr);
+  feasst_serialize(num_bin_, ostr);
+  feasst_serialize(bin_dist_, ostr);
+  feasst_serialize(lower_bound_, ostr);
+  feasst_serialize(density_sum_, ostr);
+  feasst_serialize_fstobj(sq_, ostr);
+}
+
+DensityGridFFTW::DensityGridFFTW(std::istream& istr)
+  : Analyze(istr) {
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(2481 == version, "version mismatch:" << version);
+  feasst_deserialize(&fftw_initialized_, istr);
+  feasst_deserialize(&bin_spacing_, istr);
+  feasst_deserialize(&bins_per_side_, istr);
+  feasst_deserialize(&delta_rho_, istr);
+  feasst_deserialize(&site_type_, istr);
+  feasst_deserialize(&density_output_file_, istr);
+  feasst_deserialize(&updates_, istr);
+  feasst_deserialize(&delta_q_, istr);
+  feasst_deserialize(&num_bin_, istr);
+  feasst_deserialize(&bin_dist_, istr);
+  feasst_deserialize(&lower_bound_, istr);
+  feasst_deserialize(&density_sum_, istr);
+  feasst_deserialize_fstobj(&sq_, istr);
+  if (fftw_initialized_) {
+    fftw_initialized_ = false;
+    resize_fftw_variables_();
+  }
+}
+
+}  // namespace feasst
@@ -0,0 +1,11 @@
+#include "utils/test/utils.h"
+#include "fftw/include/density_grid_fftw.h"
+
+namespace feasst {
+
+TEST(DensityGridFFTW, serialize) {
+  auto an = MakeDensityGridFFTW({{"bins_per_side", "16"}, {"delta_rho", "2"}});
+  auto an2 = test_serialize<DensityGridFFTW, Analyze>(*an);
+}
+
+}  // namespace feasst
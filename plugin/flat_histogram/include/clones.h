@@ -14,6 +14,7 @@
 namespace feasst {
 
 class Checkpoint;
+class Configuration;
 class Histogram;
 
 /**
@@ -74,6 +75,14 @@ class Clones {
       write aggregate ln_prob (default: 1e6).
     - ln_prob_file: file name of aggregate ln_prob. If empty (default),
       do not write the file.
+    - batches_per_swap: If OMP and > 0, after every this many omp_batch,
+      attempt to swap configurations with a neighboring clone, alternating
+      between the even and odd pairs of neighbors (see attempt_swap).
+      A clone that reaches this point is ready to swap and continues to run.
+      If its neighbor is already ready, the two clones swap once the neighbor
+      finishes its current omp_batch.
+      Thus, clones do not wait for each other to reach this point.
+      If -1, do not swap (default: -1).
    */
   void run_until_complete(argtype args = argtype());
 
@@ -88,6 +97,30 @@ class Clones {
     argtype run_args = argtype(),
     argtype init_args = argtype());
 
+  /**
+    If the current macrostates of the clones of index lower and lower + 1 are
+    both within the overlap of the two clones, attempt to swap their
+    configurations (e.g., replica exchange).
+    The swap is accepted with probability
+    min(1, exp(lnpi_l(m_l) - lnpi_l(m_u) + lnpi_u(m_u) - lnpi_u(m_l)))
+    where lnpi_l and lnpi_u are the LnProbability of the Bias of the lower
+    and upper clones, and m_l and m_u are their current macrostates.
+    Return true if the swap was accepted.
+   */
+  bool attempt_swap(const int lower);
+
+  /// Return the number of attempted swaps between lower and lower + 1.
+  int num_swaps_attempted(const int lower) const;
+
+  /// Return the number of accepted swaps between lower and lower + 1.
+  int num_swaps_accepted(const int lower) const;
+
+  /// Return the number of trials per wall-clock second of the clone,
+  /// accumulated over all calls to run_until_complete or
+  /// initialize_and_run_until_complete (e.g., a pilot run), including
+  /// those before a checkpoint.
+  double trials_per_second(const int index) const;
+
   /// Set the number of Criteria cycles of all clones.
   void set_cycles_to_complete(const int cycles);
 
@@ -133,12 +166,37 @@ class Clones {
   std::vector<std::shared_ptr<MonteCarlo> > clones_;
   std::shared_ptr<Checkpoint> checkpoint_;
 
+  std::vector<double> timed_seconds_;
+  std::vector<double> timed_trials_;
+
+  // temporary and not serialized
+  std::vector<int> num_swaps_attempted_;
+  std::vector<int> num_swaps_accepted_;
+
   void run_until_complete_omp_(argtype run_args,
                                const bool init = false,
                                argtype init_args = argtype());
   void run_until_complete_serial_();
+  void add_timing_(const int index, const double seconds, const double trials);
 };
 
+/**
+  Stitch together the LnProbability of FlatHistograms with overlapping
+  macrostates, ordered from the lowest to the highest macrostates.
+ */
+LnProbability stitch_ln_prob(
+  const std::vector<std::unique_ptr<FlatHistogram> >& flat_histograms,
+  /// Optionally return spliced macrostates, if not NULL.
+  Histogram * macrostates = NULL,
+  /// Multistate data of each FlatHistogram, if multistate_data is not NULL.
+  const std::vector<std::vector<double> > * window_data = NULL,
+  /// Optionally return spliced multistate data, if not NULL.
+  std::vector<double> * multistate_data = NULL);
+
+/// Replace all particles of the MonteCarlo with those of the Configuration,
+/// then initialize the Criteria.
+void replace_configuration(const Configuration& config, MonteCarlo * mc);
+
 /// Construct Clones
 inline std::shared_ptr<Clones> MakeClones() {
   return std::make_shared<Clones>(); }
@@ -48,6 +48,13 @@ Block standard deviations are computed as described in :footcite:t:`hatch_effici
   - P_down_block_std: The block standard deviation of the mean for P_down.
   - P_up_block_std: The block standard deviation of the mean for P_up.
 
+  By default, each element of the matrix is an Accumulator with higher moments
+  and block averages, which dominate the memory and checkpoint size when there
+  are many macrostates (e.g., MacrostateEnergy).
+  Alternatively, the compact collection matrix stores only the sums of P_down
+  and P_up and the number of trials of each macrostate, with optional block
+  averages of a fixed number of trials.
+
 \rst
 References:
 
@@ -78,6 +85,12 @@ class CollectionMatrix {
     - exp_for_boost: ratio of neighboring probabilities must be within
       10^exp or 10^-exp for boosting.
       If -1, ignore (default: 2).
+    - compact: if true, use the compact collection matrix described above
+      (default: false).
+    - compact_block_size: if compact and > 0, also store the averages of
+      blocks of this number of trials for each macrostate, which are used for
+      the block ln_prob and block standard deviations.
+      If -1, these are not available (default: -1).
    */
   explicit CollectionMatrix(argtype args = argtype());
   explicit CollectionMatrix(argtype * args);
@@ -97,18 +110,58 @@ class CollectionMatrix {
 
   void resize(const int num_macrostates);
 
+  /// Return true if compact.
+  bool is_compact() const { return compact_; }
+
+  /// Return the number of macrostates.
+  int num_macrostates() const;
+
   /// Add value for a given macrostate and state change.
+  /// Not available if compact.
   void increment(const int macro, const int state_change, const double add);
 
-  /// Set values
+  /// Add a trial from the given macrostate with the probabilities to decrease
+  /// and increase the macrostate.
+  void add_trial(const int macro, const double prob_down, const double prob_up);
+
+  /// Set values. Not available if compact.
   void set(const int macro, const std::vector<Accumulator>& values);
 
+  /// Set the values of a macrostate to those of another collection matrix.
+  void set(const int macro, const CollectionMatrix& colmat);
+
+  /// Same as above, but from the given macrostate of the other.
+  void set(const int macro, const CollectionMatrix& colmat,
+           const int colmat_macro);
+
+  /// Return a deep copy of only the macrostates from first to last,
+  /// inclusive, which become macrostates 0 to last - first.
+  /// The copy shares no Accumulator blocks with this CollectionMatrix.
+  CollectionMatrix rows(const int first, const int last) const;
+
+  /// Return the number of trials from the macrostate.
+  double num_trials(const int macro) const;
+
+  /// Return the average probability of the state change (0: decrease,
+  /// 1: increase) from the macrostate.
+  double average(const int macro, const int state_change) const;
+
+  /// Return the block standard deviation of the above average.
+  double block_stdev(const int macro, const int state_change) const;
+
+  /// Return the number of blocks of the macrostate.
+  int num_blocks(const int macro) const;
+
+  /// Return the average of a block of the state change from the macrostate.
+  double block_average(const int macro, const int state_change,
+                       const int block) const;
+
   /// Update the ln_prob according to the collection matrix.
   void compute_ln_prob(LnProbability * ln_prob,
     /// optionaly compute the ln_prob from a block (if != -1).
     const int block = -1) const;
 
-  /// Return the matrix
+  /// Return the matrix. Not available if compact.
   const std::vector<std::vector<Accumulator> >& matrix() const;
 
 //  /// Return the standard deviation of the change in the ln_prob relative to
@@ -118,6 +171,8 @@ class CollectionMatrix {
   std::string write_per_bin(const int bin, const bool widom = false) const;
   std::string write_per_bin_header(const bool widom = false) const;
 
+  /// Return the minimum number of blocks of the macrostates.
+  /// If compact, macrostates without blocks are included.
   int min_blocks() const;
   std::vector<LnProbability> ln_prob_blocks() const;
 
@@ -133,8 +188,17 @@ class CollectionMatrix {
   double delta_ln_prob_guess_;
   int visits_per_delta_ln_prob_boost_;
   double exp_for_boost_;
+  bool compact_;
+  int compact_block_size_;
   std::vector<std::vector<Accumulator> > matrix_;
 
+  // compact storage of the number of trials, the sums of P_down and P_up,
+  // the sums of the current block and the block averages of each macrostate.
+  std::vector<double> num_trials_;
+  std::vector<std::vector<double> > sum_;
+  std::vector<std::vector<double> > block_sum_;
+  std::vector<std::vector<std::vector<double> > > blocks_;
+
   int visits_(const int macro, const int block, const bool lower) const;
 };
 
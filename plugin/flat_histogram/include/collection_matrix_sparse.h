@@ -0,0 +1,113 @@
+#ifndef FEASST_FLAT_HISTOGRAM_COLLECTION_MATRIX_SPARSE_H_
+#define FEASST_FLAT_HISTOGRAM_COLLECTION_MATRIX_SPARSE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace feasst {
+
+class LnProbability;
+
+typedef std::map<std::string, std::string> argtype;
+
+/**
+  In contrast to CollectionMatrix, which is limited to transitions between
+  neighboring macrostates, the sparse collection matrix stores the
+  transitions between any two macrostates, as required for multidimensional
+  macrostates (e.g., MacrostateProduct).
+
+  For each macrostate i, the number of trials, n_i, and the sum of the
+  probabilities to transition to each other macrostate j, C_ij, are stored
+  only for the transitions that were attempted.
+  Thus, the transition probabilities are P_ij = C_ij/n_i.
+
+  The ln_prob is the stationary distribution of P, given by the balance of the
+  probability flux into and out of each macrostate,
+
+  pi_j sum_k P_jk = sum_i pi_i P_ij,
+
+  which is solved iteratively (Gauss-Seidel), beginning with the previous
+  ln_prob.
+  For one-dimensional macrostates with transitions between neighbors, this is
+  equivalent to CollectionMatrix.
+  A macrostate that was visited but never attempted to leave is assumed to
+  leave with unit probability, and a macrostate that was never visited is
+  given the lowest ln_prob, which encourages its sampling.
+ */
+class CollectionMatrixSparse {
+ public:
+  //@{
+  /** @name Arguments
+    - max_iterations: maximum number of iterations to solve for the ln_prob
+      (default: 1e4).
+    - tolerance: stop iterating when the largest change in the ln_prob of any
+      macrostate is less than this value (default: 1e-8).
+   */
+  explicit CollectionMatrixSparse(argtype args = argtype());
+  explicit CollectionMatrixSparse(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Set the number of macrostates and remove all transitions.
+  void resize(const int num_macrostates);
+
+  /// Return the number of macrostates.
+  int num_macrostates() const {
+    return static_cast<int>(num_trials_.size()); }
+
+  /// Add a trial from the old to the new macrostate with the given
+  /// probability.
+  void add_trial(const int macro_old, const int macro_new, const double prob);
+
+  /// Return the number of trials from the macrostate.
+  double num_trials(const int macro) const { return num_trials_[macro]; }
+
+  /// Return the probability to transition from the old to the new macrostate.
+  double probability(const int macro_old, const int macro_new) const;
+
+  /// Return the number of macrostates with transitions from the macrostate.
+  int num_transitions(const int macro) const {
+    return static_cast<int>(to_[macro].size()); }
+
+  /// Return the total number of stored transitions.
+  int num_nonzero() const;
+
+  /// Return true for each macrostate that had trials, or was the new
+  /// macrostate of a trial with a nonzero probability.
+  std::vector<bool> reachable() const;
+
+  /// Update the ln_prob, which is also the initial guess of the iterations.
+  /// Return the number of iterations.
+  int compute_ln_prob(LnProbability * ln_prob) const;
+
+  std::string write_per_bin(const int bin) const;
+  std::string write_per_bin_header() const;
+
+  bool is_equal(const CollectionMatrixSparse& colmat,
+                const double tolerance) const;
+  void serialize(std::ostream& ostr) const;
+  explicit CollectionMatrixSparse(std::istream& istr);
+
+  //@}
+ private:
+  int max_iterations_;
+  double tolerance_;
+  std::vector<double> num_trials_;
+  // for each macrostate, the other macrostates and the sum of probabilities.
+  std::vector<std::vector<int> > to_;
+  std::vector<std::vector<double> > sum_;
+};
+
+inline std::shared_ptr<CollectionMatrixSparse> MakeCollectionMatrixSparse(
+    argtype args = argtype()) {
+  return std::make_shared<CollectionMatrixSparse>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_FLAT_HISTOGRAM_COLLECTION_MATRIX_SPARSE_H_
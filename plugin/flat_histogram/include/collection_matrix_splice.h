@@ -29,6 +29,26 @@ class Histogram;
   Left and right most windows can completely abandon completed macrostates.
   Also, left and right most don't lose macrostates if the entire window
   has already reached its completion criteria.
+
+  In the asynchronous mode, windows do not wait for each other at a global
+  barrier after every hours_per.
+  Instead, after every hours_per, each window publishes a snapshot of its
+  CollectionMatrix, bounds and completion to a shared, versioned slot.
+  A coordinator splices the most recent snapshots to write the ln_prob and
+  bounds files, without stopping any window.
+  If there are more OMP threads than windows, the coordinator is a dedicated
+  thread.
+  Otherwise, the first window to reach its safe point takes the coordinator
+  role, if no other window has it.
+
+  Each round that every window has published a new snapshot, the coordinator
+  requests bounds adjustments between pairs of neighboring windows with
+  different numbers of cycles, alternating between even and odd pairs such
+  that a window is in no more than one pair.
+  Both windows of a requested pair adopt the new bounds at their next safe
+  point, when the window that arrives first waits for its neighbor.
+  Windows not in a requested pair continue to run.
+  Only the Checkpoint requires all windows to wait, and only when due.
  */
 class CollectionMatrixSplice {
  public:
@@ -43,6 +63,8 @@ class CollectionMatrixSplice {
     - num_adjust_per_write: number of adjustments per writing of ln_prob (default: 1)
     - bounds_file: file name for periodic output of bounds, if not empty
       (default: empty).
+    - asynchronous: if true, use the asynchronous mode described above in
+      run_until_all_are_complete (default: false).
    */
   explicit CollectionMatrixSplice(argtype args = argtype());
   explicit CollectionMatrixSplice(argtype * args);
@@ -103,6 +125,9 @@ class CollectionMatrixSplice {
   /// Run until all are complete.
   void run_until_all_are_complete();
 
+  /// Return true if in the asynchronous mode.
+  bool asynchronous() const { return asynchronous_; }
+
   /// Return the complete collection matrix.
   CollectionMatrix collection_matrix() const;
 
@@ -132,6 +157,13 @@ class CollectionMatrixSplice {
   int num_adjust_per_write_;
   int num_adjust_since_write_ = 0;
   std::string bounds_file_;
+  bool asynchronous_;
+
+  void run_until_all_are_complete_asynchronous_();
+  void write_ln_prob_(const std::string& file_name,
+                      const CollectionMatrix& cm) const;
+  void write_bounds_(const std::vector<int>& soft_min,
+                     const int last_soft_max);
 };
 
 /// Construct CollectionMatrixSplice
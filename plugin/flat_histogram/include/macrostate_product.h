@@ -0,0 +1,113 @@
+#ifndef FEASST_FLAT_HISTOGRAM_MACROSTATE_PRODUCT_H_
+#define FEASST_FLAT_HISTOGRAM_MACROSTATE_PRODUCT_H_
+
+#include <memory>
+#include "flat_histogram/include/macrostate.h"
+
+namespace feasst {
+
+/**
+  Defines a two-dimensional macrostate as the product of a first and second
+  one-dimensional Macrostate, such as the number of particles and the energy,
+  or the number of particles of two different types.
+
+  The two-dimensional bins are ordered as a single, one-dimensional bin index,
+  such that the remainder of FlatHistogram is unchanged.
+  The value of the macrostate is given by
+  (offset + first_bin)*num_second + second_bin,
+  where the offset is the center of the first bin of the first Macrostate
+  divided by its width, and num_second is the number of bins of the second
+  Macrostate.
+  Thus, the bin centers of the first Macrostate must be integer multiples of
+  its width (e.g., MacrostateNumParticles with a width of 1).
+
+  Because each value of the first Macrostate is a contiguous series of bins,
+  windows of the first Macrostate, each with the entire range of the second
+  Macrostate, may be used with Clones, CollectionMatrixSplice or WindowsMPI
+  by replacing first_min and first_max with [soft_macro_min] and
+  [soft_macro_max], respectively.
+
+  A trial may change both Macrostates by more than one bin, and thus
+  MacrostateProduct requires a Bias that allows such transitions, such as
+  TransitionMatrixSparse or WangLandau.
+ */
+class MacrostateProduct : public Macrostate {
+ public:
+  //@{
+  /** @name Arguments
+    - first_Macrostate: the name of the first Macrostate
+      (default: MacrostateNumParticles).
+    - first_[arg]: the arguments of the first Macrostate, with the first_
+      prefix removed (e.g., first_width, first_max, first_min and
+      first_particle_type).
+    - second_Macrostate: the name of the second Macrostate
+      (default: MacrostateEnergy).
+    - second_[arg]: the arguments of the second Macrostate, as described above.
+    - Macrostate arguments, which apply to the two-dimensional bins.
+      Histogram arguments are not used.
+  */
+  explicit MacrostateProduct(argtype args);
+  explicit MacrostateProduct(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Construct from the first and second Macrostate.
+  MacrostateProduct(std::shared_ptr<Macrostate> first,
+                    std::shared_ptr<Macrostate> second,
+                    argtype args = argtype());
+  MacrostateProduct(std::shared_ptr<Macrostate> first,
+                    std::shared_ptr<Macrostate> second,
+                    argtype * args);
+
+  /// Return the first Macrostate.
+  const Macrostate& first() const { return *first_; }
+
+  /// Return the second Macrostate.
+  const Macrostate& second() const { return *second_; }
+
+  /// Return the number of bins of the second Macrostate.
+  int num_second() const;
+
+  /// Return the bin of the first Macrostate given the two-dimensional bin.
+  int first_bin(const int bin) const { return bin/num_second(); }
+
+  /// Return the bin of the second Macrostate given the two-dimensional bin.
+  int second_bin(const int bin) const { return bin % num_second(); }
+
+  /// Return the value, as described above, or a value below the Histogram if
+  /// either Macrostate is outside of the range of its Histogram.
+  double value(const System& system,
+    const Criteria& criteria,
+    const Acceptance& acceptance) override;
+  std::shared_ptr<Macrostate> create(std::istream& istr) const override;
+  std::shared_ptr<Macrostate> create(argtype * args) const override;
+  void serialize(std::ostream& ostr) const override;
+  explicit MacrostateProduct(std::istream& istr);
+  MacrostateProduct();
+  virtual ~MacrostateProduct();
+  //@}
+
+ private:
+  std::shared_ptr<Macrostate> first_;
+  std::shared_ptr<Macrostate> second_;
+  int offset_;
+};
+
+inline std::shared_ptr<MacrostateProduct> MakeMacrostateProduct(
+    std::shared_ptr<Macrostate> first,
+    std::shared_ptr<Macrostate> second,
+    argtype args = argtype()) {
+  return std::make_shared<MacrostateProduct>(first, second, args);
+}
+
+inline std::shared_ptr<MacrostateProduct> MakeMacrostateProduct(
+    argtype args) {
+  return std::make_shared<MacrostateProduct>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_FLAT_HISTOGRAM_MACROSTATE_PRODUCT_H_
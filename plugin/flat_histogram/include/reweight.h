@@ -0,0 +1,165 @@
+#ifndef FEASST_FLAT_HISTOGRAM_REWEIGHT_H_
+#define FEASST_FLAT_HISTOGRAM_REWEIGHT_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "flat_histogram/include/ln_probability.h"
+
+namespace feasst {
+
+typedef std::map<std::string, std::string> argtype;
+
+/**
+  Reweight a LnProbability, such as that stitched by Clones::ln_prob, to
+  other values of the chemical potential without additional simulation, and
+  find the conditions of phase equilibrium.
+  This is the C++ analogue of feasst.macrostate_distribution in Python,
+  intended for large grids of chemical potentials.
+
+  The macrostate is the number of particles, N, and the first macrostate must
+  have no particles, so that the grand potential is given by
+
+  beta p V = ln(sum_N Pi(N)) - ln Pi(0).
+
+  Reweighting by the difference in beta mu from that of the simulation is
+
+  ln Pi(N; beta mu + delta_beta_mu) = ln Pi(N; beta mu) + N delta_beta_mu
+
+  followed by normalization.
+
+  Per-macrostate canonical ensemble averages, such as the multistate_data of
+  Clones::ln_prob from an Energy Analyze, may also be added in order to obtain
+  their grand canonical ensemble averages.
+
+  Two phases are separated by a minimum in the ln_prob, as given by
+  LnProbability::minima.
+  Phase equilibrium is found by bisection of the difference in the natural
+  logarithm of the probability of the two phases with respect to
+  delta_beta_mu.
+  If there is no minimum, the difference of the first and last ln_prob is
+  used instead.
+
+  The batch functions isotherm and saturation are parallelized with OpenMP,
+  when available.
+ */
+class Reweight {
+ public:
+  //@{
+  /** @name Arguments
+    - num_smooth: number of macrostates which define the local region of a
+      minimum that separates phases, as described in LnProbability::minima
+      (default: 10).
+    - tolerance: tolerance of the delta_beta_mu at phase equilibrium
+      (default: 1e-10).
+    - max_iterations: maximum number of iterations to bracket and bisect
+      the delta_beta_mu at phase equilibrium (default: 1e3).
+   */
+  Reweight(const LnProbability& ln_prob,
+    /// The value of each macrostate (e.g., the number of particles).
+    const std::vector<double>& macrostates,
+    argtype args = argtype());
+  Reweight(const LnProbability& ln_prob,
+    const std::vector<double>& macrostates,
+    argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Return the ln_prob as simulated.
+  const LnProbability& ln_prob() const { return ln_prob_; }
+
+  /// Return the macrostates.
+  const std::vector<double>& macrostates() const { return macrostates_; }
+
+  /// Add per-macrostate data, such as canonical ensemble averages.
+  void add_data(const std::vector<double>& data);
+
+  /// Return the number of per-macrostate data.
+  int num_data() const { return static_cast<int>(data_.size()); }
+
+  /// Return the normalized ln_prob reweighted by delta_beta_mu.
+  LnProbability ln_prob(const double delta_beta_mu) const;
+
+  /// Return the macrostate index which is the boundary between two phases,
+  /// where the index is included in the second phase.
+  /// If there is more than one local minimum (see LnProbability::minima),
+  /// the boundary is the deepest.
+  /// Return -1 if there is only one phase.
+  int phase_boundary(const LnProbability& ln_prob) const;
+
+  /**
+    Return the grand canonical ensemble averages of the ln_prob over the
+    macrostates from min to max, inclusive, in the following order:
+    - beta p V, where the ln_prob of the empty macrostate is ln_prob.value(0).
+    - the average macrostate.
+    - the average of each data, in the order they were added.
+   */
+  std::vector<double> averages(const LnProbability& ln_prob,
+    const int min = 0,
+    /// If -1, use the last macrostate.
+    int max = -1) const;
+
+  /// Return the averages over all macrostates, as described above, for each
+  /// delta_beta_mu.
+  std::vector<std::vector<double> > isotherm(
+    const std::vector<double>& delta_beta_mu) const;
+
+  /// Return the delta_beta_mu at phase equilibrium.
+  double equilibrium(
+    /// Initial guess of delta_beta_mu, which begins the bracket.
+    const double delta_beta_mu_guess = 0.) const;
+
+  /**
+    Return the saturation properties in the following order:
+    - delta_beta_mu at phase equilibrium.
+    - the averages of the first (e.g., vapor) phase, as described above.
+    - the averages of the second (e.g., liquid) phase.
+
+    Return an empty vector if there is only one phase at the delta_beta_mu
+    which equates the first and last ln_prob (e.g., supercritical).
+   */
+  std::vector<double> saturation(const double delta_beta_mu_guess = 0.) const;
+
+  //@}
+ private:
+  LnProbability ln_prob_;
+  std::vector<double> macrostates_;
+  std::vector<std::vector<double> > data_;
+  int num_smooth_;
+  double tolerance_;
+  int max_iterations_;
+
+  double phase_difference_(const double delta_beta_mu) const;
+};
+
+/// Return the saturation properties, as described in Reweight::saturation,
+/// of each Reweight (e.g., at different temperatures) in parallel.
+std::vector<std::vector<double> > saturation(
+  const std::vector<Reweight>& reweights,
+  const double delta_beta_mu_guess = 0.);
+
+/**
+  Return an estimate of the critical temperature and critical density, in
+  that order, given the saturated densities at a number of temperatures
+  below the critical point.
+  The critical temperature is obtained from a least squares fit of the
+  scaling law,
+  (rho_l - rho_v)^(1/exponent) proportional to (T_c - T),
+  and the critical density from the law of rectilinear diameters,
+  (rho_l + rho_v)/2 = rho_c + A(T_c - T).
+ */
+std::vector<double> critical_point(
+  const std::vector<double>& temperature,
+  /// The saturated density (or average macrostate) of the first phase.
+  const std::vector<double>& vapor,
+  /// The saturated density (or average macrostate) of the second phase.
+  const std::vector<double>& liquid,
+  /// The critical exponent of the order parameter (default: 3D Ising).
+  const double exponent = 0.326);
+
+}  // namespace feasst
+
+#endif  // FEASST_FLAT_HISTOGRAM_REWEIGHT_H_
@@ -0,0 +1,100 @@
+#ifndef FEASST_FLAT_HISTOGRAM_TRANSITION_MATRIX_SPARSE_H_
+#define FEASST_FLAT_HISTOGRAM_TRANSITION_MATRIX_SPARSE_H_
+
+#include <vector>
+#include <memory>
+#include "flat_histogram/include/bias.h"
+
+namespace feasst {
+
+class CollectionMatrixSparse;
+
+/**
+  Transition-matrix flat histogram bias for trials that may transition
+  between any two macrostates, such as the multidimensional MacrostateProduct,
+  using CollectionMatrixSparse.
+  Otherwise, this is similar to TransitionMatrix.
+
+  A sweep is performed when each macrostate in the soft range is entered
+  min_visits times by accepted trials from another macrostate.
+  Only the macrostates that were reached by a trial, as given by
+  CollectionMatrixSparse::reachable, are required for a sweep, because many
+  of the bins of a multidimensional macrostate may be impossible to reach.
+
+  Unlike TransitionMatrix, the visits are not counted separately for
+  increases and decreases of the macrostate, so the endpoints of the
+  macrostate range do not require special treatment, and the arguments
+  is_endpoint and macro of update are not used.
+  Similarly, num_cycles is the number of sweeps for any state.
+
+  CriteriaWriter outputs the following:
+  - num_sweeps: the number of sweeps.
+  - rows for each Macrostate with the following:
+    - visits: the number of accepted transitions into this Macrostate since the
+      last sweep.
+    - CollectionMatrixSparse data.
+ */
+class TransitionMatrixSparse : public Bias {
+ public:
+  //@{
+  /** @name Arguments
+    - CollectionMatrixSparse arguments.
+    - min_visits: A sweep is performed when all macrostates are visited by
+      another macrostate this number of times (default: 100).
+    - min_sweeps: Number of sweeps required for completion.
+   */
+  explicit TransitionMatrixSparse(argtype args = argtype());
+  explicit TransitionMatrixSparse(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  void update(
+    const int macrostate_old,
+    const int macrostate_new,
+    const double ln_metropolis_prob,
+    const bool is_accepted,
+    const bool is_endpoint,
+    const Macrostate& macro) override;
+
+  /// Return the CollectionMatrixSparse.
+  const CollectionMatrixSparse& collection_matrix() const {
+    return *collection_; }
+
+  int cycles_to_complete() const override { return min_sweeps_; }
+  void set_cycles_to_complete(const int sweeps) override;
+  int num_cycles(const int state, const Macrostate& macro) const override;
+  const LnProbability& ln_prob() const override;
+  void resize(const Histogram& histogram) override;
+  std::string write() const override;
+  std::string write_per_bin(const int bin) const override;
+  std::string write_per_bin_header(const std::string& append) const override;
+  void set_ln_prob(const LnProbability& ln_prob) override;
+  void infrequent_update(const Macrostate& macro) override;
+  std::shared_ptr<Bias> create(std::istream& istr) const override;
+  std::shared_ptr<Bias> create(argtype * args) const override {
+    return std::make_shared<TransitionMatrixSparse>(args); }
+  void serialize(std::ostream& ostr) const override;
+  explicit TransitionMatrixSparse(std::istream& istr);
+  virtual ~TransitionMatrixSparse();
+
+  //@}
+ private:
+  std::unique_ptr<CollectionMatrixSparse> collection_;
+  std::unique_ptr<LnProbability> ln_prob_;
+  std::vector<int> visits_;
+  int min_visits_ = 0;
+  int num_sweeps_ = 0;
+  int min_sweeps_ = 0;
+};
+
+inline std::shared_ptr<TransitionMatrixSparse> MakeTransitionMatrixSparse(
+    argtype args = argtype()) {
+  return std::make_shared<TransitionMatrixSparse>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_FLAT_HISTOGRAM_TRANSITION_MATRIX_SPARSE_H_
@@ -72,6 +72,9 @@ class Window {
   /// Return the overlap.
   int overlap() const { return overlap_; }
 
+  /// Return the minimum size of each window.
+  int min_size() const { return min_size_; }
+
   /// Return the continuous, segmented boundaries of the range.
   /// This should be return num + 1 boundaries, to include global min and max.
   virtual std::vector<double> segment() const = 0;
@@ -0,0 +1,102 @@
+#ifndef FEASST_FLAT_HISTOGRAM_WINDOW_COST_H_
+#define FEASST_FLAT_HISTOGRAM_WINDOW_COST_H_
+
+#include <vector>
+#include <map>
+#include <string>
+#include "flat_histogram/include/window.h"
+
+namespace feasst {
+
+typedef std::map<std::string, std::string> argtype;
+
+class Clones;
+
+/**
+  Determine windows that are expected to complete in roughly the same
+  wall-clock time, given the cost of each macrostate.
+  In contrast, WindowExponential requires a choice of alpha, and windows
+  of equal width may take much longer to complete at high macrostates, where
+  each trial is more expensive and the macrostate relaxes more slowly.
+
+  The wall time of a window from macrostate a to b, inclusive, is modeled as
+  the time for a random walk to diffuse across the window,
+
+  \f$t(a, b) = (b - a + 1) \sum_{m=a}^{b} c(m)\f$
+
+  where \f$c(m)\f$ is the cost of macrostate \f$m\f$, given by the wall time
+  per trial multiplied by the average number of trials to leave the
+  macrostate.
+  For a constant cost, the windows are of equal width, as in
+  WindowExponential with alpha of unity.
+
+  The boundaries minimize the maximum wall time of any window.
+  A target wall time is bisected, where all but the last window are as large
+  as possible without exceeding the target, and the last window contains the
+  remaining macrostates.
+  Overlapping macrostates are included in the wall time of both windows.
+
+  The cost may be estimated by window_cost from a short pilot run of Clones
+  (e.g., with a small Clones::set_cycles_to_complete).
+  Because the statistics and timing accumulate and are checkpointed, the
+  windows may be re-planned with window_cost between runs of the Clones,
+  such as before restarting from a checkpoint with new windows.
+  The windows are not re-planned during a run.
+ */
+class WindowCost : public Window {
+ public:
+  //@{
+  /** @name Arguments
+    - Window arguments, where maximum is given by the minimum and the size of
+      the cost, and num is required.
+   */
+  explicit WindowCost(
+    /// The cost of each macrostate, beginning with the minimum.
+    const std::vector<double>& cost,
+    argtype args = argtype());
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Return the cost of each macrostate.
+  const std::vector<double>& cost() const { return cost_; }
+
+  /// Return the modeled wall time of a window from macrostate min to max,
+  /// inclusive, as described above.
+  double time(const int min, const int max) const;
+
+  /// Return the modeled wall time of each window of the boundaries.
+  std::vector<double> times() const;
+
+  std::vector<double> segment() const override { return segment_; }
+  virtual ~WindowCost() {}
+
+  //@}
+ private:
+  std::vector<double> cost_;
+  // cumulative sum of cost, beginning with zero.
+  std::vector<double> cumulative_;
+  std::vector<double> segment_;
+
+  double plan_(const double target, std::vector<double> * segment) const;
+};
+
+/**
+  Return the cost of each macrostate, as described in WindowCost, beginning
+  with the minimum macrostate of the first clone and ending with the maximum
+  of the last clone.
+  The wall time per trial is the inverse of Clones::trials_per_second,
+  linearly interpolated between the centers of each clone.
+  The average number of trials to leave a macrostate is
+  1/(P_down + P_up) of the CollectionMatrix of the Bias (e.g.,
+  TransitionMatrix or WLTM), averaged over the clones which contain the
+  macrostate.
+  Macrostates which were never visited are given the average of the clone.
+ */
+std::vector<double> window_cost(const Clones& clones);
+
+}  // namespace feasst
+
+#endif  // FEASST_FLAT_HISTOGRAM_WINDOW_COST_H_
@@ -8,7 +8,10 @@
 //#endif
 #include <thread>         // std::this_thread::sleep_for
 #include <chrono>         // std::chrono::seconds
+#include <cmath>
 #include <fstream>
+#include <mutex>
+#include <condition_variable>
 #include "utils/include/custom_exception.h"
 #include "utils/include/arguments.h"
 #include "utils/include/debug.h"
@@ -18,9 +21,11 @@
 #include "math/include/histogram.h"
 #include "math/include/utils_math.h"
 #include "math/include/accumulator.h"
+#include "math/include/random.h"
 #include "configuration/include/configuration.h"
 #include "system/include/system.h"
 #include "monte_carlo/include/acceptance.h"
+#include "monte_carlo/include/trial_factory.h"
 #include "flat_histogram/include/bias.h"
 #include "flat_histogram/include/macrostate.h"
 #include "flat_histogram/include/flat_histogram.h"
@@ -119,10 +124,39 @@ void Clones::run_until_complete(argtype args) {
 #endif // _OPENMP
 }
 
+void Clones::add_timing_(const int index, const double seconds,
+                         const double trials) {
+  if (static_cast<int>(timed_seconds_.size()) < num()) {
+    timed_seconds_.resize(num(), 0.);
+    timed_trials_.resize(num(), 0.);
+  }
+  timed_seconds_[index] += seconds;
+  timed_trials_[index] += trials;
+}
+
+double Clones::trials_per_second(const int index) const {
+  ASSERT(index < static_cast<int>(timed_seconds_.size()) &&
+         timed_seconds_[index] > 0,
+    "no timed runs of clone: " << index);
+  return timed_trials_[index]/timed_seconds_[index];
+}
+
+// Return the wall-clock seconds since the start.
+static double seconds_since_(
+    const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+}
+
 void Clones::run_until_complete_serial_() {
   DEBUG("run_until_complete_serial_");
-  for (auto clone : clones_) {
+  for (int index = 0; index < num(); ++index) {
+    MonteCarlo * clone = clones_[index].get();
+    const int64_t attempts = clone->trials().num_attempts();
+    const auto start = std::chrono::steady_clock::now();
     clone->run_until_complete();
+    add_timing_(index, seconds_since_(start),
+                static_cast<double>(clone->trials().num_attempts() - attempts));
   }
 }
 
@@ -134,6 +168,77 @@ bool are_all_complete(const std::vector<bool>& is_complete) {
   return complete;
 }
 
+void replace_configuration(const Configuration& config, MonteCarlo * mc) {
+  Configuration * mc_config = mc->get_system()->get_configuration();
+  if (mc_config->num_particles() > 0) {
+    mc_config->remove_particles(mc_config->selection_of_all());
+  }
+  mc_config->copy_particles(config, true);
+  mc->initialize_criteria();
+}
+
+// Return the current value of the macrostate of the clone.
+static double clone_macrostate_(const MonteCarlo& mc) {
+  return const_cast<Macrostate&>(mc.criteria().macrostate()).value(
+    mc.system(), mc.criteria(), Acceptance());
+}
+
+// Return the ln_prob of the bias of the clone at the macrostate value.
+static double clone_ln_prob_(const MonteCarlo& mc, const double value) {
+  const FlatHistogram& fh = mc.criteria().flat_histogram();
+  return fh.bias().ln_prob().value(fh.macrostate().histogram().bin(value));
+}
+
+// Return true if the macrostate value is within the range of the clone.
+static bool in_clone_range_(const MonteCarlo& mc, const double value) {
+  const Macrostate& macro = mc.criteria().macrostate();
+  return is_in_interval(value, macro.value(0),
+                        macro.histogram().center_of_last_bin());
+}
+
+bool Clones::attempt_swap(const int lower) {
+  ASSERT(lower + 1 < num(), "lower: " << lower << " has no upper clone");
+  MonteCarlo * mc_lower = get_clone(lower);
+  MonteCarlo * mc_upper = get_clone(lower + 1);
+  const double macro_lower = clone_macrostate_(*mc_lower);
+  const double macro_upper = clone_macrostate_(*mc_upper);
+  if (!in_clone_range_(*mc_lower, macro_upper) ||
+      !in_clone_range_(*mc_upper, macro_lower)) {
+    return false;
+  }
+  if (static_cast<int>(num_swaps_attempted_.size()) < num()) {
+    num_swaps_attempted_.resize(num(), 0);
+    num_swaps_accepted_.resize(num(), 0);
+  }
+  ++num_swaps_attempted_[lower];
+  const double ln_accept =
+      clone_ln_prob_(*mc_lower, macro_lower)
+    - clone_ln_prob_(*mc_lower, macro_upper)
+    + clone_ln_prob_(*mc_upper, macro_upper)
+    - clone_ln_prob_(*mc_upper, macro_lower);
+  DEBUG("ln_accept " << ln_accept);
+  if (mc_lower->get_random()->uniform() < std::exp(ln_accept)) {
+    std::stringstream ss;
+    mc_lower->configuration().serialize(ss);
+    Configuration lower_config(ss);
+    replace_configuration(mc_upper->configuration(), mc_lower);
+    replace_configuration(lower_config, mc_upper);
+    ++num_swaps_accepted_[lower];
+    return true;
+  }
+  return false;
+}
+
+int Clones::num_swaps_attempted(const int lower) const {
+  if (lower >= static_cast<int>(num_swaps_attempted_.size())) return 0;
+  return num_swaps_attempted_[lower];
+}
+
+int Clones::num_swaps_accepted(const int lower) const {
+  if (lower >= static_cast<int>(num_swaps_accepted_.size())) return 0;
+  return num_swaps_accepted_[lower];
+}
+
 void Clones::run_until_complete_omp_(argtype run_args,
                                      const bool init,
                                      argtype init_args) {
@@ -144,10 +249,52 @@ void Clones::run_until_complete_omp_(argtype run_args,
   if (used("ln_prob_file", run_args)) {
     ln_prob_file = str("ln_prob_file", &run_args);
   }
+  const int batches_per_swap = integer("batches_per_swap", &run_args, -1);
   feasst_check_all_used(run_args);
   std::vector<bool> is_complete(num(), false);
   std::vector<bool> is_initialized(num(), false);
   is_initialized[0] = true;
+  num_swaps_attempted_.assign(num(), 0);
+  num_swaps_accepted_.assign(num(), 0);
+  std::vector<double> seconds(num(), 0.), trials(num(), 0.);
+
+  // A clone that reaches a swap point is ready to swap with its neighbor and
+  // continues to run.
+  // If the neighbor is already ready, the clone requests the swap and waits
+  // for the neighbor to perform the swap after its current batch.
+  // Thus, a clone never waits for its neighbor to reach a swap point.
+  std::mutex swap_mutex;
+  std::condition_variable swap_condition;
+  std::vector<int> swap_ready(num(), -1);
+  std::vector<bool> swap_requested(num(), false);
+  std::vector<bool> is_finished(num(), false);
+  // Perform the swaps requested of the ready thread, if any.
+  auto perform_requested_swaps = [&](const int thread) {
+    std::lock_guard<std::mutex> lock(swap_mutex);
+    for (const int lower : {thread - 1, thread}) {
+      if (lower >= 0 && lower + 1 < num() && swap_requested[lower]) {
+        attempt_swap(lower);
+        swap_requested[lower] = false;
+        swap_condition.notify_all();
+      }
+    }
+  };
+  // Alternate between the even and odd pairs of neighbors with the phase.
+  auto swap_point = [&](const int thread, const int phase) {
+    const int lower = (thread % 2 == phase) ? thread : thread - 1;
+    if (lower < 0 || lower + 1 >= num()) return;
+    const int neighbor = (thread == lower) ? lower + 1 : lower;
+    std::unique_lock<std::mutex> lock(swap_mutex);
+    if (swap_ready[lower] == neighbor) {
+      swap_ready[lower] = -1;
+      swap_requested[lower] = true;
+      swap_condition.wait(lock, [&]{
+        return !swap_requested[lower] || is_finished[neighbor]; });
+      swap_requested[lower] = false;
+    } else {
+      swap_ready[lower] = thread;
+    }
+  };
   #pragma omp parallel
   {
     const int thread = omp_get_thread_num();
@@ -175,8 +322,25 @@ void Clones::run_until_complete_omp_(argtype run_args,
 
         // continue running while waiting for all threads to complete
         if (clone->criteria().is_complete()) is_complete[thread] = true;
+        int batch = 0;
+        const int64_t attempts = clone->trials().num_attempts();
+        const auto start = std::chrono::steady_clock::now();
+        double swap_seconds = 0.;
         while (!are_all_complete(is_complete)) {
           clone->attempt(omp_batch);
+          ++batch;
+          if (batches_per_swap > 0) {
+            // exclude the time spent swapping from the timing of the clone
+            const auto swap_start = std::chrono::steady_clock::now();
+            perform_requested_swaps(thread);
+            if (batch % batches_per_swap == 0) {
+              swap_point(thread, (batch/batches_per_swap) % 2);
+            }
+            swap_seconds += seconds_since_(swap_start);
+          }
+          seconds[thread] = seconds_since_(start) - swap_seconds;
+          trials[thread] = static_cast<double>(
+            clone->trials().num_attempts() - attempts);
           if (clone->criteria().is_complete()) is_complete[thread] = true;
           if (thread == 0) {
             if (!ln_prob_file.empty()) {
@@ -195,6 +359,11 @@ void Clones::run_until_complete_omp_(argtype run_args,
       terminated = true;
     }
     DEBUG("terminated: " << terminated);
+    if (thread < num()) {
+      std::lock_guard<std::mutex> lock(swap_mutex);
+      is_finished[thread] = true;
+      swap_condition.notify_all();
+    }
 
     if (thread == 0 && checkpoint_) checkpoint_->write(*this);
     if (thread < num()) clones_[thread]->write_checkpoint();
@@ -204,6 +373,9 @@ void Clones::run_until_complete_omp_(argtype run_args,
       FATAL("Clones::run_until_complete_omp was terminated.");
     }
   }
+  for (int index = 0; index < num(); ++index) {
+    add_timing_(index, seconds[index], trials[index]);
+  }
 
 #else // _OPENMP
 FATAL("Not complied with OMP");
@@ -230,24 +402,41 @@ LnProbability Clones::ln_prob(Histogram * macrostates,
     std::vector<double> * multistate_data,
     const std::string analyze_name,
     const AnalyzeData& get) const {
+  std::vector<std::unique_ptr<FlatHistogram> > flat_histograms;
+  std::vector<std::vector<double> > window_data;
+  for (int index = 0; index < num(); ++index) {
+    flat_histograms.push_back(flat_histogram(index));
+    if (multistate_data) {
+      window_data.push_back(
+        SeekAnalyze().multistate_data(analyze_name, clone(index), get));
+    }
+  }
+  return stitch_ln_prob(flat_histograms, macrostates, &window_data,
+                        multistate_data);
+}
+
+LnProbability stitch_ln_prob(
+    const std::vector<std::unique_ptr<FlatHistogram> >& flat_histograms,
+    Histogram * macrostates,
+    const std::vector<std::vector<double> > * window_data,
+    std::vector<double> * multistate_data) {
+  const int num = static_cast<int>(flat_histograms.size());
   std::vector<double> ln_prob;
   std::vector<double> edges;
   double shift = 0.;
   int starting_lower_bin = 0;
-  for (int fh_index = 0; fh_index < num() - 1; ++fh_index) {
+  for (int fh_index = 0; fh_index < num - 1; ++fh_index) {
     DEBUG("fh_index " << fh_index);
-    std::unique_ptr<FlatHistogram> fh_lower = flat_histogram(fh_index);
-    std::unique_ptr<FlatHistogram> fh_upper = flat_histogram(fh_index + 1);
+    const FlatHistogram * fh_lower = flat_histograms[fh_index].get();
+    const FlatHistogram * fh_upper = flat_histograms[fh_index + 1].get();
     const double macro_upper_min = fh_upper->macrostate().value(0);
 
     // Optionally, extract multistate_data
     std::vector<double> lower_data, upper_data;
     if (multistate_data) {
-      SeekAnalyze seek;
-      lower_data = seek.multistate_data(analyze_name, clone(fh_index), get);
-      upper_data = seek.multistate_data(analyze_name, clone(fh_index + 1), get);
+      lower_data = (*window_data)[fh_index];
+      upper_data = (*window_data)[fh_index + 1];
     }
-
     int upper_index = 0;
     std::vector<double> overlap_upper;
     std::vector<double> overlap_lower;
@@ -302,10 +491,10 @@ LnProbability Clones::ln_prob(Histogram * macrostates,
   }
 
   // now add the non-overlapping part of the last clone
-  std::unique_ptr<FlatHistogram> fh = flat_histogram(num() - 1);
+  const FlatHistogram * fh = flat_histograms.back().get();
   std::vector<double> data;
   if (multistate_data) {
-    data = SeekAnalyze().multistate_data(analyze_name, clone(num() - 1), get);
+    data = window_data->back();
   }
   for (int bin = starting_lower_bin; bin < fh->bias().ln_prob().size(); ++bin) {
     ln_prob.push_back(fh->bias().ln_prob().value(bin) + shift);
@@ -327,15 +516,17 @@ LnProbability Clones::ln_prob(Histogram * macrostates,
 }
 
 void Clones::serialize(std::ostream& ostr) const {
-  feasst_serialize_version(2845, ostr);
+  feasst_serialize_version(2846, ostr);
   feasst_serialize(clones_, ostr);
 //  feasst_serialize(checkpoint_, ostr);
+  feasst_serialize(timed_seconds_, ostr);
+  feasst_serialize(timed_trials_, ostr);
   feasst_serialize_endcap("Clones", ostr);
 }
 
 Clones::Clones(std::istream& istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(version == 2845, "version: " << version);
+  ASSERT(version >= 2845 && version <= 2846, "version: " << version);
   // HWH for unknown reasons, this does not work
   //feasst_deserialize(&clones_, istr);
   int dim1;
@@ -356,6 +547,10 @@ Clones::Clones(std::istream& istr) {
 //      checkpoint_ = std::make_shared<Checkpoint>(istr);
 //    }
 //  }
+  if (version >= 2846) {
+    feasst_deserialize(&timed_seconds_, istr);
+    feasst_deserialize(&timed_trials_, istr);
+  }
   feasst_deserialize_endcap("Clones", istr);
 }
 
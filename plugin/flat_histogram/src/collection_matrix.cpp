@@ -4,6 +4,7 @@
 #include "utils/include/arguments.h"
 #include "utils/include/utils.h"  // is_equal
 #include "utils/include/serialize.h"
+#include "utils/include/serialize_extra.h"
 #include "utils/include/io.h"
 #include "utils/include/debug.h"
 #include "math/include/constants.h"
@@ -19,13 +20,93 @@ CollectionMatrix::CollectionMatrix(argtype * args) {
   visits_per_delta_ln_prob_boost_ = integer("visits_per_delta_ln_prob_boost",
     args, -1);
   exp_for_boost_ = dble("exp_for_boost", args, 2);
+  compact_ = boolean("compact", args, false);
+  compact_block_size_ = integer("compact_block_size", args, -1);
 }
 CollectionMatrix::CollectionMatrix(argtype args)
   : CollectionMatrix(&args) {
   feasst_check_all_used(args);
 }
 
+int CollectionMatrix::num_macrostates() const {
+  if (compact_) {
+    return static_cast<int>(num_trials_.size());
+  }
+  return static_cast<int>(matrix_.size());
+}
+
+double CollectionMatrix::num_trials(const int macro) const {
+  if (compact_) {
+    return num_trials_[macro];
+  }
+  return static_cast<double>(matrix_[macro][0].num_values());
+}
+
+double CollectionMatrix::average(const int macro,
+    const int state_change) const {
+  if (compact_) {
+    if (num_trials_[macro] > 0) {
+      return sum_[macro][state_change]/num_trials_[macro];
+    }
+    return 0.;
+  }
+  return matrix_[macro][state_change].average();
+}
+
+int CollectionMatrix::num_blocks(const int macro) const {
+  if (compact_) {
+    if (blocks_.size() == 0) {
+      return 0;
+    }
+    return static_cast<int>(blocks_[macro][0].size());
+  }
+  // as in the previous versions, use the smallest blocks of the decrease.
+  const Accumulator& acc = matrix_[macro][0];
+  if (acc.block_size().size() == 0) {
+    return 0;
+  }
+  return static_cast<int>(acc.blocks()[0].size());
+}
+
+double CollectionMatrix::block_average(const int macro, const int state_change,
+    const int block) const {
+  if (compact_) {
+    return blocks_[macro][state_change][block];
+  }
+  return matrix_[macro][state_change].blocks()[0][block];
+}
+
+double CollectionMatrix::block_stdev(const int macro,
+    const int state_change) const {
+  if (!compact_) {
+    return matrix_[macro][state_change].block_stdev();
+  }
+  const int num = num_blocks(macro);
+  if (num < 2) {
+    return 0.;
+  }
+  const std::vector<double>& blocks = blocks_[macro][state_change];
+  double sum = 0., sum_sq = 0.;
+  for (const double block : blocks) {
+    sum += block;
+    sum_sq += block*block;
+  }
+  const double av = sum/static_cast<double>(num);
+  const double var = (sum_sq/static_cast<double>(num) - av*av)
+                   *static_cast<double>(num)/static_cast<double>(num - 1);
+  if (var <= 0.) {
+    return 0.;
+  }
+  return std::sqrt(var/static_cast<double>(num));
+}
+
 int CollectionMatrix::visits_(const int macro, const int block, const bool lower) const {
+  if (compact_) {
+    if (block == -1) {
+      return static_cast<int>(num_trials_[macro]);
+    }
+    return num_blocks(macro);
+  }
   if (block == -1) {
     if (lower) {
       return matrix_[macro][1].num_values();
@@ -45,23 +126,43 @@ int CollectionMatrix::visits_(const int macro, const int block, const bool lower
 void CollectionMatrix::compute_ln_prob(
     LnProbability * ln_prob,
     const int block) const {
-  ASSERT(ln_prob->size() > 0, "error");
-  ln_prob->set_value(0, 0.);
-  for (int macro = 1; macro < ln_prob->size(); ++macro) {
-    const double ln_prob_previous = ln_prob->value(macro - 1);
-//    if (block == -1) INFO("ln_prob_previous " << ln_prob_previous);
+  const int num = ln_prob->size();
+  ASSERT(num > 0, "error");
+  ASSERT(num <= num_macrostates(), "ln_prob size: " << num << " > "
+    << num_macrostates());
+  // bounds of the ratio of neighboring probabilities for boosting.
+  double max_ratio = -1., min_ratio = -1.;
+  if (exp_for_boost_ > 0) {
+    max_ratio = std::pow(10, exp_for_boost_);
+    min_ratio = 1./max_ratio;
+  }
+  std::vector<double> values(num);
+  values[0] = 0.;
+  // P_up from the previous macrostate, which is loaded only once per bin.
+  double prob_increase_previous = 0.;
+  if (block == -1) {
+    prob_increase_previous = average(0, 1);
+  } else if (visits_(0, block, true) > 0) {
+    prob_increase_previous = block_average(0, 1, block);
+  }
+  for (int macro = 1; macro < num; ++macro) {
+    const double ln_prob_previous = values[macro - 1];
+    const double prob_increase = prob_increase_previous;
     const int vis_up = visits_(macro - 1, block, true);
     const int vis_down = visits_(macro, block, false);
+    if (block == -1) {
+      prob_increase_previous = average(macro, 1);
+    } else if (visits_(macro, block, true) > 0) {
+      prob_increase_previous = block_average(macro, 1, block);
+    }
     if (vis_up == 0 || vis_down == 0) {
       double delta_ln_prob = delta_ln_prob_guess_;
       if (visits_per_delta_ln_prob_boost_ > 0) {
         if (vis_up == 0) {
-          //delta_ln_prob += 0.01*vis_down/visits_per_delta_ln_prob_boost_;
           bool boost = true;
-          if (exp_for_boost_ > 0 && macro < ln_prob->size() - 1) {
-            const double ratio = matrix_[macro][0].average()/
-                                 matrix_[macro+1][0].average();
-            if (ratio > pow(10, exp_for_boost_) || ratio < pow(10, -exp_for_boost_)) {
+          if (exp_for_boost_ > 0 && macro < num - 1) {
+            const double ratio = average(macro, 0)/average(macro + 1, 0);
+            if (ratio > max_ratio || ratio < min_ratio) {
               boost = false;
               DEBUG("macro " << macro << " ratio " << ratio);
             }
@@ -72,9 +173,8 @@ void CollectionMatrix::compute_ln_prob(
         } else if (vis_down == 0) {
           bool boost = true;
           if (exp_for_boost_ > 0 && macro > 1) {
-            const double ratio = matrix_[macro-1][1].average()/
-                                 matrix_[macro-2][1].average();
-            if (ratio > pow(10, exp_for_boost_) || ratio < pow(10, -exp_for_boost_)) {
+            const double ratio = average(macro - 1, 1)/average(macro - 2, 1);
+            if (ratio > max_ratio || ratio < min_ratio) {
               boost = false;
               DEBUG("macro " << macro << " ratio " << ratio);
             }
@@ -84,40 +184,28 @@ void CollectionMatrix::compute_ln_prob(
           }
         }
       }
-      ln_prob->set_value(macro, ln_prob_previous + delta_ln_prob);
+      values[macro] = ln_prob_previous + delta_ln_prob;
     } else {
       double prob_decrease;
       if (block == -1) {
-        prob_decrease = matrix_[macro][0].average();
+        prob_decrease = average(macro, 0);
       } else {
-        prob_decrease = matrix_[macro][0].blocks()[0][block];
+        prob_decrease = block_average(macro, 0, block);
       }
-//      if (block == -1) INFO("prob_decrease " << prob_decrease);
-      if (prob_decrease == 0) {
-        ln_prob->set_value(macro, ln_prob_previous);
+      if (prob_decrease == 0 || prob_increase == 0) {
+        values[macro] = ln_prob_previous;
       } else {
-        double prob_increase;
-        if (block == -1) {
-          prob_increase = matrix_[macro - 1][1].average();
+        const double ln_prob_new = ln_prob_previous
+                                 + std::log(prob_increase/prob_decrease);
+        if (std::isnan(ln_prob_new) || std::isinf(ln_prob_new)) {
+          values[macro] = ln_prob_previous;
         } else {
-          prob_increase = matrix_[macro - 1][1].blocks()[0][block];
-        }
-//        if (block == -1) INFO("prob_increase " << prob_increase);
-        if (prob_increase == 0) {
-          ln_prob->set_value(macro, ln_prob_previous);
-        } else {
-          const double ln_prob_new = ln_prob_previous
-                                   + log(prob_increase/prob_decrease);
-//          if (block == -1) INFO("ln_prob_new " << ln_prob_new);
-          if (std::isnan(ln_prob_new) || std::isinf(ln_prob_new)) {
-            ln_prob->set_value(macro, ln_prob_previous);
-          } else {
-            ln_prob->set_value(macro, ln_prob_new);
-          }
+          values[macro] = ln_prob_new;
         }
       }
     }
   }
+  *ln_prob = LnProbability(values);
   ln_prob->normalize();
 }
 
@@ -126,6 +214,7 @@ void CollectionMatrix::increment(
     const int column,
     const double inc) {
   DEBUG("row " << row << " column " << column << " size " << matrix_.size());
+  ASSERT(!compact_, "use add_trial for a compact CollectionMatrix");
   ASSERT(row < static_cast<int>(matrix_.size()),
     "row: " << row << "  size: " << matrix_.size());
   ASSERT(column < static_cast<int>(matrix_[row].size()),
@@ -133,26 +222,88 @@ void CollectionMatrix::increment(
   matrix_[row][column].accumulate(inc);
 }
 
+void CollectionMatrix::add_trial(const int macro, const double prob_down,
+    const double prob_up) {
+  if (!compact_) {
+    increment(macro, 0, prob_down);
+    increment(macro, 1, prob_up);
+    return;
+  }
+  ASSERT(macro < num_macrostates(),
+    "macro: " << macro << " size: " << num_macrostates());
+  num_trials_[macro] += 1.;
+  std::vector<double>& sum = sum_[macro];
+  sum[0] += prob_down;
+  sum[1] += prob_up;
+  if (compact_block_size_ > 0) {
+    std::vector<double>& block_sum = block_sum_[macro];
+    block_sum[0] += prob_down;
+    block_sum[1] += prob_up;
+    if (std::fmod(num_trials_[macro], compact_block_size_) < 0.1) {
+      for (int state_change = 0; state_change < 2; ++state_change) {
+        blocks_[macro][state_change].push_back(
+          block_sum[state_change]/static_cast<double>(compact_block_size_));
+        block_sum[state_change] = 0.;
+      }
+    }
+  }
+}
+
 void CollectionMatrix::serialize(std::ostream& ostr) const {
-  feasst_serialize_version(2468, ostr);
+  feasst_serialize_version(2469, ostr);
   feasst_serialize(delta_ln_prob_guess_, ostr);
   feasst_serialize(visits_per_delta_ln_prob_boost_, ostr);
   feasst_serialize(exp_for_boost_, ostr);
   feasst_serialize_fstobj(matrix_, ostr);
+  feasst_serialize(compact_, ostr);
+  feasst_serialize(compact_block_size_, ostr);
+  feasst_serialize(num_trials_, ostr);
+  feasst_serialize(sum_, ostr);
+  feasst_serialize(block_sum_, ostr);
+  feasst_serialize(blocks_, ostr);
 }
 
 CollectionMatrix::CollectionMatrix(std::istream& istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(version == 2468, "unrecognized verison: " << version);
+  ASSERT(version >= 2468 && version <= 2469, "unrecognized verison: " << version);
   feasst_deserialize(&delta_ln_prob_guess_, istr);
   feasst_deserialize(&visits_per_delta_ln_prob_boost_, istr);
   feasst_deserialize(&exp_for_boost_, istr);
   feasst_deserialize_fstobj(&matrix_, istr);
+  compact_ = false;
+  compact_block_size_ = -1;
+  if (version >= 2469) {
+    feasst_deserialize(&compact_, istr);
+    feasst_deserialize(&compact_block_size_, istr);
+    feasst_deserialize(&num_trials_, istr);
+    feasst_deserialize(&sum_, istr);
+    feasst_deserialize(&block_sum_, istr);
+    feasst_deserialize(&blocks_, istr);
+  }
 }
 
 bool CollectionMatrix::is_equal(
     const CollectionMatrix& colmat,
     const double tolerance) const {
+  if (compact_ != colmat.compact_) {
+    return false;
+  }
+  if (compact_) {
+    if (num_trials_.size() != colmat.num_trials_.size()) {
+      return false;
+    }
+    for (int macro = 0; macro < num_macrostates(); ++macro) {
+      if (std::abs(num_trials_[macro] - colmat.num_trials_[macro]) > tolerance) {
+        return false;
+      }
+      for (int col = 0; col < 2; ++col) {
+        if (std::abs(sum_[macro][col] - colmat.sum_[macro][col]) > tolerance) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
   for (int row = 0; row < static_cast<int>(matrix_.size()); ++row) {
     for (int col = 0; col < static_cast<int>(matrix_[row].size()); ++col) {
       if (!matrix_[row][col].is_equal(colmat.matrix_[row][col], tolerance)) {
@@ -194,10 +345,10 @@ std::string CollectionMatrix::write_per_bin(const int bin,
   std::stringstream ss;
   if (widom) {
     ss << MAX_PRECISION << ","
-       << matrix()[bin][0].average() << ","
-       << matrix()[bin][1].average() << ","
-       << matrix()[bin][0].block_stdev() << ","
-       << matrix()[bin][1].block_stdev();
+       << average(bin, 0) << ","
+       << average(bin, 1) << ","
+       << block_stdev(bin, 0) << ","
+       << block_stdev(bin, 1);
   } else {
     std::vector<LnProbability> ln_probs = ln_prob_blocks();
     Accumulator delta_ln_p;
@@ -206,16 +357,25 @@ std::string CollectionMatrix::write_per_bin(const int bin,
       delta_ln_p.accumulate(ln_prob.delta(bin));
     }
     ss << delta_ln_p.stdev_of_av() << ",";
-    ss << MAX_PRECISION << matrix()[bin][0].average() << ","
-       << matrix()[bin][1].average() << ","
-       << matrix()[bin][0].moment(0) << ","
-       << matrix()[bin][0].block_stdev() << ","
-       << matrix()[bin][1].block_stdev();
+    ss << MAX_PRECISION << average(bin, 0) << ","
+       << average(bin, 1) << ","
+       << num_trials(bin) << ","
+       << block_stdev(bin, 0) << ","
+       << block_stdev(bin, 1);
   }
   return ss.str();
 }
 
 void CollectionMatrix::resize(const int num_macrostates) {
+  if (compact_) {
+    num_trials_.assign(num_macrostates, 0.);
+    sum_.assign(num_macrostates, std::vector<double>(2, 0.));
+    if (compact_block_size_ > 0) {
+      block_sum_.assign(num_macrostates, std::vector<double>(2, 0.));
+      blocks_.assign(num_macrostates, std::vector<std::vector<double> >(2));
+    }
+    return;
+  }
   feasst::resize(num_macrostates, 2, &matrix_);
   for (auto& mat1 : matrix_) {
     for (auto& mat2 : mat1) {
@@ -225,12 +385,69 @@ void CollectionMatrix::resize(const int num_macrostates) {
 }
 
 void CollectionMatrix::set(const int macro, const std::vector<Accumulator>& values) {
+  ASSERT(!compact_, "not available for a compact CollectionMatrix");
   matrix_[macro] = values;
 }
 
+void CollectionMatrix::set(const int macro, const CollectionMatrix& colmat) {
+  set(macro, colmat, macro);
+}
+
+void CollectionMatrix::set(const int macro, const CollectionMatrix& colmat,
+                           const int colmat_macro) {
+  ASSERT(compact_ == colmat.compact_, "cannot set a compact CollectionMatrix "
+    << "from one that is not compact, or vice versa");
+  if (compact_) {
+    num_trials_[macro] = colmat.num_trials_[colmat_macro];
+    sum_[macro] = colmat.sum_[colmat_macro];
+    if (compact_block_size_ > 0) {
+      ASSERT(compact_block_size_ == colmat.compact_block_size_,
+        "compact_block_size: " << compact_block_size_ << " != "
+        << colmat.compact_block_size_);
+      block_sum_[macro] = colmat.block_sum_[colmat_macro];
+      blocks_[macro] = colmat.blocks_[colmat_macro];
+    }
+  } else {
+    matrix_[macro] = colmat.matrix_[colmat_macro];
+  }
+}
+
+CollectionMatrix CollectionMatrix::rows(const int first, const int last) const {
+  ASSERT(first >= 0 && first <= last && last < num_macrostates(),
+    "first: " << first << " last: " << last << " num_macrostates: "
+    << num_macrostates());
+  CollectionMatrix colmat;
+  colmat.delta_ln_prob_guess_ = delta_ln_prob_guess_;
+  colmat.visits_per_delta_ln_prob_boost_ = visits_per_delta_ln_prob_boost_;
+  colmat.exp_for_boost_ = exp_for_boost_;
+  colmat.compact_ = compact_;
+  colmat.compact_block_size_ = compact_block_size_;
+  colmat.resize(last - first + 1);
+  for (int macro = first; macro <= last; ++macro) {
+    colmat.set(macro - first, *this, macro);
+    // the blocks of an Accumulator are shared by a copy.
+    if (!compact_) {
+      for (Accumulator& acc : colmat.matrix_[macro - first]) {
+        acc = deep_copy(acc);
+      }
+    }
+  }
+  return colmat;
+}
+
 int CollectionMatrix::min_blocks() const {
   bool found = false;
   int min = 1e9;
+  if (compact_) {
+    // a macrostate without blocks has no block ln_prob.
+    for (int macro = 0; macro < num_macrostates(); ++macro) {
+      const int num = num_blocks(macro);
+      if (num < min) {
+        min = num;
+        found = true;
+      }
+    }
+  }
   for (const auto& mat1 : matrix_) {
     for (const auto& mat2 : mat1) {
       if (mat2.block_size().size() > 0) {
@@ -255,7 +472,7 @@ int CollectionMatrix::min_blocks() const {
 std::vector<LnProbability> CollectionMatrix::ln_prob_blocks() const {
   std::vector<LnProbability> ln_probs;
   LnProbability lnpi;
-  lnpi.resize(matrix().size());
+  lnpi.resize(num_macrostates());
   for (int block = 0; block < min_blocks(); ++block) {
     compute_ln_prob(&lnpi, block);
     ln_probs.push_back(lnpi);
@@ -264,6 +481,7 @@ std::vector<LnProbability> CollectionMatrix::ln_prob_blocks() const {
 }
 
 const std::vector<std::vector<Accumulator> >& CollectionMatrix::matrix() const {
+  ASSERT(!compact_, "not available for a compact CollectionMatrix");
   return matrix_;
 }
 
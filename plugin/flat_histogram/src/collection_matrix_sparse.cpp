@@ -0,0 +1,212 @@
+#include <cmath>
+#include <algorithm>
+#include "utils/include/arguments.h"
+#include "utils/include/serialize.h"
+#include "utils/include/io.h"
+#include "utils/include/debug.h"
+#include "flat_histogram/include/ln_probability.h"
+#include "flat_histogram/include/collection_matrix_sparse.h"
+
+namespace feasst {
+
+CollectionMatrixSparse::CollectionMatrixSparse(argtype * args) {
+  max_iterations_ = integer("max_iterations", args, 1e4);
+  tolerance_ = dble("tolerance", args, 1e-8);
+}
+CollectionMatrixSparse::CollectionMatrixSparse(argtype args)
+  : CollectionMatrixSparse(&args) {
+  feasst_check_all_used(args);
+}
+
+void CollectionMatrixSparse::resize(const int num_macrostates) {
+  num_trials_.assign(num_macrostates, 0.);
+  to_.assign(num_macrostates, std::vector<int>());
+  sum_.assign(num_macrostates, std::vector<double>());
+}
+
+void CollectionMatrixSparse::add_trial(const int macro_old,
+    const int macro_new, const double prob) {
+  ASSERT(macro_old < num_macrostates() && macro_new < num_macrostates(),
+    "macro_old: " << macro_old << " macro_new: " << macro_new << " size: "
+    << num_macrostates());
+  num_trials_[macro_old] += 1.;
+  if (macro_old == macro_new || prob <= 0.) {
+    return;
+  }
+  std::vector<int>& to = to_[macro_old];
+  // the few transitions of each macrostate are found by linear search.
+  for (int index = 0; index < static_cast<int>(to.size()); ++index) {
+    if (to[index] == macro_new) {
+      sum_[macro_old][index] += prob;
+      return;
+    }
+  }
+  to.push_back(macro_new);
+  sum_[macro_old].push_back(prob);
+}
+
+double CollectionMatrixSparse::probability(const int macro_old,
+    const int macro_new) const {
+  if (num_trials_[macro_old] == 0.) {
+    return 0.;
+  }
+  const std::vector<int>& to = to_[macro_old];
+  for (int index = 0; index < static_cast<int>(to.size()); ++index) {
+    if (to[index] == macro_new) {
+      return sum_[macro_old][index]/num_trials_[macro_old];
+    }
+  }
+  return 0.;
+}
+
+int CollectionMatrixSparse::num_nonzero() const {
+  int num = 0;
+  for (const std::vector<int>& to : to_) {
+    num += static_cast<int>(to.size());
+  }
+  return num;
+}
+
+std::vector<bool> CollectionMatrixSparse::reachable() const {
+  std::vector<bool> reach(num_macrostates(), false);
+  for (int macro = 0; macro < num_macrostates(); ++macro) {
+    if (num_trials_[macro] > 0) {
+      reach[macro] = true;
+    }
+    for (const int macro_new : to_[macro]) {
+      reach[macro_new] = true;
+    }
+  }
+  return reach;
+}
+
+int CollectionMatrixSparse::compute_ln_prob(LnProbability * ln_prob) const {
+  const int num = num_macrostates();
+  ASSERT(ln_prob->size() == num, "ln_prob size: " << ln_prob->size() <<
+    " != " << num);
+  // transpose the transitions to obtain the probability flux into each
+  // macrostate, and compute the ln of the probability to leave.
+  std::vector<std::vector<int> > from(num);
+  std::vector<std::vector<double> > ln_prob_from(num);
+  std::vector<double> ln_leave(num, 0.);
+  for (int macro = 0; macro < num; ++macro) {
+    if (num_trials_[macro] > 0) {
+      double leave = 0.;
+      for (int index = 0; index < static_cast<int>(to_[macro].size());
+           ++index) {
+        const double prob = sum_[macro][index]/num_trials_[macro];
+        leave += prob;
+        from[to_[macro][index]].push_back(macro);
+        ln_prob_from[to_[macro][index]].push_back(std::log(prob));
+      }
+      if (leave > 0.) {
+        ln_leave[macro] = std::log(leave);
+      }
+    }
+  }
+  std::vector<double> values = ln_prob->values();
+  int iteration = 0;
+  double max_change = 2.*tolerance_ + 1.;
+  while (max_change > tolerance_ && iteration < max_iterations_) {
+    max_change = 0.;
+    for (int macro = 0; macro < num; ++macro) {
+      const std::vector<int>& fr = from[macro];
+      const int num_from = static_cast<int>(fr.size());
+      if (num_from > 0) {
+        // ln of sum of exp, shifted by the maximum to avoid overflow.
+        double max = values[fr[0]] + ln_prob_from[macro][0];
+        for (int index = 1; index < num_from; ++index) {
+          max = std::max(max, values[fr[index]] + ln_prob_from[macro][index]);
+        }
+        double sum = 0.;
+        for (int index = 0; index < num_from; ++index) {
+          sum += std::exp(values[fr[index]] + ln_prob_from[macro][index] - max);
+        }
+        const double value = max + std::log(sum) - ln_leave[macro];
+        max_change = std::max(max_change, std::abs(value - values[macro]));
+        values[macro] = value;
+      }
+    }
+    // normalize to keep the values bounded.
+    const double shift = *std::max_element(values.begin(), values.end());
+    for (double& value : values) {
+      value -= shift;
+    }
+    ++iteration;
+  }
+  DEBUG("iterations " << iteration << " max_change " << max_change);
+  // macrostates without flux are given the lowest value, which encourages
+  // their sampling.
+  double min = 0.;
+  bool found = false;
+  for (int macro = 0; macro < num; ++macro) {
+    if (from[macro].size() > 0 && (!found || values[macro] < min)) {
+      min = values[macro];
+      found = true;
+    }
+  }
+  if (found) {
+    for (int macro = 0; macro < num; ++macro) {
+      if (from[macro].size() == 0) {
+        values[macro] = min;
+      }
+    }
+  }
+  *ln_prob = LnProbability(values);
+  ln_prob->normalize();
+  return iteration;
+}
+
+std::string CollectionMatrixSparse::write_per_bin_header() const {
+  return std::string("n_trials,n_transitions");
+}
+
+std::string CollectionMatrixSparse::write_per_bin(const int bin) const {
+  std::stringstream ss;
+  ss << num_trials_[bin] << "," << num_transitions(bin);
+  return ss.str();
+}
+
+bool CollectionMatrixSparse::is_equal(const CollectionMatrixSparse& colmat,
+    const double tolerance) const {
+  if (num_macrostates() != colmat.num_macrostates()) {
+    return false;
+  }
+  for (int macro = 0; macro < num_macrostates(); ++macro) {
+    if (std::abs(num_trials_[macro] - colmat.num_trials_[macro]) > tolerance) {
+      return false;
+    }
+    if (to_[macro] != colmat.to_[macro]) {
+      return false;
+    }
+    for (int index = 0; index < static_cast<int>(sum_[macro].size());
+         ++index) {
+      if (std::abs(sum_[macro][index] - colmat.sum_[macro][index]) >
+          tolerance) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void CollectionMatrixSparse::serialize(std::ostream& ostr) const {
+  feasst_serialize_version(7219, ostr);
+  feasst_serialize(max_iterations_, ostr);
+  feasst_serialize(tolerance_, ostr);
+  feasst_serialize(num_trials_, ostr);
+  feasst_serialize(to_, ostr);
+  feasst_serialize(sum_, ostr);
+}
+
+CollectionMatrixSparse::CollectionMatrixSparse(std::istream& istr) {
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(version == 7219, "unrecognized version: " << version);
+  feasst_deserialize(&max_iterations_, istr);
+  feasst_deserialize(&tolerance_, istr);
+  feasst_deserialize(&num_trials_, istr);
+  feasst_deserialize(&to_, istr);
+  feasst_deserialize(&sum_, istr);
+}
+
+}  // namespace feasst
@@ -8,6 +8,9 @@
 //#endif
 #include <thread>         // std::this_thread::sleep_for
 #include <chrono>         // std::chrono::seconds
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <fstream>
 #include "utils/include/arguments.h"
 #include "utils/include/debug.h"
@@ -33,6 +36,7 @@ CollectionMatrixSplice::CollectionMatrixSplice(argtype * args) {
   ln_prob_file_append_ = boolean("ln_prob_file_append", args, false);
   num_adjust_per_write_ = integer("num_adjust_per_write", args, 1);
   bounds_file_ = str("bounds_file", args, "");
+  asynchronous_ = boolean("asynchronous", args, false);
 }
 CollectionMatrixSplice::CollectionMatrixSplice(argtype args) :
   CollectionMatrixSplice(&args) {
@@ -58,7 +62,7 @@ const FlatHistogram& CollectionMatrixSplice::flat_histogram(const int index) con
 }
 
 void CollectionMatrixSplice::serialize(std::ostream& ostr) const {
-  feasst_serialize_version(2974, ostr);
+  feasst_serialize_version(2975, ostr);
   feasst_serialize(clones_, ostr);
   feasst_serialize(min_window_size_, ostr);
   feasst_serialize(hours_per_, ostr);
@@ -68,12 +72,13 @@ void CollectionMatrixSplice::serialize(std::ostream& ostr) const {
   feasst_serialize(num_adjust_since_write_, ostr);
   feasst_serialize(bounds_file_, ostr);
   feasst_serialize(checkpoint_, ostr);
+  feasst_serialize(asynchronous_, ostr);
   feasst_serialize_endcap("CollectionMatrixSplice", ostr);
 }
 
 CollectionMatrixSplice::CollectionMatrixSplice(std::istream& istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(version == 2974, "version: " << version);
+  ASSERT(version >= 2974 && version <= 2975, "version: " << version);
   // HWH for unknown reasons, this does not work
   //feasst_deserialize(&clones_, istr);
   int dim1;
@@ -101,6 +106,10 @@ CollectionMatrixSplice::CollectionMatrixSplice(std::istream& istr) {
       checkpoint_ = std::make_shared<Checkpoint>(istr);
     }
   }
+  asynchronous_ = false;
+  if (version >= 2975) {
+    feasst_deserialize(&asynchronous_, istr);
+  }
   feasst_deserialize_endcap("CollectionMatrixSplice", istr);
 }
 
@@ -134,6 +143,13 @@ void CollectionMatrixSplice::run(const double hours) {
 }
 
 void CollectionMatrixSplice::write(const std::string& file_name) const {
+  if (!file_name.empty()) {
+    write_ln_prob_(file_name, collection_matrix());
+  }
+}
+
+void CollectionMatrixSplice::write_ln_prob_(const std::string& file_name,
+    const CollectionMatrix& cm) const {
   if (!file_name.empty()) {
     std::ofstream file;
     if (ln_prob_file_append_) {
@@ -144,9 +160,9 @@ void CollectionMatrixSplice::write(const std::string& file_name) const {
     }
     if (file.good()) {
       auto tm = MakeTransitionMatrix({{"min_sweeps", "0"}});
-      tm->set_cm(collection_matrix());
+      tm->set_cm(cm);
       file << "state," << tm->write_per_bin_header("") << std::endl;
-      for (int bin = 0; bin < static_cast<int>(tm->cm().matrix().size()); ++bin) {
+      for (int bin = 0; bin < tm->cm().num_macrostates(); ++bin) {
         file << bin << "," << tm->write_per_bin(bin) << std::endl;
       }
     }
@@ -155,6 +171,10 @@ void CollectionMatrixSplice::write(const std::string& file_name) const {
 
 void CollectionMatrixSplice::run_until_all_are_complete() {
   write_bounds(true);
+  if (asynchronous_ && num() > 1) {
+    run_until_all_are_complete_asynchronous_();
+    return;
+  }
   #ifdef _OPENMP
   #pragma omp parallel
   {
@@ -188,14 +208,220 @@ void CollectionMatrixSplice::run_until_all_are_complete() {
   #endif // _OPENMP
 }
 
+// The state of a window published to the coordinator at its safe point.
+struct WindowSnapshot_ {
+  int64_t version = 0;
+  int soft_min = 0;
+  int soft_max = 0;
+  int num_cycles = 0;
+  bool complete = false;
+  int first_bin = 0;
+  int last_bin = 0;
+  // a deep copy of only the rows from first_bin to last_bin
+  std::shared_ptr<const CollectionMatrix> cm;
+};
+
+// Return the snapshot of the clone with the rows of the CollectionMatrix that
+// the given window contributes to the splice.
+static std::shared_ptr<const WindowSnapshot_> snapshot_(const MonteCarlo& clone,
+    const bool first, const bool last, const int64_t version) {
+  auto snap = std::make_shared<WindowSnapshot_>();
+  const FlatHistogram& fh = clone.criteria().flat_histogram();
+  const Macrostate& macro = fh.macrostate();
+  snap->version = version;
+  snap->soft_min = macro.soft_min();
+  snap->soft_max = macro.soft_max();
+  snap->num_cycles = fh.num_cycles();
+  snap->complete = fh.is_complete();
+  snap->first_bin = 0;
+  if (!first) snap->first_bin = snap->soft_min;
+  snap->last_bin = snap->soft_max;
+  if (last) snap->last_bin = static_cast<int>(macro.histogram().size()) - 1;
+  snap->cm = std::make_shared<CollectionMatrix>(
+    fh.bias().cm().rows(snap->first_bin, snap->last_bin));
+  return snap;
+}
+
+void CollectionMatrixSplice::run_until_all_are_complete_asynchronous_() {
+  #ifdef _OPENMP
+  const int num_windows = num();
+  ASSERT(omp_get_max_threads() >= num_windows, "asked for " << num_windows <<
+    " windows but there are only " << omp_get_max_threads() << " OMP threads");
+  std::vector<std::shared_ptr<const WindowSnapshot_> > slots(num_windows);
+  std::atomic<int64_t> next_version(0);
+  std::atomic<bool> done(false);
+
+  // pair p is composed of windows p and p + 1.
+  // The state of a pair is 0 if no adjustment is requested, 1 if requested,
+  // and 2 if one of the windows is waiting for the other.
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<int> pair_state(num_windows - 1, 0);
+  bool all_min_size = false;
+  bool pause = false;
+  int num_paused = 0;
+
+  // only accessed by the coordinator
+  std::mutex coordinator_mutex;
+  std::vector<int64_t> last_versions(num_windows, 0);
+  int parity = 0;
+  bool was_paused = false;
+
+  auto publish = [&](const int window) {
+    std::atomic_store(&slots[window], snapshot_(*clones_[window],
+      window == 0, window == num_windows - 1, ++next_version));
+  };
+
+  // Splice the snapshots without stopping the windows.
+  auto coordinate = [&]() {
+    std::vector<std::shared_ptr<const WindowSnapshot_> > snaps(num_windows);
+    for (int window = 0; window < num_windows; ++window) {
+      snaps[window] = std::atomic_load(&slots[window]);
+      if (!snaps[window] || snaps[window]->version <= last_versions[window]) {
+        return;
+      }
+    }
+    // The snapshots of a pair are published one after the other.
+    // Wait for the next round if the bounds are not yet consistent.
+    for (int window = 1; window < num_windows; ++window) {
+      if (snaps[window]->soft_min != snaps[window - 1]->soft_max + 1) {
+        return;
+      }
+    }
+    bool all_complete = true;
+    std::vector<int> soft_min(num_windows);
+    for (int window = 0; window < num_windows; ++window) {
+      last_versions[window] = snaps[window]->version;
+      soft_min[window] = snaps[window]->soft_min;
+      if (!snaps[window]->complete) all_complete = false;
+    }
+    ++num_adjust_since_write_;
+    if (num_adjust_since_write_ >= num_adjust_per_write_ || all_complete) {
+      CollectionMatrix cm(*snaps[0]->cm);
+      cm.resize(snaps.back()->last_bin + 1);
+      for (const std::shared_ptr<const WindowSnapshot_>& snap : snaps) {
+        for (int bin = snap->first_bin; bin <= snap->last_bin; ++bin) {
+          cm.set(bin, *snap->cm, bin - snap->first_bin);
+        }
+      }
+      write_ln_prob_(ln_prob_file_, cm);
+      num_adjust_since_write_ = 0;
+    }
+    write_bounds_(soft_min, snaps.back()->soft_max);
+    std::lock_guard<std::mutex> lock(mutex);
+    // an adjustment in progress may change the completion of its windows.
+    for (const int state : pair_state) {
+      if (state != 0) return;
+    }
+    if (pause) return;
+    if (all_complete) {
+      done = true;
+      condition.notify_all();
+      return;
+    }
+    // alternate with adjustments, if the Checkpoint is due every round.
+    if (!was_paused && checkpoint_ && checkpoint_->is_due()) {
+      pause = true;
+      was_paused = true;
+      return;
+    }
+    was_paused = false;
+    if (min_window_size_ <= 0) return;
+    all_min_size = true;
+    for (const std::shared_ptr<const WindowSnapshot_>& snap : snaps) {
+      if (!snap->complete &&
+          snap->soft_max - snap->soft_min + 1 > min_window_size_) {
+        all_min_size = false;
+      }
+    }
+    for (int pair = parity; pair < num_windows - 1; pair += 2) {
+      if (snaps[pair]->num_cycles != snaps[pair + 1]->num_cycles) {
+        pair_state[pair] = 1;
+      }
+    }
+    parity = 1 - parity;
+  };
+
+  // Adopt any requested adjustments or pause for the Checkpoint.
+  auto safe_point = [&](const int window) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (int pair = std::max(0, window - 1);
+         pair <= std::min(window, num_windows - 2); ++pair) {
+      if (pair_state[pair] == 1) {
+        pair_state[pair] = 2;
+        condition.wait(lock, [&]{ return pair_state[pair] != 2 || done; });
+      } else if (pair_state[pair] == 2) {
+        clones_[pair]->adjust_bounds(pair == 0, pair == num_windows - 2,
+          false, false, all_min_size, min_window_size_,
+          clones_[pair + 1].get());
+        publish(pair);
+        publish(pair + 1);
+        pair_state[pair] = 0;
+        condition.notify_all();
+      }
+    }
+    if (pause) {
+      ++num_paused;
+      if (num_paused == num_windows) {
+        // all windows are stopped, but the coordinator may not be.
+        lock.unlock();
+        {
+          std::lock_guard<std::mutex> coordinator_lock(coordinator_mutex);
+          checkpoint_->check(*this);
+        }
+        lock.lock();
+        pause = false;
+        num_paused = 0;
+        condition.notify_all();
+      } else {
+        condition.wait(lock, [&]{ return !pause || done; });
+      }
+    }
+  };
+
+  #pragma omp parallel
+  {
+    const int thread = omp_get_thread_num();
+    const bool is_coordinator_thread = omp_get_num_threads() > num_windows;
+    if (thread < num_windows) {
+      while (!done) {
+        MakeRun({{"for_hours", str(hours_per_)}})->run(clones_[thread].get());
+        publish(thread);
+        if (!is_coordinator_thread && coordinator_mutex.try_lock()) {
+          coordinate();
+          coordinator_mutex.unlock();
+        }
+        safe_point(thread);
+      }
+    } else if (thread == num_windows) {
+      while (!done) {
+        {
+          std::lock_guard<std::mutex> lock(coordinator_mutex);
+          coordinate();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    #pragma omp barrier
+    if (thread == 0) {
+      write(ln_prob_file_);
+    }
+    if (thread < num_windows) {
+      clones_[thread]->write_to_file();
+    }
+  }
+  #else // _OPENMP
+    FATAL("OMP required for CollectionMatrixSplice::run_until_all_are_complete()");
+  #endif // _OPENMP
+}
+
 const CollectionMatrix& CollectionMatrixSplice::collection_matrix(
     const int index) const {
   return flat_histogram(index).bias().cm();
 }
 
 CollectionMatrix CollectionMatrixSplice::collection_matrix() const {
-  const CollectionMatrix& cm = collection_matrix(0);
-  std::vector<std::vector<Accumulator> > data = cm.matrix();
+  CollectionMatrix cm = collection_matrix(0);
   const FlatHistogram& fh0 = flat_histogram(0);
   int last_max = fh0.macrostate().soft_max();
   for (int cli = 1; cli < num(); ++cli) {
@@ -210,16 +436,16 @@ CollectionMatrix CollectionMatrixSplice::collection_matrix() const {
     }
     const CollectionMatrix& cmi = collection_matrix(cli);
     for (int bin = fh.macrostate().soft_min(); bin <= max_bin; ++bin) {
-      data[bin] = cmi.matrix()[bin];
+      cm.set(bin, cmi);
     }
   }
-  return CollectionMatrix(data);
+  return cm;
 }
 
 LnProbability CollectionMatrixSplice::ln_prob() const {
   CollectionMatrix cm = collection_matrix();
   LnProbability ln_prob;
-  ln_prob.resize(cm.matrix().size());
+  ln_prob.resize(cm.num_macrostates());
   cm.compute_ln_prob(&ln_prob);
   return ln_prob;
 }
@@ -282,19 +508,29 @@ void CollectionMatrixSplice::write_bounds(const bool header) {
       }
       file << "max" << num() - 1 << ",cpuhours" << std::endl;
     } else {
-      std::ofstream file(bounds_file_, std::ofstream::out | std::ofstream::app);
+      std::vector<int> soft_min(num());
       for (int icl = 0; icl < num(); ++icl) {
-        file << clones_[icl]->criteria().macrostate().soft_min() << ",";
-        if (icl == num() - 1) {
-          file << clones_[icl]->criteria().macrostate().soft_max() << ",";
-        } else {
+        soft_min[icl] = clones_[icl]->criteria().macrostate().soft_min();
+        if (icl < num() - 1) {
           ASSERT(clones_[icl]->criteria().macrostate().soft_max() + 1 ==
                clones_[1+icl]->criteria().macrostate().soft_min(),
                "error");
         }
       }
-      file << cpu_hours() << std::endl;
+      write_bounds_(soft_min,
+                    clones_.back()->criteria().macrostate().soft_max());
+    }
+  }
+}
+
+void CollectionMatrixSplice::write_bounds_(const std::vector<int>& soft_min,
+    const int last_soft_max) {
+  if (!bounds_file_.empty()) {
+    std::ofstream file(bounds_file_, std::ofstream::out | std::ofstream::app);
+    for (const int min : soft_min) {
+      file << min << ",";
     }
+    file << last_soft_max << "," << cpu_hours() << std::endl;
   }
 }
 
@@ -0,0 +1,154 @@
+#include <cmath>
+#include "utils/include/serialize.h"
+#include "utils/include/arguments.h"
+#include "math/include/histogram.h"
+#include "system/include/system.h"
+#include "monte_carlo/include/acceptance.h"
+#include "monte_carlo/include/criteria.h"
+#include "flat_histogram/include/macrostate_energy.h"
+#include "flat_histogram/include/macrostate_product.h"
+
+namespace feasst {
+
+// Remove the arguments beginning with the prefix and return them without it.
+static argtype prefixed_args_(const std::string& prefix, argtype * args) {
+  argtype prefixed;
+  for (auto iter = args->begin(); iter != args->end();) {
+    if (iter->first.substr(0, prefix.size()) == prefix) {
+      prefixed[iter->first.substr(prefix.size())] = iter->second;
+      iter = args->erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  return prefixed;
+}
+
+static std::shared_ptr<Macrostate> parse_macrostate_(const std::string& prefix,
+    const std::string& default_name, argtype * args) {
+  argtype macro_args = prefixed_args_(prefix, args);
+  std::string name = default_name;
+  if (used("Macrostate", macro_args)) {
+    name = str("Macrostate", &macro_args);
+  }
+  std::shared_ptr<Macrostate> macro = MacrostateEnergy().factory(name,
+                                                                 &macro_args);
+  feasst_check_all_used(macro_args);
+  return macro;
+}
+
+// Return the offset of the first Macrostate, as described in the header.
+static int product_offset_(const Macrostate& first) {
+  const Histogram& hist = first.histogram();
+  ASSERT(hist.size() > 0, "the first Macrostate requires a Histogram");
+  const double width = hist.edges()[1] - hist.edges()[0];
+  const double offset = hist.center_of_bin(0)/width;
+  ASSERT(std::abs(offset - std::round(offset)) < 1e-6,
+    "The center of the first bin: " << hist.center_of_bin(0) << " of the "
+    << "first Macrostate must be an integer multiple of its width: " << width);
+  return static_cast<int>(std::round(offset));
+}
+
+static Histogram product_histogram_(const Macrostate& first,
+                                    const Macrostate& second) {
+  const int num_second = second.histogram().size();
+  ASSERT(num_second > 0, "the second Macrostate requires a Histogram");
+  const int min = product_offset_(first)*num_second;
+  const int max = min + first.histogram().size()*num_second - 1;
+  return Histogram({{"width", "1"}, {"min", str(min)}, {"max", str(max)}});
+}
+
+MacrostateProduct::MacrostateProduct(std::shared_ptr<Macrostate> first,
+    std::shared_ptr<Macrostate> second, argtype * args)
+  : Macrostate(product_histogram_(*first, *second), args) {
+  class_name_ = "MacrostateProduct";
+  first_ = first;
+  second_ = second;
+  offset_ = product_offset_(*first_);
+}
+MacrostateProduct::MacrostateProduct(std::shared_ptr<Macrostate> first,
+    std::shared_ptr<Macrostate> second, argtype args)
+  : MacrostateProduct(first, second, &args) {
+  feasst_check_all_used(args);
+}
+MacrostateProduct::MacrostateProduct(argtype * args)
+  : MacrostateProduct(
+      parse_macrostate_("first_", "MacrostateNumParticles", args),
+      parse_macrostate_("second_", "MacrostateEnergy", args),
+      args) {}
+MacrostateProduct::MacrostateProduct(argtype args)
+  : MacrostateProduct(&args) {
+  feasst_check_all_used(args);
+}
+MacrostateProduct::MacrostateProduct() : Macrostate() {
+  class_name_ = "MacrostateProduct";
+}
+MacrostateProduct::~MacrostateProduct() {}
+
+int MacrostateProduct::num_second() const {
+  return second_->histogram().size();
+}
+
+// Return the bin of the macrostate, or -1 if outside of the Histogram.
+static int bin_in_range_(Macrostate * macro, const System& system,
+    const Criteria& criteria, const Acceptance& acceptance) {
+  const double value = macro->value(system, criteria, acceptance);
+  const Histogram& hist = macro->histogram();
+  if (value > hist.max() || value < hist.min()) {
+    return -1;
+  }
+  return hist.bin(value);
+}
+
+double MacrostateProduct::value(const System& system,
+    const Criteria& criteria,
+    const Acceptance& acceptance) {
+  const int first = bin_in_range_(first_.get(), system, criteria, acceptance);
+  if (first == -1) {
+    return histogram().min() - 1.;
+  }
+  const int second = bin_in_range_(second_.get(), system, criteria,
+                                   acceptance);
+  if (second == -1) {
+    return histogram().min() - 1.;
+  }
+  return static_cast<double>((offset_ + first)*num_second() + second);
+}
+
+FEASST_MAPPER(MacrostateProduct,);
+
+std::shared_ptr<Macrostate> MacrostateProduct::create(std::istream& istr) const {
+  return std::make_shared<MacrostateProduct>(istr);
+}
+
+std::shared_ptr<Macrostate> MacrostateProduct::create(argtype * args) const {
+  return std::make_shared<MacrostateProduct>(args);
+}
+
+MacrostateProduct::MacrostateProduct(std::istream& istr) : Macrostate(istr) {
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(version == 3186, "version mismatch: " << version);
+  // HWH for unknown reasons feasst_deserialize_fstdr does not work
+  // (see FlatHistogram)
+  int existing;
+  istr >> existing;
+  if (existing != 0) {
+    first_ = MacrostateEnergy().deserialize(istr);
+  }
+  istr >> existing;
+  if (existing != 0) {
+    second_ = MacrostateEnergy().deserialize(istr);
+  }
+  feasst_deserialize(&offset_, istr);
+}
+
+void MacrostateProduct::serialize(std::ostream& ostr) const {
+  ostr << class_name_ << " ";
+  serialize_macrostate_(ostr);
+  feasst_serialize_version(3186, ostr);
+  feasst_serialize_fstdr(first_, ostr);
+  feasst_serialize_fstdr(second_, ostr);
+  feasst_serialize(offset_, ostr);
+}
+
+}  // namespace feasst
@@ -0,0 +1,224 @@
+#include <cmath>
+#include <algorithm>
+#include "utils/include/arguments.h"
+#include "utils/include/io.h"
+#include "utils/include/debug.h"
+#include "math/include/utils_math.h"
+#include "flat_histogram/include/reweight.h"
+
+namespace feasst {
+
+Reweight::Reweight(const LnProbability& ln_prob,
+    const std::vector<double>& macrostates,
+    argtype args) : Reweight(ln_prob, macrostates, &args) {
+  feasst_check_all_used(args);
+}
+Reweight::Reweight(const LnProbability& ln_prob,
+    const std::vector<double>& macrostates,
+    argtype * args) {
+  ln_prob_ = ln_prob;
+  macrostates_ = macrostates;
+  ASSERT(ln_prob_.size() == static_cast<int>(macrostates_.size()),
+    "the size of ln_prob: " << ln_prob_.size() << " and macrostates: " <<
+    macrostates_.size() << " must be the same");
+  ASSERT(ln_prob_.size() > 1, "ln_prob requires more than one macrostate");
+  num_smooth_ = integer("num_smooth", args, 10);
+  tolerance_ = dble("tolerance", args, 1e-10);
+  max_iterations_ = integer("max_iterations", args, 1e3);
+}
+
+void Reweight::add_data(const std::vector<double>& data) {
+  ASSERT(static_cast<int>(data.size()) == ln_prob_.size(),
+    "the size of data: " << data.size() << " must match ln_prob: " <<
+    ln_prob_.size());
+  data_.push_back(data);
+}
+
+LnProbability Reweight::ln_prob(const double delta_beta_mu) const {
+  std::vector<double> values = ln_prob_.values();
+  for (int macro = 0; macro < ln_prob_.size(); ++macro) {
+    values[macro] += macrostates_[macro]*delta_beta_mu;
+  }
+  LnProbability reweighted(values);
+  reweighted.normalize();
+  return reweighted;
+}
+
+int Reweight::phase_boundary(const LnProbability& ln_prob) const {
+  const std::vector<int> mins = ln_prob.minima(num_smooth_);
+  if (mins.size() == 0) {
+    return -1;
+  }
+  // shallow minima (e.g., from noise) do not separate phases.
+  int deepest = mins[0];
+  for (const int min : mins) {
+    if (ln_prob.value(min) < ln_prob.value(deepest)) {
+      deepest = min;
+    }
+  }
+  return deepest;
+}
+
+// Return the natural logarithm of the sum of the probabilities from min to
+// max, inclusive, without underflow of the exponential.
+static double ln_sum_(const LnProbability& ln_prob, const int min,
+                      const int max) {
+  double shift = ln_prob.value(min);
+  for (int macro = min + 1; macro <= max; ++macro) {
+    shift = std::max(shift, ln_prob.value(macro));
+  }
+  double sum = 0.;
+  for (int macro = min; macro <= max; ++macro) {
+    sum += std::exp(ln_prob.value(macro) - shift);
+  }
+  return std::log(sum) + shift;
+}
+
+std::vector<double> Reweight::averages(const LnProbability& ln_prob,
+    const int min, int max) const {
+  if (max == -1) {
+    max = ln_prob.size() - 1;
+  }
+  ASSERT(min >= 0 && min <= max && max < ln_prob.size(),
+    "invalid min: " << min << " or max: " << max);
+  const double ln_sum = ln_sum_(ln_prob, min, max);
+  std::vector<double> avs(2 + num_data(), 0.);
+  avs[0] = ln_sum - ln_prob.value(0);
+  for (int macro = min; macro <= max; ++macro) {
+    const double prob = std::exp(ln_prob.value(macro) - ln_sum);
+    avs[1] += prob*macrostates_[macro];
+    for (int data = 0; data < num_data(); ++data) {
+      avs[2 + data] += prob*data_[data][macro];
+    }
+  }
+  return avs;
+}
+
+std::vector<std::vector<double> > Reweight::isotherm(
+    const std::vector<double>& delta_beta_mu) const {
+  const int num = static_cast<int>(delta_beta_mu.size());
+  std::vector<std::vector<double> > avs(num);
+  #pragma omp parallel for schedule(dynamic)
+  for (int index = 0; index < num; ++index) {
+    avs[index] = averages(ln_prob(delta_beta_mu[index]));
+  }
+  return avs;
+}
+
+// Return the difference in the ln of the probability of the two phases,
+// which decreases as delta_beta_mu increases.
+double Reweight::phase_difference_(const double delta_beta_mu) const {
+  const LnProbability lnpi = ln_prob(delta_beta_mu);
+  const int boundary = phase_boundary(lnpi);
+  if (boundary == -1) {
+    return lnpi.value(0) - lnpi.value(lnpi.size() - 1);
+  }
+  return ln_sum_(lnpi, 0, boundary - 1) -
+         ln_sum_(lnpi, boundary, lnpi.size() - 1);
+}
+
+double Reweight::equilibrium(const double delta_beta_mu_guess) const {
+  // bracket the root by stepping in the direction of the sign change, with
+  // a step size that doubles each iteration.
+  double lower = delta_beta_mu_guess, upper = delta_beta_mu_guess;
+  double step = 0.1;
+  int iteration = 0;
+  if (phase_difference_(delta_beta_mu_guess) > 0) {
+    do {
+      lower = upper;
+      upper += step;
+      step *= 2.;
+      ASSERT(++iteration < max_iterations_, "could not bracket equilibrium");
+    } while (phase_difference_(upper) > 0);
+  } else {
+    do {
+      upper = lower;
+      lower -= step;
+      step *= 2.;
+      ASSERT(++iteration < max_iterations_, "could not bracket equilibrium");
+    } while (phase_difference_(lower) <= 0);
+  }
+  DEBUG("bracket " << lower << " " << upper);
+
+  // bisect the bracket
+  while (upper - lower > tolerance_) {
+    const double middle = 0.5*(lower + upper);
+    if (phase_difference_(middle) > 0) {
+      lower = middle;
+    } else {
+      upper = middle;
+    }
+    ASSERT(++iteration < max_iterations_, "could not find equilibrium");
+  }
+  return 0.5*(lower + upper);
+}
+
+std::vector<double> Reweight::saturation(
+    const double delta_beta_mu_guess) const {
+  std::vector<double> sat;
+  const double delta_beta_mu = equilibrium(delta_beta_mu_guess);
+  const LnProbability lnpi = ln_prob(delta_beta_mu);
+  const int boundary = phase_boundary(lnpi);
+  if (boundary != -1) {
+    sat.push_back(delta_beta_mu);
+    for (double av : averages(lnpi, 0, boundary - 1)) {
+      sat.push_back(av);
+    }
+    for (double av : averages(lnpi, boundary, lnpi.size() - 1)) {
+      sat.push_back(av);
+    }
+  }
+  return sat;
+}
+
+std::vector<std::vector<double> > saturation(
+    const std::vector<Reweight>& reweights,
+    const double delta_beta_mu_guess) {
+  const int num = static_cast<int>(reweights.size());
+  std::vector<std::vector<double> > sats(num);
+  #pragma omp parallel for schedule(dynamic)
+  for (int index = 0; index < num; ++index) {
+    sats[index] = reweights[index].saturation(delta_beta_mu_guess);
+  }
+  return sats;
+}
+
+// Return the intercept and slope of the least squares fit of y to x.
+static std::vector<double> linear_fit_(const std::vector<double>& x,
+                                       const std::vector<double>& y) {
+  const int num = static_cast<int>(x.size());
+  const double x_av = average(x), y_av = average(y);
+  double sxy = 0., sxx = 0.;
+  for (int index = 0; index < num; ++index) {
+    sxy += (x[index] - x_av)*(y[index] - y_av);
+    sxx += (x[index] - x_av)*(x[index] - x_av);
+  }
+  ASSERT(sxx > 0, "requires at least two unique x");
+  const double slope = sxy/sxx;
+  return {y_av - slope*x_av, slope};
+}
+
+std::vector<double> critical_point(
+    const std::vector<double>& temperature,
+    const std::vector<double>& vapor,
+    const std::vector<double>& liquid,
+    const double exponent) {
+  const int num = static_cast<int>(temperature.size());
+  ASSERT(num >= 2, "requires at least two temperatures");
+  ASSERT(num == static_cast<int>(vapor.size()) &&
+         num == static_cast<int>(liquid.size()), "size mismatch");
+  std::vector<double> order(num), diameter(num);
+  for (int index = 0; index < num; ++index) {
+    ASSERT(liquid[index] > vapor[index], "the liquid: " << liquid[index]
+      << " must be more dense than the vapor: " << vapor[index]);
+    order[index] = std::pow(liquid[index] - vapor[index], 1./exponent);
+    diameter[index] = 0.5*(liquid[index] + vapor[index]);
+  }
+  const std::vector<double> order_fit = linear_fit_(temperature, order);
+  const double critical_temperature = -order_fit[0]/order_fit[1];
+  const std::vector<double> diameter_fit = linear_fit_(temperature, diameter);
+  return {critical_temperature,
+          diameter_fit[0] + diameter_fit[1]*critical_temperature};
+}
+
+}  // namespace feasst
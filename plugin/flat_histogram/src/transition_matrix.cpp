@@ -67,25 +67,19 @@ void TransitionMatrix::update(
   DEBUG("macrostate_old " << macrostate_old << " index " << index);
   DEBUG("metropolis_prob " << metropolis_prob);
   if (index == 0) {
-    collection_->increment(macrostate_old, 0, metropolis_prob);
-    collection_->increment(macrostate_old, 1, 0.);
+    collection_->add_trial(macrostate_old, metropolis_prob, 0.);
     if (widom_) {
-      collection_widom_->increment(macrostate_old, 0, metropolis_prob_widom);
-      collection_widom_->increment(macrostate_old, 1, 0.);
+      collection_widom_->add_trial(macrostate_old, metropolis_prob_widom, 0.);
     }
   } else if (index == 1) {
-    collection_->increment(macrostate_old, 0, 0.);
-    collection_->increment(macrostate_old, 1, 0.);
+    collection_->add_trial(macrostate_old, 0., 0.);
     if (widom_) {
-      collection_widom_->increment(macrostate_old, 0, 0.);
-      collection_widom_->increment(macrostate_old, 1, 0.);
+      collection_widom_->add_trial(macrostate_old, 0., 0.);
     }
   } else if (index == 2) {
-    collection_->increment(macrostate_old, 0, 0.);
-    collection_->increment(macrostate_old, 1, metropolis_prob);
+    collection_->add_trial(macrostate_old, 0., metropolis_prob);
     if (widom_) {
-      collection_widom_->increment(macrostate_old, 0, 0.);
-      collection_widom_->increment(macrostate_old, 1, metropolis_prob_widom);
+      collection_widom_->add_trial(macrostate_old, 0., metropolis_prob_widom);
     }
   } else {
     FATAL("unrecognized index: " << index);
@@ -277,7 +271,7 @@ void TransitionMatrix::set_cycles_to_complete(const int sweeps) {
 
 void TransitionMatrix::set_cm(const int macro, const Bias& bias) {
   ASSERT(!widom_, "not implemented with widom argument.");
-  collection_->set(macro, bias.cm().matrix()[macro]);
+  collection_->set(macro, bias.cm());
   visits_[macro][0] = bias.visits(macro, 0);
   visits_[macro][1] = bias.visits(macro, 1);
 }
@@ -285,7 +279,7 @@ void TransitionMatrix::set_cm(const int macro, const Bias& bias) {
 void TransitionMatrix::set_cm(const CollectionMatrix& cm) {
   ASSERT(!widom_, "not implemented with widom argument.");
   collection_ = std::make_unique<CollectionMatrix>(cm);
-  const int size = collection_->matrix().size();
+  const int size = collection_->num_macrostates();
   ln_prob_->resize(size);
   feasst::resize(size, 2, &visits_);
   collection_->compute_ln_prob(ln_prob_.get());
@@ -0,0 +1,159 @@
+#include <cmath>  // exp
+#include <algorithm>
+#include "utils/include/arguments.h"
+#include "utils/include/serialize.h"
+#include "utils/include/debug.h"
+#include "math/include/histogram.h"
+#include "flat_histogram/include/macrostate.h"
+#include "flat_histogram/include/ln_probability.h"
+#include "flat_histogram/include/collection_matrix_sparse.h"
+#include "flat_histogram/include/transition_matrix_sparse.h"
+
+namespace feasst {
+
+TransitionMatrixSparse::TransitionMatrixSparse(argtype args)
+  : TransitionMatrixSparse(&args) {
+  feasst_check_all_used(args);
+}
+TransitionMatrixSparse::TransitionMatrixSparse(argtype * args) {
+  class_name_ = "TransitionMatrixSparse";
+  min_visits_ = integer("min_visits", args, 100);
+  min_sweeps_ = integer("min_sweeps", args);
+  collection_ = std::make_unique<CollectionMatrixSparse>(args);
+  ln_prob_ = std::make_unique<LnProbability>();
+}
+TransitionMatrixSparse::~TransitionMatrixSparse() {}
+
+void TransitionMatrixSparse::update(
+    const int macrostate_old,
+    const int macrostate_new,
+    const double ln_metropolis_prob,
+    const bool is_accepted,
+    const bool is_endpoint,
+    const Macrostate& macro) {
+  DEBUG("macro old/new " << macrostate_old << " " << macrostate_new);
+  // trials beyond the Histogram are forcibly rejected and remain in the old
+  // macrostate.
+  if (macrostate_new < 0 || macrostate_new >= ln_prob_->size()) {
+    collection_->add_trial(macrostate_old, macrostate_old, 0.);
+    return;
+  }
+  if (is_accepted && (macrostate_old != macrostate_new)) {
+    ++visits_[macrostate_new];
+  }
+  collection_->add_trial(macrostate_old, macrostate_new,
+                         std::min(1., std::exp(ln_metropolis_prob)));
+}
+
+void TransitionMatrixSparse::resize(const Histogram& histogram) {
+  const int size = histogram.size();
+  ln_prob_->resize(size);
+  visits_.assign(size, 0);
+  collection_->resize(size);
+}
+
+std::string TransitionMatrixSparse::write() const {
+  std::stringstream ss;
+  ss << Bias::write();
+  ss << "\"num_sweeps\":" << num_sweeps_ << ",";
+  return ss.str();
+}
+
+std::string TransitionMatrixSparse::write_per_bin_header(
+    const std::string& append) const {
+  std::stringstream ss;
+  ss << Bias::write_per_bin_header(append) << ",";
+  ss << "visits,";
+  ss << collection_->write_per_bin_header();
+  return ss.str();
+}
+
+std::string TransitionMatrixSparse::write_per_bin(const int bin) const {
+  std::stringstream ss;
+  ss << Bias::write_per_bin(bin) << ",";
+  ss << visits_[bin] << ",";
+  ss << collection_->write_per_bin(bin);
+  return ss.str();
+}
+
+void TransitionMatrixSparse::infrequent_update(const Macrostate& macro) {
+  DEBUG("update the macrostate distribution");
+  collection_->compute_ln_prob(ln_prob_.get());
+
+  DEBUG("update the number of sweeps");
+  // Many bins of a multidimensional macrostate may be impossible to reach
+  // (e.g., a nonzero energy without particles), so only bins that were
+  // reached by a trial are required for a sweep.
+  const std::vector<bool> reachable = collection_->reachable();
+  int min_vis = min_visits_;
+  int num_reachable = 0;
+  for (int bin = macro.soft_min(); bin < macro.soft_max() + 1; ++bin) {
+    if (reachable[bin]) {
+      min_vis = std::min(min_vis, visits_[bin]);
+      ++num_reachable;
+    }
+  }
+  if (num_reachable > 0 && min_vis >= min_visits_) {
+    ++num_sweeps_;
+    std::fill(visits_.begin(), visits_.end(), 0);
+  }
+
+  if (num_sweeps_ >= min_sweeps_) {
+    set_complete_();
+  } else {
+    set_incomplete_();
+  }
+}
+
+void TransitionMatrixSparse::set_ln_prob(const LnProbability& ln_prob) {
+  ASSERT(ln_prob.size() == ln_prob_->size(), "size mismatch: " <<
+    ln_prob.size() << " " << ln_prob_->size());
+  ln_prob_ = std::make_unique<LnProbability>(ln_prob);
+}
+
+void TransitionMatrixSparse::set_cycles_to_complete(const int sweeps) {
+  min_sweeps_ = sweeps;
+  if (num_sweeps_ < min_sweeps_) set_incomplete_();
+}
+
+int TransitionMatrixSparse::num_cycles(const int state,
+    const Macrostate& macro) const {
+  return num_sweeps_;
+}
+
+const LnProbability& TransitionMatrixSparse::ln_prob() const {
+  return *ln_prob_;
+}
+
+FEASST_MAPPER(TransitionMatrixSparse, argtype({{"min_sweeps", "0"}}));
+
+std::shared_ptr<Bias> TransitionMatrixSparse::create(std::istream& istr) const {
+  return std::make_shared<TransitionMatrixSparse>(istr);
+}
+
+TransitionMatrixSparse::TransitionMatrixSparse(std::istream& istr)
+  : Bias(istr) {
+  ASSERT(class_name_ == "TransitionMatrixSparse", "name: " << class_name_);
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(version == 4481, "mismatch version: " << version);
+  feasst_deserialize(ln_prob_, istr);
+  feasst_deserialize(collection_, istr);
+  feasst_deserialize(&visits_, istr);
+  feasst_deserialize(&min_visits_, istr);
+  feasst_deserialize(&num_sweeps_, istr);
+  feasst_deserialize(&min_sweeps_, istr);
+}
+
+void TransitionMatrixSparse::serialize(std::ostream& ostr) const {
+  ostr << class_name_ << " ";
+  serialize_bias_(ostr);
+  feasst_serialize_version(4481, ostr);
+  feasst_serialize(ln_prob_, ostr);
+  feasst_serialize(collection_, ostr);
+  feasst_serialize(visits_, ostr);
+  feasst_serialize(min_visits_, ostr);
+  feasst_serialize(num_sweeps_, ostr);
+  feasst_serialize(min_sweeps_, ostr);
+}
+
+}  // namespace feasst
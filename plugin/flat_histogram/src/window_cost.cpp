@@ -0,0 +1,162 @@
+#include <cmath>
+#include <algorithm>
+#include "utils/include/io.h"
+#include "utils/include/debug.h"
+#include "utils/include/arguments.h"
+#include "math/include/constants.h"
+#include "math/include/histogram.h"
+#include "math/include/utils_math.h"
+#include "flat_histogram/include/macrostate.h"
+#include "flat_histogram/include/bias.h"
+#include "flat_histogram/include/collection_matrix.h"
+#include "flat_histogram/include/flat_histogram.h"
+#include "flat_histogram/include/clones.h"
+#include "flat_histogram/include/window_cost.h"
+
+namespace feasst {
+
+// Add the maximum to the arguments, given by the minimum and size of cost.
+static argtype * add_maximum_(const std::vector<double>& cost,
+                              argtype * args) {
+  ASSERT(!used("maximum", *args), "maximum is given by the size of the cost");
+  int minimum = 0;
+  if (used("minimum", *args)) {
+    minimum = str_to_int(args->at("minimum"));
+  }
+  (*args)["maximum"] = str(minimum + static_cast<int>(cost.size()) - 1);
+  return args;
+}
+
+WindowCost::WindowCost(const std::vector<double>& cost, argtype args)
+  : Window(add_maximum_(cost, &args)) {
+  feasst_check_all_used(args);
+  ASSERT(num() > 0, "num: " << num() << " is required");
+  cost_ = cost;
+  cumulative_.resize(cost_.size() + 1, 0.);
+  for (int macro = 0; macro < static_cast<int>(cost_.size()); ++macro) {
+    ASSERT(cost_[macro] > 0, "cost: " << cost_[macro] << " of macrostate: "
+      << macro << " must be positive");
+    cumulative_[macro + 1] = cumulative_[macro] + cost_[macro];
+  }
+
+  // bisect the target wall time such that the last window takes no longer
+  // than the others.
+  double lower = 0., upper = time(minimum(), maximum());
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    const double target = 0.5*(lower + upper);
+    if (plan_(target, &segment_) > target) {
+      lower = target;
+    } else {
+      upper = target;
+    }
+  }
+  plan_(upper, &segment_);
+  DEBUG("segment " << feasst_str(segment_));
+}
+
+double WindowCost::time(const int min, const int max) const {
+  ASSERT(min >= minimum() && max <= maximum() && min <= max,
+    "invalid min: " << min << " or max: " << max);
+  return static_cast<double>(max - min + 1)*(
+    cumulative_[max - minimum() + 1] - cumulative_[min - minimum()]);
+}
+
+std::vector<double> WindowCost::times() const {
+  std::vector<double> tms;
+  for (const std::vector<int>& win : boundaries()) {
+    tms.push_back(time(win[0], win[1]));
+  }
+  return tms;
+}
+
+// Fill the segment given the target wall time of all but the last window,
+// and return the wall time of the last window.
+double WindowCost::plan_(const double target,
+                         std::vector<double> * segment) const {
+  const int smallest = std::max(min_size(), 2*overlap());
+  segment->assign(1, minimum());
+  int start = minimum();
+  for (int window = 0; window < num() - 1; ++window) {
+    // leave enough macrostates for the remaining windows
+    const int last_end = maximum() - (num() - 1 - window)*(smallest - overlap());
+    int end = start + smallest - 1;
+    ASSERT(end <= last_end, "the macrostate range is too small for num: "
+      << num() << " windows of min_size: " << smallest);
+    while (end < last_end && time(start, end + 1) <= target) {
+      ++end;
+    }
+    segment->push_back(end);
+    start = end - overlap() + 1;
+  }
+  segment->push_back(maximum());
+  return time(start, maximum());
+}
+
+// Return the value at x, linearly interpolated between the nodes, or the value
+// of the nearest node if x is outside of the nodes.
+static double interpolate_(const double x, const std::vector<double>& nodes,
+                           const std::vector<double>& values) {
+  if (x <= nodes.front()) return values.front();
+  if (x >= nodes.back()) return values.back();
+  int upper = 1;
+  while (nodes[upper] < x) ++upper;
+  const double frac = (x - nodes[upper - 1])/(nodes[upper] - nodes[upper - 1]);
+  return values[upper - 1] + frac*(values[upper] - values[upper - 1]);
+}
+
+std::vector<double> window_cost(const Clones& clones) {
+  ASSERT(clones.num() > 0, "no clones");
+  const int minimum = round(clones.clone(0).criteria().flat_histogram()
+    .macrostate().histogram().center_of_bin(0));
+  const int maximum = round(clones.clone(clones.num() - 1).criteria()
+    .flat_histogram().macrostate().histogram().center_of_last_bin());
+  const int size = maximum - minimum + 1;
+  std::vector<double> centers, seconds_per_trial;
+  std::vector<double> relaxation(size, 0.), num_relaxation(size, 0.);
+  for (int index = 0; index < clones.num(); ++index) {
+    const FlatHistogram& fh = clones.clone(index).criteria().flat_histogram();
+    const Histogram& hist = fh.macrostate().histogram();
+    ASSERT(std::abs(hist.edges()[1] - hist.edges()[0] - 1.) < NEAR_ZERO,
+      "Window requires a macrostate width of unity");
+    centers.push_back(0.5*(hist.center_of_bin(0) + hist.center_of_last_bin()));
+    seconds_per_trial.push_back(1./clones.trials_per_second(index));
+
+    // the average number of trials to leave each macrostate
+    const CollectionMatrix& cm = fh.bias().cm();
+    std::vector<double> trials_to_leave(hist.size(), -1.);
+    double sum = 0.;
+    int num_visited = 0;
+    for (int bin = 0; bin < hist.size(); ++bin) {
+      const double leave = cm.average(bin, 0) + cm.average(bin, 1);
+      if (cm.num_trials(bin) > 0 && leave > 0) {
+        trials_to_leave[bin] = 1./leave;
+        sum += trials_to_leave[bin];
+        ++num_visited;
+      }
+    }
+    double average = 1.;
+    if (num_visited > 0) {
+      average = sum/static_cast<double>(num_visited);
+    }
+    for (int bin = 0; bin < hist.size(); ++bin) {
+      const int macro = round(hist.center_of_bin(bin)) - minimum;
+      ASSERT(macro >= 0 && macro < size, "clones must be in order");
+      if (trials_to_leave[bin] < 0) {
+        relaxation[macro] += average;
+      } else {
+        relaxation[macro] += trials_to_leave[bin];
+      }
+      num_relaxation[macro] += 1.;
+    }
+  }
+  std::vector<double> cost(size);
+  for (int macro = 0; macro < size; ++macro) {
+    ASSERT(num_relaxation[macro] > 0, "macrostate: " << macro + minimum <<
+      " is not in any clone");
+    cost[macro] = relaxation[macro]/num_relaxation[macro]*
+      interpolate_(macro + minimum, centers, seconds_per_trial);
+  }
+  return cost;
+}
+
+}  // namespace feasst
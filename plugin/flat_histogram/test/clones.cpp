@@ -1,3 +1,7 @@
+#ifdef _OPENMP
+  #include <omp.h>
+#endif // _OPENMP
+#include <algorithm>
 #include "utils/test/utils.h"
 #include "utils/include/checkpoint.h"
 #include "math/include/histogram.h"
@@ -13,6 +17,7 @@
 #include "monte_carlo/include/trial_transfer.h"
 #include "monte_carlo/include/trial_translate.h"
 #include "monte_carlo/include/trial_add.h"
+#include "monte_carlo/include/trial_factory.h"
 #include "actions/include/run.h"
 #include "steppers/include/check_energy.h"
 #include "steppers/include/tune.h"
@@ -24,6 +29,7 @@
 #include "flat_histogram/include/macrostate_num_particles.h"
 #include "flat_histogram/include/window_exponential.h"
 #include "flat_histogram/include/clones.h"
+#include "flat_histogram/include/window_cost.h"
 
 namespace feasst {
 
@@ -133,10 +139,85 @@ TEST(Clones, lj_fh) {
   for (int i = 9; i < 13; ++i) EXPECT_EQ(energy[i], energy1[i - 5]);
 }
 
+TEST(Clones, lj_fh_swap) {
+  Clones clones = make_clones(12);
+  clones.initialize_and_run_until_complete({{"omp_batch", str(1e1)},
+                                            {"batches_per_swap", "1"}});
+  EXPECT_NEAR(clones.ln_prob().value(0), -36.9, 0.7);
+#ifdef _OPENMP
+  EXPECT_GT(clones.num_swaps_attempted(0), 0);
+  EXPECT_GE(clones.num_swaps_attempted(0), clones.num_swaps_accepted(0));
+#endif  // _OPENMP
+  for (int index = 0; index < clones.num(); ++index) {
+    EXPECT_TRUE(clones.clone(index).criteria().is_complete());
+  }
+}
+
+// Swaps between two clones are paired with their swap points.
+TEST(Clones, lj_fh_swap_points) {
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+  omp_set_num_threads(2);
+  Clones clones = make_clones(12);
+  clones.initialize();
+  std::vector<int64_t> attempts;
+  for (int index = 0; index < clones.num(); ++index) {
+    attempts.push_back(clones.clone(index).trials().num_attempts());
+  }
+  const int omp_batch = 10, batches_per_swap = 1;
+  clones.run_until_complete({{"omp_batch", str(omp_batch)},
+                             {"batches_per_swap", str(batches_per_swap)}});
+  omp_set_num_threads(num_threads);
+  EXPECT_GT(clones.num_swaps_accepted(0), 0);
+  EXPECT_GE(clones.num_swaps_attempted(0), clones.num_swaps_accepted(0));
+  for (int index = 0; index < clones.num(); ++index) {
+    EXPECT_TRUE(clones.clone(index).criteria().is_complete());
+    attempts[index] = clones.clone(index).trials().num_attempts()
+                    - attempts[index];
+  }
+  // Each swap uses one swap point of both clones, and clones 0 and 1 are
+  // paired at every other swap point.
+  const int64_t swap_points = std::min(attempts[0], attempts[1])/
+                              (omp_batch*batches_per_swap);
+  EXPECT_LE(clones.num_swaps_attempted(0), swap_points/2 + 1);
+#endif  // _OPENMP
+}
+
 double energy_av4(const int macro, const MonteCarlo& mc) {
   return mc.analyzers().back()->analyzers()[macro]->accumulator().average();
 }
 
+TEST(Clones, lj_fh_window_cost) {
+  Clones clones = make_clones(12);
+  clones.set_cycles_to_complete(1);
+  clones.initialize_and_run_until_complete({{"omp_batch", str(1e1)}});
+  for (int index = 0; index < clones.num(); ++index) {
+    EXPECT_GT(clones.trials_per_second(index), 0.);
+  }
+  const std::vector<double> cost = window_cost(clones);
+  EXPECT_EQ(13, static_cast<int>(cost.size()));
+  for (double macro_cost : cost) {
+    EXPECT_GT(macro_cost, 0.);
+  }
+  const std::vector<std::vector<int> > bounds =
+    WindowCost(cost, {{"num", "2"}, {"overlap", "4"}}).boundaries();
+  EXPECT_EQ(0, bounds[0][0]);
+  EXPECT_EQ(bounds[0][1] - 3, bounds[1][0]);
+  EXPECT_EQ(12, bounds[1][1]);
+
+  // the timing is restored from a checkpoint
+  Clones clones2 = test_serialize(clones);
+  for (int index = 0; index < clones.num(); ++index) {
+    EXPECT_DOUBLE_EQ(clones.trials_per_second(index),
+                     clones2.trials_per_second(index));
+  }
+  const std::vector<double> cost2 = window_cost(clones2);
+  EXPECT_EQ(cost.size(), cost2.size());
+  for (int macro = 0; macro < static_cast<int>(cost.size()); ++macro) {
+    EXPECT_NEAR(cost[macro], cost2[macro], 1e-8*cost[macro]);
+  }
+}
+
 TEST(Clones, lj_fh_LONG) {
   Clones clones = make_clones(5, 1, 1);
   Clones clones2 = test_serialize(clones);
@@ -1,5 +1,6 @@
 #include <vector>
 #include <memory>
+#include <cmath>
 #include "utils/test/utils.h"
 #include "configuration/include/configuration.h"
 #include "flat_histogram/include/ln_probability.h"
@@ -37,6 +38,104 @@ TEST(CollectionMatrix, serialize) {
 //  EXPECT_EQ(1, colmat3.min_blocks_());
 }
 
+TEST(CollectionMatrix, compact) {
+  const int num = 50;
+  CollectionMatrix colmat;
+  CollectionMatrix compact(argtype({{"compact", "true"}, {"compact_block_size", "10"}}));
+  EXPECT_FALSE(colmat.is_compact());
+  EXPECT_TRUE(compact.is_compact());
+  CollectionMatrix compact_sum(argtype({{"compact", "true"}}));
+  colmat.resize(num);
+  compact.resize(num);
+  compact_sum.resize(num);
+  for (int trial = 0; trial < 1000; ++trial) {
+    for (int macro = 0; macro < num; ++macro) {
+      const double down = 0.5*std::abs(std::sin(trial + macro));
+      const double up = 0.4*std::abs(std::cos(3*trial + macro));
+      colmat.add_trial(macro, down, up);
+      compact.add_trial(macro, down, up);
+      compact_sum.add_trial(macro, down, up);
+    }
+  }
+  EXPECT_EQ(num, compact.num_macrostates());
+  EXPECT_DOUBLE_EQ(1000, compact.num_trials(3));
+  EXPECT_EQ(100, compact.num_blocks(3));
+  EXPECT_EQ(100, compact.min_blocks());
+  EXPECT_NEAR(colmat.average(7, 0), compact.average(7, 0), 1e-12);
+  EXPECT_NEAR(colmat.average(7, 1), compact.average(7, 1), 1e-12);
+  EXPECT_GT(compact.block_stdev(7, 0), 0.);
+  LnProbability lnpi, lnpi_compact;
+  lnpi.resize(num);
+  lnpi_compact.resize(num);
+  colmat.compute_ln_prob(&lnpi);
+  compact.compute_ln_prob(&lnpi_compact);
+  for (int macro = 0; macro < num; ++macro) {
+    EXPECT_NEAR(lnpi.value(macro), lnpi_compact.value(macro), 1e-8);
+  }
+  EXPECT_EQ(100, static_cast<int>(compact.ln_prob_blocks().size()));
+  TRY(
+    compact.matrix();
+    CATCH_PHRASE("not available for a compact");
+  );
+
+  // without blocks, the checkpoint is much smaller
+  EXPECT_EQ(0, compact_sum.min_blocks());
+  std::stringstream ss, ss_compact;
+  colmat.serialize(ss);
+  compact_sum.serialize(ss_compact);
+  EXPECT_LT(5*ss_compact.str().size(), ss.str().size());
+  CollectionMatrix compact2 = test_serialize(compact);
+  EXPECT_TRUE(compact2.is_equal(compact, 1e-10));
+  compact2.compute_ln_prob(&lnpi);
+  EXPECT_NEAR(lnpi.value(num - 1), lnpi_compact.value(num - 1), 1e-8);
+
+  // set a macrostate from another compact collection matrix
+  CollectionMatrix compact3(argtype({{"compact", "true"},
+                                    {"compact_block_size", "10"}}));
+  compact3.resize(num);
+  compact3.set(7, compact);
+  EXPECT_DOUBLE_EQ(compact3.average(7, 1), compact.average(7, 1));
+  EXPECT_DOUBLE_EQ(0., compact3.num_trials(6));
+  // macrostates without blocks have no block ln_prob
+  EXPECT_EQ(0, compact3.min_blocks());
+  EXPECT_EQ(0, static_cast<int>(compact3.ln_prob_blocks().size()));
+
+  // copy only a range of macrostates
+  const CollectionMatrix range = compact.rows(5, 9);
+  EXPECT_TRUE(range.is_compact());
+  EXPECT_EQ(5, range.num_macrostates());
+  EXPECT_DOUBLE_EQ(compact.average(7, 1), range.average(2, 1));
+  EXPECT_EQ(100, range.num_blocks(4));
+  compact3.set(8, range, 3);
+  EXPECT_DOUBLE_EQ(compact.average(8, 0), compact3.average(8, 0));
+}
+
+// A copy of the rows does not change with the source.
+TEST(CollectionMatrix, rows) {
+  CollectionMatrix colmat;
+  colmat.resize(10);
+  for (int trial = 0; trial < 100; ++trial) {
+    colmat.add_trial(7, 0.5*std::abs(std::sin(trial)), 0.1);
+  }
+  const CollectionMatrix range = colmat.rows(5, 9);
+  const Accumulator& acc = range.matrix()[2][0];
+  const double sum = acc.sum();
+  const double stdev = acc.block_stdev();
+  std::vector<double> num_block_values;
+  for (const std::shared_ptr<Accumulator>& block : acc.block_averages()) {
+    num_block_values.push_back(block->num_values());
+  }
+  for (int trial = 0; trial < 1000; ++trial) {
+    colmat.add_trial(7, 0.4*std::abs(std::cos(trial)), 0.1);
+  }
+  EXPECT_NE(sum, colmat.matrix()[7][0].sum());
+  EXPECT_DOUBLE_EQ(sum, acc.sum());
+  EXPECT_EQ(stdev, acc.block_stdev());
+  for (int op = 0; op < static_cast<int>(num_block_values.size()); ++op) {
+    EXPECT_EQ(num_block_values[op], acc.block_averages()[op]->num_values());
+  }
+}
+
 //TEST(CollectionMatrix, blocks) {
 //  auto cm = MakeCollectionMatrix();
 //  cm->resize(6);
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <algorithm>
+#include "utils/test/utils.h"
+#include "flat_histogram/include/ln_probability.h"
+#include "flat_histogram/include/collection_matrix.h"
+#include "flat_histogram/include/collection_matrix_sparse.h"
+
+namespace feasst {
+
+// The same transitions between neighbors as CollectionMatrix.
+TEST(CollectionMatrixSparse, one_dimensional) {
+  const int num = 8;
+  CollectionMatrix colmat;
+  CollectionMatrixSparse sparse;
+  colmat.resize(num);
+  sparse.resize(num);
+  for (int trial = 0; trial < 100; ++trial) {
+    for (int macro = 0; macro < num; ++macro) {
+      double down = 0., up = 0.;
+      if (macro > 0) down = 0.5*std::abs(std::sin(trial + macro));
+      if (macro < num - 1) up = 0.4*std::abs(std::cos(3*trial + macro));
+      colmat.add_trial(macro, down, up);
+      // a trial to decrease, increase and remain in the macrostate scales
+      // all transition probabilities by the same factor.
+      sparse.add_trial(macro, std::max(0, macro - 1), down);
+      sparse.add_trial(macro, std::min(num - 1, macro + 1), up);
+      sparse.add_trial(macro, macro, 1.);
+    }
+  }
+  EXPECT_EQ(2*(num - 1), sparse.num_nonzero());
+  LnProbability lnpi, lnpi_sparse;
+  lnpi.resize(num);
+  lnpi_sparse.resize(num);
+  colmat.compute_ln_prob(&lnpi);
+  sparse.compute_ln_prob(&lnpi_sparse);
+  for (int macro = 0; macro < num; ++macro) {
+    EXPECT_NEAR(lnpi.value(macro), lnpi_sparse.value(macro), 1e-6);
+  }
+  CollectionMatrixSparse sparse2 = test_serialize(sparse);
+  EXPECT_TRUE(sparse2.is_equal(sparse, NEAR_ZERO));
+}
+
+// Metropolis transitions between neighbors on a two-dimensional grid with a
+// known distribution.
+TEST(CollectionMatrixSparse, two_dimensional) {
+  const int num0 = 5, num1 = 4;
+  auto exact = [](const int i, const int j) {
+    return -0.3*(i - 2)*(i - 2) + 0.7*j - 0.1*i*j; };
+  CollectionMatrixSparse sparse;
+  sparse.resize(num0*num1);
+  for (int i = 0; i < num0; ++i) {
+    for (int j = 0; j < num1; ++j) {
+      const int macro = i*num1 + j;
+      for (const std::vector<int>& delta : std::vector<std::vector<int> >(
+           {{-1, 0}, {1, 0}, {0, -1}, {0, 1}})) {
+        const int i2 = i + delta[0], j2 = j + delta[1];
+        if (i2 >= 0 && i2 < num0 && j2 >= 0 && j2 < num1) {
+          sparse.add_trial(macro, i2*num1 + j2,
+            std::min(1., std::exp(exact(i2, j2) - exact(i, j))));
+        } else {
+          sparse.add_trial(macro, macro, 0.);
+        }
+      }
+    }
+  }
+  LnProbability lnpi;
+  lnpi.resize(num0*num1);
+  EXPECT_GT(sparse.compute_ln_prob(&lnpi), 1);
+  for (int i = 0; i < num0; ++i) {
+    for (int j = 0; j < num1; ++j) {
+      EXPECT_NEAR(lnpi.value(i*num1 + j) - lnpi.value(0),
+                  exact(i, j) - exact(0, 0), 1e-6);
+    }
+  }
+  // begin with the solution
+  EXPECT_EQ(1, sparse.compute_ln_prob(&lnpi));
+}
+
+TEST(CollectionMatrixSparse, reachable) {
+  CollectionMatrixSparse sparse;
+  sparse.resize(5);
+  sparse.add_trial(0, 2, 0.5);
+  sparse.add_trial(2, 3, 0.);
+  const std::vector<bool> reachable = sparse.reachable();
+  EXPECT_TRUE(reachable[0]);
+  EXPECT_FALSE(reachable[1]);
+  EXPECT_TRUE(reachable[2]);
+  EXPECT_FALSE(reachable[3]);
+  EXPECT_FALSE(reachable[4]);
+}
+
+}  // namespace feasst
@@ -29,7 +29,7 @@
 namespace feasst {
 
 std::unique_ptr<MonteCarlo> monte_carlo2(const int thread, const int min, const int max,
-    const int soft_min, const int soft_max) {
+    const int soft_min, const int soft_max, const int min_sweeps = 100000) {
   DEBUG("min " << min);
   DEBUG("max " << max);
   const int trials_per = 1e2;
@@ -52,7 +52,7 @@ std::unique_ptr<MonteCarlo> monte_carlo2(const int thread, const int min, const
       Histogram({{"width", "1"}, {"max", str(max)}, {"min", str(min)}}),
       {{"soft_macro_min", str(soft_min)}, {"soft_macro_max", str(soft_max)}}),
     //MakeWLTM({{"min_sweeps", "100000"}, {"new_sweep", "1"}, {"min_flatness", "25"}, {"collect_flatness", "20"}})));//, {"max_block_operations", "6"}})));
-    MakeTransitionMatrix({{"min_sweeps", "100000"}, {"new_sweep", "1"}})));//, {"max_block_operations", "6"}})));
+    MakeTransitionMatrix({{"min_sweeps", str(min_sweeps)}, {"new_sweep", "1"}})));//, {"max_block_operations", "6"}})));
   mc->add(MakeCheckEnergy({{"trials_per_write", str(trials_per)}}));
   mc->add(MakeTune({{"trials_per_write", str(trials_per)}, {"multistate", "true"}, {"output_file", "tune" + str(thread)}}));
 //  mc->add(MakeLogAndMovie({{"trials_per_write", str(trials_per)},
@@ -71,10 +71,13 @@ std::unique_ptr<MonteCarlo> monte_carlo2(const int thread, const int min, const
   return mc;
 }
 
-CollectionMatrixSplice make_splice(const int max, const int min = 0) {
+CollectionMatrixSplice make_splice(const int max, const int min = 0,
+    const int min_sweeps = 100000, const bool asynchronous = false) {
   auto cm = MakeCollectionMatrixSplice({{"min_window_size", "2"},
     {"ln_prob_file", "tmp/lnpi.txt"},
     {"ln_prob_file_append", "true"},
+    {"bounds_file", "tmp/bounds.txt"},
+    {"asynchronous", str(asynchronous)},
     {"hours_per", "0.00001"}});
   std::vector<std::vector<int> > bounds = WindowExponential({
     {"maximum", str(max)},
@@ -86,7 +89,7 @@ CollectionMatrixSplice make_splice(const int max, const int min = 0) {
   for (int index = 0; index < static_cast<int>(bounds.size()); ++index) {
     const std::vector<int> bound = bounds[index];
     DEBUG(bound[0] << " " << bound[1]);
-    std::unique_ptr<MonteCarlo> mcu = monte_carlo2(index, min, max, bound[0], bound[1]);
+    std::unique_ptr<MonteCarlo> mcu = monte_carlo2(index, min, max, bound[0], bound[1], min_sweeps);
     std::shared_ptr<MonteCarlo> mcs = std::move(mcu);
     cm->add(mcs);
   }
@@ -163,4 +166,23 @@ TEST(CollectionMatrixSplice, lj_fh_LONG) {
   auto clones3 = MakeCollectionMatrixSplice("tmp/clones.fst");
 }
 
+#ifdef _OPENMP
+TEST(CollectionMatrixSplice, asynchronous) {
+  CollectionMatrixSplice clones = make_splice(5, 1, 2000, true);
+  EXPECT_TRUE(clones.asynchronous());
+  clones.set(MakeCheckpoint({{"num_hours", "0.00001"},
+    {"checkpoint_file", "tmp/clones_async.fst"}}));
+  clones.run_until_all_are_complete();
+  EXPECT_TRUE(clones.are_all_complete());
+  for (int window = 0; window < clones.num() - 1; ++window) {
+    EXPECT_EQ(clones.flat_histogram(window).macrostate().soft_max() + 1,
+              clones.flat_histogram(window + 1).macrostate().soft_min());
+  }
+  LnProbability lnpi = clones.ln_prob();
+  EXPECT_NEAR(lnpi.value(4), -0.045677458321876000, 0.5);
+  auto clones2 = MakeCollectionMatrixSplice("tmp/clones_async.fst");
+  EXPECT_TRUE(clones2->asynchronous());
+}
+#endif  // _OPENMP
+
 }  // namespace feasst
@@ -0,0 +1,129 @@
+#include <cmath>
+#include "utils/test/utils.h"
+#include "math/include/histogram.h"
+#include "configuration/include/configuration.h"
+#include "system/include/system.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "flat_histogram/include/flat_histogram.h"
+#include "flat_histogram/include/ln_probability.h"
+#include "flat_histogram/include/macrostate_product.h"
+#include "flat_histogram/include/transition_matrix_sparse.h"
+#include "flat_histogram/include/collection_matrix_sparse.h"
+#include "flat_histogram/include/clones.h"
+
+namespace feasst {
+
+// An ideal binary mixture with V exp(beta mu) of 3 and 2 for each type.
+std::unique_ptr<MonteCarlo> ideal_binary(const int min0, const int max0,
+                                         const int max1) {
+  auto mc = std::make_unique<MonteCarlo>();
+  mc->begin({
+    {"Configuration", {{"cubic_side_length", "8"},
+      {"particle_type", "a:../particle/atom.txt,b:../particle/atom_new.txt"}}},
+    {"Potential", {{"VisitModel", "DontVisitModel"}}},
+    {"ThermoParams", {{"beta", "1"},
+      {"chemical_potential", str(std::log(3./512.)) + "," +
+                             str(std::log(2./512.))}}},
+    {"FlatHistogram", {{"Macrostate", "MacrostateProduct"},
+      {"first_particle_type", "a"}, {"first_width", "1"},
+      {"first_min", str(min0)}, {"first_max", str(max0)},
+      {"second_Macrostate", "MacrostateNumParticles"},
+      {"second_particle_type", "b"}, {"second_width", "1"},
+      {"second_max", str(max1)},
+      {"Bias", "TransitionMatrixSparse"}, {"min_sweeps", "10"}}},
+    {"TrialAddRemove", {{"particle_type", "a"}}},
+    {"TrialAddRemove", {{"particle_type", "b"}}},
+    {"CriteriaUpdater", {{"trials_per_update", "1e3"}}},
+  });
+  return mc;
+}
+
+// Return the exact ln_prob(N0, N1) of the ideal binary mixture.
+double ideal_binary_ln_prob(const int num0, const int num1) {
+  return num0*std::log(3.) - std::lgamma(num0 + 1)
+       + num1*std::log(2.) - std::lgamma(num1 + 1);
+}
+
+TEST(MacrostateProduct, ideal_binary) {
+  auto mc = ideal_binary(0, 4, 3);
+  const MacrostateProduct& macro = static_cast<const MacrostateProduct&>(
+    mc->criteria().macrostate());
+  EXPECT_EQ(4, macro.num_second());
+  EXPECT_EQ(20, macro.histogram().size());
+  EXPECT_EQ(2, macro.first_bin(9));
+  EXPECT_EQ(1, macro.second_bin(9));
+  mc->run_until_complete();
+  const LnProbability& lnpi = mc->criteria().bias().ln_prob();
+  for (int bin = 0; bin < lnpi.size(); ++bin) {
+    EXPECT_NEAR(lnpi.value(bin) - lnpi.value(0),
+      ideal_binary_ln_prob(macro.first_bin(bin), macro.second_bin(bin)), 0.2);
+  }
+  auto mc2 = test_serialize_unique(*mc);
+  EXPECT_NEAR(mc2->criteria().bias().ln_prob().value(7), lnpi.value(7),
+              NEAR_ZERO);
+}
+
+TEST(MacrostateProduct, ideal_binary_clones) {
+  Clones clones;
+  clones.add(ideal_binary(0, 3, 3));
+  clones.add(ideal_binary(2, 5, 3));
+  EXPECT_EQ(8, clones.clone(1).criteria().macrostate().value(0));
+  clones.initialize_and_run_until_complete();
+  const LnProbability lnpi = clones.ln_prob();
+  EXPECT_EQ(24, lnpi.size());
+  for (int bin = 0; bin < lnpi.size(); ++bin) {
+    EXPECT_NEAR(lnpi.value(bin) - lnpi.value(0),
+      ideal_binary_ln_prob(bin/4, bin % 4), 0.25);
+  }
+}
+
+// Without particles, only the bin of zero energy is reachable, but the sweeps
+// still complete.
+TEST(MacrostateProduct, lj_num_energy) {
+  auto mc = std::make_unique<MonteCarlo>();
+  mc->begin({
+    {"RandomMT19937", {{"seed", "123"}}},
+    {"Configuration", {{"cubic_side_length", "8"},
+      {"particle_type", "lj:../particle/lj_new.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "-2"}}},
+    {"FlatHistogram", {{"Macrostate", "MacrostateProduct"},
+      {"first_particle_type", "lj"}, {"first_width", "1"},
+      {"first_min", "0"}, {"first_max", "2"},
+      {"second_Macrostate", "MacrostateEnergy"}, {"second_width", "0.5"},
+      {"second_min", "-1"}, {"second_max", "0.5"},
+      {"Bias", "TransitionMatrixSparse"}, {"min_sweeps", "2"},
+      {"min_visits", "10"}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialTransfer", {{"particle_type", "lj"}}},
+    {"CriteriaUpdater", {{"trials_per_update", "1e3"}}},
+  });
+  const MacrostateProduct& macro = static_cast<const MacrostateProduct&>(
+    mc->criteria().macrostate());
+  EXPECT_EQ(12, macro.histogram().size());
+  for (int batch = 0; batch < 1000; ++batch) {
+    if (mc->criteria().is_complete()) break;
+    mc->attempt(1e3);
+  }
+  EXPECT_TRUE(mc->criteria().is_complete());
+  const TransitionMatrixSparse& tm = static_cast<const TransitionMatrixSparse&>(
+    mc->criteria().bias());
+  const std::vector<bool> reachable = tm.collection_matrix().reachable();
+  // the empty and single particle configurations have zero energy.
+  for (const int num : {0, 1}) {
+    for (int energy = 0; energy < macro.num_second(); ++energy) {
+      const int bin = num*macro.num_second() + energy;
+      EXPECT_EQ(macro.second_bin(bin) == 2, reachable[bin]);
+    }
+  }
+}
+
+TEST(MacrostateProduct, args) {
+  TRY(
+    MakeMacrostateProduct({{"first_width", "2"}, {"first_max", "5"},
+      {"first_min", "1"}, {"second_width", "1"}, {"second_max", "2"}});
+    CATCH_PHRASE("must be an integer multiple of its width");
+  );
+}
+
+}  // namespace feasst
@@ -231,6 +231,38 @@ TEST(MonteCarlo, lj_fh_01) {
   }
 }
 
+// Run TransitionMatrix with a compact CollectionMatrix, as in lj_fh_01.
+TEST(MonteCarlo, lj_fh_compact) {
+  auto mc = MakeMonteCarlo({{
+    {"RandomMT19937", {{"seed", "123"}}},
+    {"Configuration", {{"particle_type", "../particle/lj.txt"},
+                       {"cubic_side_length", "8"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"Potential", {{"VisitModel", "LongRangeCorrections"}}},
+    {"ThermoParams", {{"beta", str(1./1.5)},
+                      {"chemical_potential", "-2.352321"}}},
+    {"FlatHistogram", {{"Macrostate", "MacrostateNumParticles"},
+      {"width", "1"}, {"max", "1"}, {"min", "0"},
+      {"Bias", "TransitionMatrix"}, {"min_sweeps", "10"},
+      {"compact", "true"}, {"compact_block_size", "100"}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialTransfer", {{"particle_type", "0"}, {"weight", "4"}}},
+    {"CriteriaUpdater", {{"trials_per_update", "1"}}},
+    {"CriteriaWriter", {{"trials_per_write", "1e3"},
+                        {"output_file", "tmp/lj_fh_compact.txt"}}},
+  }}, true);
+  mc->run_until_complete();
+  std::unique_ptr<FlatHistogram> fh =
+    FlatHistogram().flat_histogram(mc->criteria());
+  EXPECT_TRUE(fh->bias().cm().is_compact());
+  EXPECT_GT(fh->bias().cm().min_blocks(), 0);
+  const LnProbability lnpi = fh->bias().ln_prob();
+  EXPECT_NEAR(lnpi.value(1) - lnpi.value(0), 4.67, 0.2);
+  auto mc2 = test_serialize_unique(*mc);
+  EXPECT_TRUE(FlatHistogram().flat_histogram(mc2->criteria())->bias().cm()
+    .is_compact());
+}
+
 TEST(MonteCarlo, lj_fh_10sweep_LONG) {
   for (int num_steps : {1, 2}) {
     //for (const std::string bias_name : {"TM"}) {
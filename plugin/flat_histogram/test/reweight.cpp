@@ -0,0 +1,99 @@
+#include <cmath>
+#include <fstream>
+#include "utils/test/utils.h"
+#include "utils/include/io.h"
+#include "flat_histogram/include/ln_probability.h"
+#include "flat_histogram/include/reweight.h"
+
+namespace feasst {
+
+// Return the Reweight of the N, energy and lnPI columns of the SRSW data.
+Reweight read_srsw(const std::string& file_name) {
+  std::ifstream file(file_name);
+  std::string line;
+  std::getline(file, line);
+  std::vector<double> macrostates, energy, ln_prob;
+  while (std::getline(file, line)) {
+    const std::vector<std::string> cols = split(line, ',');
+    macrostates.push_back(str_to_double(cols[0]));
+    energy.push_back(str_to_double(cols[1]));
+    ln_prob.push_back(str_to_double(cols[2]));
+  }
+  Reweight reweight(LnProbability(ln_prob), macrostates);
+  reweight.add_data(energy);
+  return reweight;
+}
+
+TEST(Reweight, ideal_gas) {
+  // Poisson distribution of the ideal gas with an average of 2.
+  std::vector<double> macros, lnpi;
+  for (int num = 0; num < 40; ++num) {
+    macros.push_back(num);
+    lnpi.push_back(num*std::log(2.) - std::lgamma(num + 1));
+  }
+  Reweight reweight(LnProbability(lnpi), macros);
+  EXPECT_EQ(-1, reweight.phase_boundary(reweight.ln_prob()));
+  const std::vector<std::vector<double> > iso =
+    reweight.isotherm({0., std::log(2.), std::log(3.)});
+  for (int index = 0; index < 3; ++index) {
+    EXPECT_NEAR(iso[index][0], 2.*(index + 1), 1e-8);  // beta p V = <N>
+    EXPECT_NEAR(iso[index][1], 2.*(index + 1), 1e-8);
+  }
+  EXPECT_TRUE(reweight.saturation().empty());
+}
+
+// Two phases separated by a valley with a bump, and thus two minima.
+TEST(Reweight, two_minima) {
+  std::vector<double> macros, lnpi;
+  for (int num = 0; num <= 60; ++num) {
+    macros.push_back(num);
+    lnpi.push_back(std::max(-0.1*std::pow(num - 10, 2),
+                            -0.1*std::pow(num - 50, 2))
+                   + 20.*std::exp(-std::pow(num - 30.5, 2)/8.));
+  }
+  Reweight reweight(LnProbability(lnpi), macros, {{"num_smooth", "2"}});
+  EXPECT_EQ(2, static_cast<int>(reweight.ln_prob().minima(2).size()));
+  EXPECT_EQ(27, reweight.phase_boundary(reweight.ln_prob()));
+  const double delta_beta_mu = reweight.equilibrium(0.5);
+  EXPECT_NEAR(0., delta_beta_mu, 1e-3);
+  EXPECT_EQ(27, reweight.phase_boundary(reweight.ln_prob(delta_beta_mu)));
+}
+
+TEST(Reweight, lj_srsw) {
+  const std::vector<double> temps = {0.7, 1.2};
+  std::vector<Reweight> reweights = {
+    read_srsw("../plugin/flat_histogram/test/data/stat070.csv"),
+    read_srsw("../plugin/flat_histogram/test/data/stat120.csv")};
+  const std::vector<std::vector<double> > sats = saturation(reweights, -1.);
+  const double volume = std::pow(8, 3);
+
+  // https://www.nist.gov/mml/csd/chemical-informatics-group/sat-tmmc-liquid-vapor-coexistence-properties-long-range
+  const std::vector<double> rho_vap = {0.0019956, 0.1003},
+                            rho_liq = {0.84341, 0.56329},
+                            psat = {0.0013693, 0.07721},
+                            uliq = {-6.1002, -3.8723};
+  std::vector<double> vapor, liquid;
+  for (int index = 0; index < 2; ++index) {
+    const std::vector<double>& sat = sats[index];
+    ASSERT_EQ(7, static_cast<int>(sat.size()));
+    EXPECT_NEAR(sat[2]/volume, rho_vap[index], 2e-3*rho_liq[index]);
+    EXPECT_NEAR(sat[5]/volume, rho_liq[index], 2e-3*rho_liq[index]);
+    EXPECT_NEAR(sat[6]/sat[5], uliq[index], 1e-2);
+    for (int phase : {1, 4}) {
+      EXPECT_NEAR(temps[index]*sat[phase]/volume, psat[index],
+                  0.01*psat[index]);
+    }
+    vapor.push_back(sat[2]/volume);
+    liquid.push_back(sat[5]/volume);
+
+    // reweighting to equilibrium from either direction agrees.
+    EXPECT_NEAR(sat[0], reweights[index].equilibrium(2.), 1e-8);
+  }
+
+  // the critical point is approximately T=1.31 and rho=0.316
+  const std::vector<double> crit = critical_point(temps, vapor, liquid);
+  EXPECT_NEAR(crit[0], 1.31, 0.02);
+  EXPECT_NEAR(crit[1], 0.316, 0.02);
+}
+
+}  // namespace feasst
@@ -0,0 +1,55 @@
+#include <vector>
+#include <algorithm>
+#include "utils/test/utils.h"
+#include "flat_histogram/include/window_cost.h"
+#include "flat_histogram/include/window_exponential.h"
+
+namespace feasst {
+
+TEST(WindowCost, constant) {
+  WindowCost windows(std::vector<double>(201, 1.), {{"num", "4"}});
+  EXPECT_EQ(200, windows.maximum());
+  const std::vector<std::vector<int> > bounds = windows.boundaries();
+  const std::vector<std::vector<int> > equal = WindowExponential({
+    {"maximum", "200"}, {"num", "4"}, {"alpha", "1"}}).boundaries();
+  for (int win = 0; win < 4; ++win) {
+    EXPECT_NEAR(bounds[win][0], equal[win][0], 1);
+    EXPECT_NEAR(bounds[win][1], equal[win][1], 1);
+  }
+}
+
+TEST(WindowCost, increasing) {
+  // the cost per macrostate increases quadratically
+  std::vector<double> cost;
+  for (int macro = 10; macro <= 300; ++macro) {
+    cost.push_back(1. + 1e-4*macro*macro);
+  }
+  WindowCost windows(cost, {{"minimum", "10"}, {"num", "5"},
+                            {"overlap", "3"}});
+  const std::vector<std::vector<int> > bounds = windows.boundaries();
+  EXPECT_EQ(10, bounds.front()[0]);
+  EXPECT_EQ(300, bounds.back()[1]);
+  for (int win = 1; win < 5; ++win) {
+    EXPECT_EQ(bounds[win][0], bounds[win - 1][1] - 2);
+    // windows become more narrow
+    EXPECT_LT(bounds[win][1] - bounds[win][0], bounds[win - 1][1] - bounds[win - 1][0]);
+  }
+  // all windows take about the same time
+  const std::vector<double> times = windows.times();
+  const double max_time = *std::max_element(times.begin(), times.end());
+  for (double time : times) {
+    EXPECT_GT(time, 0.9*max_time);
+  }
+  // which is faster than the slowest window of equal widths
+  const std::vector<std::vector<int> > equal = WindowExponential({
+    {"minimum", "10"}, {"maximum", "300"}, {"num", "5"}, {"overlap", "3"},
+    {"alpha", "1"}}).boundaries();
+  EXPECT_LT(max_time, 0.7*windows.time(equal.back()[0], equal.back()[1]));
+
+  TRY(
+    WindowCost(std::vector<double>(10, 1.), {{"num", "5"}, {"overlap", "2"}});
+    CATCH_PHRASE("the macrostate range is too small");
+  );
+}
+
+}  // namespace feasst
@@ -121,6 +121,18 @@ class Accumulator {
   /// Zero all accumulated values.
   void reset();
 
+  /**
+    Combine the values accumulated in an independent series, such as another
+    replica of the same simulation, with those accumulated here.
+    The moments, minimum and maximum are combined exactly.
+    The completed blocks of each block operation with an equal block size are
+    combined, while incomplete blocks of the given series are discarded.
+    Thus, the block averages are exact when both series have the same number
+    of values.
+    Further accumulation after a merge may lead to misaligned blocks.
+   */
+  void merge(const Accumulator& accumulator);
+
   /// Return the maximum value accumulated.
   double max() const { return max_; }
 
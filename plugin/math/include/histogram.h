@@ -95,6 +95,9 @@ class Histogram {
     /// If true, update histogram. Otherwise, simply initialize sizes.
     const bool update = true);
 
+  /// Add an amount to an existing bin (e.g., a count accumulated elsewhere).
+  void add_to_bin(const int bin, const double amount);
+
   /// Return the histogram.
   const std::deque<double>& histogram() const { return histogram_; }
 
@@ -52,6 +52,12 @@ class Random {
   /// betwee min and max.
   int uniform(const int min, const int max);
 
+  /// Fill values with num random real numbers with a uniform probability
+  /// distribution between 0 and 1.
+  /// The values are identical to num consecutive calls to uniform(), but
+  /// generators may fill the batch more efficiently.
+  void uniform(const int num, std::vector<double> * values);
+
   /// Randomly return true or false
   bool coin_flip();
 
@@ -183,10 +189,10 @@ class Random {
   const Cache& cache() const;
 
   /// Set Cache to load.
-  void set_cache_to_load(const bool load);
+  virtual void set_cache_to_load(const bool load);
 
   /// Set Cache to unload.
-  void set_cache_to_unload(const Random& random);
+  virtual void set_cache_to_unload(const Random& random);
 
   /// Serialize.
   std::string class_name() const { return class_name_; }
@@ -212,6 +218,7 @@ class Random {
   virtual void reseed_(const int seed) = 0;
   virtual double gen_uniform_() = 0;
   virtual int gen_uniform_(const int min, const int max);
+  virtual void gen_uniform_batch_(std::vector<double> * values);
 };
 
 }  // namespace feasst
@@ -0,0 +1,122 @@
+#ifndef FEASST_MATH_RANDOM_PHILOX_H_
+#define FEASST_MATH_RANDOM_PHILOX_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "math/include/random.h"
+
+namespace feasst {
+
+typedef std::map<std::string, std::string> argtype;
+
+/**
+  This counter-based generator uses the Philox4x32-10 bijection of
+  Salmon, Moraes, Dror and Shaw, "Parallel random numbers: as easy as 1, 2, 3"
+  https://doi.org/10.1145/2063384.2063405
+
+  The n-th random number of a stream is a function of only the seed, the
+  stream and n, with no other state.
+  Thus, the generator may jump ahead by any number of draws at no cost, and
+  independent streams for threads or trials may be derived from the same seed
+  without overlap.
+  Each 128-bit counter block provides two uniform doubles with 53 random bits.
+
+  When used with Prefetch, each clone draws from a derived stream instead of
+  a new seed, such that parallel runs are deterministic.
+  The random numbers of the accepted trial are then reproduced by rewinding
+  the position in the stream rather than storing each number in the Cache.
+ */
+class RandomPhilox : public Random {
+ public:
+  //@{
+  /** @name Arguments
+    - stream: index of the independent stream of random numbers (default: 0).
+    - Random arguments.
+   */
+  explicit RandomPhilox(argtype args = argtype());
+  explicit RandomPhilox(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Return the stream.
+  uint64_t stream() const { return stream_; }
+
+  /// Set the stream and restart at the first position in the stream.
+  void set_stream(const uint64_t stream);
+
+  /// Return the number of uniform random numbers drawn from the stream.
+  uint64_t position() const { return position_; }
+
+  /// Set the number of uniform random numbers drawn from the stream.
+  void set_position(const uint64_t position) { position_ = position; }
+
+  /// Skip the given number of uniform random numbers.
+  void jump(const uint64_t num) { position_ += num; }
+
+  /// Return a new generator with the same seed but a different stream,
+  /// starting at the first position in that stream.
+  std::shared_ptr<RandomPhilox> derive(const uint64_t stream) const;
+
+  /**
+    Instead of storing each number in the Cache, record the position in the
+    stream while loading.
+    To unload, draw from the seed, stream and recorded position of the given
+    RandomPhilox, until the next call to set_cache_to_load restores the
+    original seed, stream and position.
+    If the given Random is not a RandomPhilox, use the Cache.
+   */
+  void set_cache_to_load(const bool load) override;
+  void set_cache_to_unload(const Random& random) override;
+
+  // serialize
+  std::shared_ptr<Random> create(std::istream& istr) const override {
+    return std::make_shared<RandomPhilox>(istr); }
+  std::shared_ptr<Random> create(argtype * args) const override {
+    return std::make_shared<RandomPhilox>(args); }
+  void serialize(std::ostream& ostr) const override;
+  explicit RandomPhilox(std::istream& istr);
+  virtual ~RandomPhilox() {}
+
+  //@}
+ private:
+  uint32_t key_ = 0;
+  uint64_t stream_ = 0;
+  uint64_t position_ = 0;
+
+  // rewind the stream to reproduce the numbers drawn while loading
+  bool is_loading_ = false;
+  bool is_unloading_ = false;
+  uint64_t load_position_ = 0;
+  uint32_t resume_key_ = 0;
+  uint64_t resume_stream_ = 0;
+  uint64_t resume_position_ = 0;
+
+  // temporary and not serialized
+  uint64_t block_ = 0;
+  bool is_block_ = false;
+  uint32_t output_[4];
+
+  void reseed_(const int seed) override;
+  double gen_uniform_() override;
+  void gen_uniform_batch_(std::vector<double> * values) override;
+  void compute_block_(const uint64_t block);
+};
+
+inline std::shared_ptr<RandomPhilox> MakeRandomPhilox(
+    argtype args = argtype()) {
+  return std::make_shared<RandomPhilox>(args);
+}
+
+/// Apply ten rounds of the Philox4x32 bijection to the counter with the key.
+void philox4x32_10(const uint32_t counter[4], const uint32_t key[2],
+                   uint32_t output[4]);
+
+}  // namespace feasst
+
+#endif  // FEASST_MATH_RANDOM_PHILOX_H_
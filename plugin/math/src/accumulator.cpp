@@ -38,7 +38,8 @@ void Accumulator::accumulate(double value) {
       block_size_.erase(block_size_.begin());
       block_size_.push_back(new_block_size);
       sum_block_.erase(sum_block_.begin());
-      sum_block_.push_back(sum());
+      // the loop below adds the current value to the new block
+      sum_block_.push_back(sum() - value);
       block_averages_.erase(block_averages_.begin());
       block_averages_.push_back(MakeAccumulator({{"max_block_operations", "0"},
         {"num_moments", feasst::str(num_moments())}}));
@@ -84,6 +85,33 @@ void Accumulator::reset() {
   }
 }
 
+void Accumulator::merge(const Accumulator& accumulator) {
+  ASSERT(num_moments() == accumulator.num_moments(),
+    "num_moments: " << num_moments() << " != " << accumulator.num_moments());
+  ASSERT(block_power_ == accumulator.block_power_, "block_power mismatch");
+  if (accumulator.num_values() == 0) {
+    return;
+  }
+  if (num_values() == 0) {
+    last_value_ = accumulator.last_value_;
+  }
+  for (int mo = 0; mo < num_moments(); ++mo) {
+    val_moment_[mo] += accumulator.val_moment_[mo];
+  }
+  if (max_ < accumulator.max_) max_ = accumulator.max_;
+  if (min_ > accumulator.min_) min_ = accumulator.min_;
+  for (int bop = 0; bop < max_block_operations_; ++bop) {
+    for (int bop2 = 0; bop2 < accumulator.max_block_operations_; ++bop2) {
+      if (std::abs(block_size_[bop] - accumulator.block_size_[bop2]) < 0.1) {
+        block_averages_[bop]->merge(*accumulator.block_averages_[bop2]);
+        blocks_[bop].insert(blocks_[bop].end(),
+                            accumulator.blocks_[bop2].begin(),
+                            accumulator.blocks_[bop2].end());
+      }
+    }
+  }
+}
+
 double Accumulator::average() const {
   ASSERT(num_moments() > 1, "num_moments:" << num_moments() <<
     " should be greater than 1 to obtain an average value.");
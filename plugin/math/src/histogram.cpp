@@ -157,6 +157,12 @@ void Histogram::add(const double value, const bool update) {
   }
 }
 
+void Histogram::add_to_bin(const int bin, const double amount) {
+  ASSERT(bin >= 0 && bin < size(), "bin: " << bin << " is out of range: "
+    << size());
+  histogram_[bin] += amount;
+}
+
 void Histogram::serialize(std::ostream& ostr) const {
   feasst_serialize_version(4226, ostr);
   feasst_serialize(histogram_, ostr);
@@ -67,6 +67,20 @@ int Random::uniform(const int min, const int max) {
   return static_cast<int>(uniform() * (max - min + 1)) + min;
 }
 
+void Random::uniform(const int num, std::vector<double> * values) {
+  values->resize(num);
+  if (!is_seeded_) {
+    seed_by_time();
+  }
+  if (cache_->is_loading() || cache_->is_unloading()) {
+    for (double& value : *values) {
+      value = uniform();
+    }
+  } else {
+    gen_uniform_batch_(values);
+  }
+}
+
 void Random::serialize_random_(std::ostream& ostr) const {
   feasst_serialize_version(979, ostr);
   feasst_serialize(cache_, ostr);
@@ -332,6 +346,12 @@ int Random::gen_uniform_(const int min, const int max) {
   return min + static_cast<int>(gen_uniform_()*(max - min));
 }
 
+void Random::gen_uniform_batch_(std::vector<double> * values) {
+  for (double& value : *values) {
+    value = gen_uniform_();
+  }
+}
+
 const Cache& Random::cache() const { return *cache_; }
 
 void Random::set_cache_to_load(const bool load) { cache_->set_load(load); }
@@ -0,0 +1,177 @@
+#include <string>
+#include "utils/include/arguments.h"
+#include "utils/include/io.h"
+#include "utils/include/serialize.h"
+#include "math/include/random_philox.h"
+
+namespace feasst {
+
+FEASST_MAPPER(RandomPhilox,);
+
+void philox4x32_10(const uint32_t counter[4], const uint32_t key[2],
+                   uint32_t output[4]) {
+  const uint64_t mult0 = 0xD2511F53;
+  const uint64_t mult1 = 0xCD9E8D57;
+  uint32_t ctr[4] = {counter[0], counter[1], counter[2], counter[3]};
+  uint32_t k0 = key[0], k1 = key[1];
+  for (int round = 0; round < 10; ++round) {
+    const uint64_t prod0 = mult0*ctr[0];
+    const uint64_t prod1 = mult1*ctr[2];
+    const uint32_t hi0 = static_cast<uint32_t>(prod0 >> 32);
+    const uint32_t lo0 = static_cast<uint32_t>(prod0);
+    const uint32_t hi1 = static_cast<uint32_t>(prod1 >> 32);
+    const uint32_t lo1 = static_cast<uint32_t>(prod1);
+    ctr[0] = hi1 ^ ctr[1] ^ k0;
+    ctr[1] = lo1;
+    ctr[2] = hi0 ^ ctr[3] ^ k1;
+    ctr[3] = lo0;
+    k0 += 0x9E3779B9;
+    k1 += 0xBB67AE85;
+  }
+  for (int index = 0; index < 4; ++index) {
+    output[index] = ctr[index];
+  }
+}
+
+RandomPhilox::RandomPhilox(argtype * args) : Random(args) {
+  class_name_ = "RandomPhilox";
+  stream_ = static_cast<uint64_t>(std::stoull(str("stream", args, "0")));
+  parse_seed_(args);
+}
+RandomPhilox::RandomPhilox(argtype args) : RandomPhilox(&args) {
+  feasst_check_all_used(args);
+}
+
+void RandomPhilox::reseed_(const int seed) {
+  TRACE("seed " << seed << " address " << this);
+  key_ = static_cast<uint32_t>(seed);
+  position_ = 0;
+  is_block_ = false;
+}
+
+void RandomPhilox::set_stream(const uint64_t stream) {
+  stream_ = stream;
+  position_ = 0;
+  is_block_ = false;
+}
+
+void RandomPhilox::compute_block_(const uint64_t block) {
+  const uint32_t counter[4] = {
+    static_cast<uint32_t>(block),
+    static_cast<uint32_t>(block >> 32),
+    static_cast<uint32_t>(stream_),
+    static_cast<uint32_t>(stream_ >> 32)};
+  // the second word of the key distinguishes from other uses of Philox
+  const uint32_t key[2] = {key_, 0x46454153};
+  philox4x32_10(counter, key, output_);
+  block_ = block;
+  is_block_ = true;
+}
+
+// combine two 32-bit words into a double in [0, 1) with 53 random bits.
+static inline double to_double_(const uint32_t first, const uint32_t second) {
+  return (static_cast<double>(first >> 5)*67108864. +
+          static_cast<double>(second >> 6))/9007199254740992.;
+}
+
+double RandomPhilox::gen_uniform_() {
+  const uint64_t block = position_ >> 1;
+  if (!is_block_ || block != block_) {
+    compute_block_(block);
+  }
+  const int word = 2*static_cast<int>(position_ & 1);
+  ++position_;
+  return to_double_(output_[word], output_[word + 1]);
+}
+
+void RandomPhilox::gen_uniform_batch_(std::vector<double> * values) {
+  int index = 0;
+  const int num = static_cast<int>(values->size());
+  // finish the current block, if needed
+  if (num > 0 && (position_ & 1) == 1) {
+    (*values)[index++] = gen_uniform_();
+  }
+  while (index + 1 < num) {
+    compute_block_(position_ >> 1);
+    (*values)[index++] = to_double_(output_[0], output_[1]);
+    (*values)[index++] = to_double_(output_[2], output_[3]);
+    position_ += 2;
+  }
+  if (index < num) {
+    (*values)[index] = gen_uniform_();
+  }
+}
+
+std::shared_ptr<RandomPhilox> RandomPhilox::derive(
+    const uint64_t stream) const {
+  std::stringstream ss;
+  serialize(ss);
+  auto random = std::make_shared<RandomPhilox>(ss);
+  random->set_stream(stream);
+  return random;
+}
+
+void RandomPhilox::set_cache_to_load(const bool load) {
+  if (is_unloading_) {
+    key_ = resume_key_;
+    stream_ = resume_stream_;
+    position_ = resume_position_;
+    is_block_ = false;
+    is_unloading_ = false;
+  }
+  is_loading_ = load;
+  load_position_ = position_;
+}
+
+void RandomPhilox::set_cache_to_unload(const Random& random) {
+  if (random.class_name() == class_name_) {
+    const RandomPhilox& philox = static_cast<const RandomPhilox&>(random);
+    ASSERT(philox.is_loading_, "the given RandomPhilox is not loading");
+    resume_key_ = key_;
+    resume_stream_ = stream_;
+    resume_position_ = position_;
+    key_ = philox.key_;
+    stream_ = philox.stream_;
+    position_ = philox.load_position_;
+    is_block_ = false;
+    is_loading_ = false;
+    is_unloading_ = true;
+  } else {
+    Random::set_cache_to_unload(random);
+  }
+}
+
+void RandomPhilox::serialize(std::ostream& ostr) const {
+  ostr << class_name_ << " ";
+  serialize_random_(ostr);
+  feasst_serialize_version(3842, ostr);
+  feasst_serialize(key_, ostr);
+  feasst_serialize(stream_, ostr);
+  feasst_serialize(position_, ostr);
+  feasst_serialize(is_loading_, ostr);
+  feasst_serialize(is_unloading_, ostr);
+  feasst_serialize(load_position_, ostr);
+  feasst_serialize(resume_key_, ostr);
+  feasst_serialize(resume_stream_, ostr);
+  feasst_serialize(resume_position_, ostr);
+  feasst_serialize_endcap("RandomPhilox", ostr);
+}
+
+RandomPhilox::RandomPhilox(std::istream& istr)
+  : Random(istr) {
+  ASSERT(class_name_ == "RandomPhilox", "name: " << class_name_);
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(version == 3842, "version: " << version);
+  feasst_deserialize(&key_, istr);
+  feasst_deserialize(&stream_, istr);
+  feasst_deserialize(&position_, istr);
+  feasst_deserialize(&is_loading_, istr);
+  feasst_deserialize(&is_unloading_, istr);
+  feasst_deserialize(&load_position_, istr);
+  feasst_deserialize(&resume_key_, istr);
+  feasst_deserialize(&resume_stream_, istr);
+  feasst_deserialize(&resume_position_, istr);
+  feasst_deserialize_endcap("RandomPhilox", istr);
+}
+
+}  // namespace feasst
@@ -1,3 +1,4 @@
+#include <cmath>
 #include "utils/test/utils.h"
 #include "math/include/formula.h"
 #include "math/include/accumulator.h"
@@ -65,6 +66,63 @@ TEST(Accumulator, is_equivalent) {
   EXPECT_TRUE(a->is_equivalent(*b, 10, 1));
 }
 
+// The first block of each block size is the average of the first values.
+TEST(Accumulator, first_block) {
+  Accumulator acc;
+  for (int i = 0; i < 64; ++i) {
+    acc.accumulate(static_cast<double>(i));
+  }
+  int num_checked = 0;
+  for (int op = 0; op < acc.max_block_operations(); ++op) {
+    const int size = static_cast<int>(acc.block_size()[op] + 0.5);
+    if (static_cast<int>(acc.blocks()[op].size()) > 0) {
+      // the average of 0, 1, ..., size - 1
+      EXPECT_NEAR(0.5*(size - 1), acc.blocks()[op][0], NEAR_ZERO);
+      ++num_checked;
+    }
+  }
+  EXPECT_GT(num_checked, 1);
+}
+
+TEST(Accumulator, merge) {
+  Accumulator a, b, all;
+  for (int i = 0; i < 64; ++i) {
+    const double val = std::sin(static_cast<double>(i));
+    a.accumulate(val);
+    all.accumulate(val);
+  }
+  for (int i = 0; i < 64; ++i) {
+    const double val = 2.*std::cos(static_cast<double>(i));
+    b.accumulate(val);
+    all.accumulate(val);
+  }
+  a.merge(b);
+  EXPECT_EQ(all.num_values(), a.num_values());
+  EXPECT_NEAR(all.average(), a.average(), NEAR_ZERO);
+  EXPECT_NEAR(all.stdev(), a.stdev(), NEAR_ZERO);
+  EXPECT_NEAR(all.max(), a.max(), NEAR_ZERO);
+  EXPECT_NEAR(all.min(), a.min(), NEAR_ZERO);
+  for (int mo = 0; mo < all.num_moments(); ++mo) {
+    EXPECT_NEAR(all.moment(mo), a.moment(mo), 1e-10);
+  }
+
+  // blocks of equal size are combined in order
+  int num_compared = 0;
+  for (int op = 0; op < a.max_block_operations(); ++op) {
+    for (int op2 = 0; op2 < all.max_block_operations(); ++op2) {
+      if (a.block_size()[op] == all.block_size()[op2]) {
+        ASSERT_EQ(all.blocks()[op2].size(), a.blocks()[op].size());
+        for (int blk = 0; blk < static_cast<int>(a.blocks()[op].size()); ++blk) {
+          EXPECT_NEAR(all.blocks()[op2][blk], a.blocks()[op][blk], 1e-12);
+        }
+        EXPECT_NEAR(all.block_stdev(op2), a.block_stdev(op), 1e-12);
+        ++num_compared;
+      }
+    }
+  }
+  EXPECT_EQ(5, num_compared);
+}
+
 class Square : public Formula {
  public:
   double evaluate(const double y) const override { return y*y; }
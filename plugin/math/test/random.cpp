@@ -2,15 +2,17 @@
 #include <vector>
 #include <fstream>
 #include "utils/test/utils.h"
+#include "utils/include/cache.h"
 #include "math/include/random_modulo.h"
 #include "math/include/random_mt19937.h"
+#include "math/include/random_philox.h"
 #include "math/include/histogram.h"
 #include "math/include/accumulator.h"
 #include "math/include/matrix.h"
 
 namespace feasst {
 
-std::vector<std::shared_ptr<Random> > gens = {MakeRandomMT19937(), MakeRandomModulo()};
+std::vector<std::shared_ptr<Random> > gens = {MakeRandomMT19937(), MakeRandomModulo(), MakeRandomPhilox()};
 //std::vector<std::shared_ptr<Random> > gens = {MakeRandomModulo()};
 
 TEST(Random, uniform) {
@@ -175,6 +177,89 @@ TEST(RandomMT19937, serialize) {
   );
 }
 
+TEST(RandomPhilox, known_answer) {
+  // Random123 known answer tests for Philox4x32-10
+  uint32_t out[4];
+  const uint32_t ctr0[4] = {0, 0, 0, 0};
+  const uint32_t key0[2] = {0, 0};
+  philox4x32_10(ctr0, key0, out);
+  EXPECT_EQ(out[0], 0x6627e8d5u);
+  EXPECT_EQ(out[1], 0xe169c58du);
+  EXPECT_EQ(out[2], 0xbc57ac4cu);
+  EXPECT_EQ(out[3], 0x9b00dbd8u);
+  const uint32_t ctr1[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+  const uint32_t key1[2] = {0xffffffff, 0xffffffff};
+  philox4x32_10(ctr1, key1, out);
+  EXPECT_EQ(out[0], 0x408f276du);
+  EXPECT_EQ(out[1], 0x41c83b0eu);
+  EXPECT_EQ(out[2], 0xa20bc7c6u);
+  EXPECT_EQ(out[3], 0x6d5451fdu);
+  const uint32_t ctr2[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+  const uint32_t key2[2] = {0xa4093822, 0x299f31d0};
+  philox4x32_10(ctr2, key2, out);
+  EXPECT_EQ(out[0], 0xd16cfe09u);
+  EXPECT_EQ(out[1], 0x94fdccebu);
+  EXPECT_EQ(out[2], 0x5001e420u);
+  EXPECT_EQ(out[3], 0x24126ea1u);
+}
+
+TEST(RandomPhilox, jump_and_batch) {
+  auto random = MakeRandomPhilox({{"seed", "123"}});
+  std::vector<double> serial(101);
+  for (double& value : serial) {
+    value = random->uniform();
+    EXPECT_GE(value, 0.);
+    EXPECT_LT(value, 1.);
+  }
+  EXPECT_EQ(101, static_cast<int>(random->position()));
+
+  // jump ahead
+  auto jump = MakeRandomPhilox({{"seed", "123"}});
+  jump->jump(57);
+  EXPECT_EQ(serial[57], jump->uniform());
+  jump->set_position(3);
+  EXPECT_EQ(serial[3], jump->uniform());
+
+  // batch from an odd position
+  std::vector<double> batch;
+  jump->uniform(50, &batch);
+  for (int index = 0; index < 50; ++index) {
+    EXPECT_EQ(serial[4 + index], batch[index]);
+  }
+  EXPECT_EQ(serial[54], jump->uniform());
+
+  // derived streams are reproducible and differ from the original
+  auto stream1 = random->derive(1);
+  auto stream1b = jump->derive(1);
+  EXPECT_EQ(1, static_cast<int>(stream1->stream()));
+  const double first = stream1->uniform();
+  EXPECT_EQ(first, stream1b->uniform());
+  EXPECT_NE(first, serial[0]);
+}
+
+TEST(RandomPhilox, serialize) {
+  RandomPhilox random(argtype({{"stream", "4"}}));
+  random.seed_by_time();
+  random.uniform();
+  random.set_cache_to_load(true);
+  RandomPhilox random2 = test_serialize(random);
+  const double next = random.uniform();
+  const double next2 = random.uniform();
+  EXPECT_EQ(next, random2.uniform());
+  EXPECT_TRUE(random.cache().stored().empty());
+
+  // replay from a generator with a different seed and stream
+  RandomPhilox random3(argtype({{"seed", "1"}, {"stream", "2"}}));
+  const double own = random3.uniform();
+  RandomPhilox random4 = test_serialize(random3);
+  random3.set_cache_to_unload(random2);
+  EXPECT_EQ(next, random3.uniform());
+  EXPECT_EQ(next2, random3.uniform());
+  random3.set_cache_to_load(false);
+  EXPECT_EQ(random4.uniform(), random3.uniform());
+  EXPECT_NE(own, next);
+}
+
 TEST(Random, standard_normal) {
   for (std::shared_ptr<Random> random : gens) {
     random->seed_by_time();
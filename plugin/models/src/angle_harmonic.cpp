@@ -32,10 +32,12 @@ void AngleHarmonic::serialize(std::ostream& ostr) const {
 }
 
 double AngleHarmonic::energy(const double radians, const Bond& angle) const {
+  static const PropertyKey equilibrium_degrees_key("equilibrium_degrees");
+  static const PropertyKey k_energy_per_radian_sq_key("k_energy_per_radian_sq");
   DEBUG("radians " << radians);
   const double equil_radians =
-    degrees_to_radians(angle.property("equilibrium_degrees"));
-  const double k = angle.property("k_energy_per_radian_sq");
+    degrees_to_radians(angle.property(equilibrium_degrees_key));
+  const double k = angle.property(k_energy_per_radian_sq_key);
   double delta_rad = radians - equil_radians;
   DEBUG("delta_rad " << delta_rad);
   return k*delta_rad*delta_rad;
@@ -93,17 +95,20 @@ void AngleHarmonic::random_branch(
     const Position * const a2,
     const Position * const m1,
     const Position * const m2) const {
+  static const PropertyKey equilibrium_degrees_key("equilibrium_degrees");
+  static const PropertyKey k_energy_per_radian_sq_key("k_energy_per_radian_sq");
+  static const PropertyKey num_jacobian_gaussian_key("num_jacobian_gaussian");
   DEBUG("is_position_held " << is_position_held);
   // See PerturbBranch for a1, a2, m1, m2 definition
-  const double theta1_eq = degrees_to_radians(a2a1m1.property("equilibrium_degrees"));
-  const double theta2_eq = degrees_to_radians(a2a1m2.property("equilibrium_degrees"));
-  const double theta12_eq = degrees_to_radians(m1a1m2.property("equilibrium_degrees"));
-  const double k1 = a2a1m1.property("k_energy_per_radian_sq");
-  const double k2 = a2a1m2.property("k_energy_per_radian_sq");
-  const double k12 = m1a1m2.property("k_energy_per_radian_sq");
+  const double theta1_eq = degrees_to_radians(a2a1m1.property(equilibrium_degrees_key));
+  const double theta2_eq = degrees_to_radians(a2a1m2.property(equilibrium_degrees_key));
+  const double theta12_eq = degrees_to_radians(m1a1m2.property(equilibrium_degrees_key));
+  const double k1 = a2a1m1.property(k_energy_per_radian_sq_key);
+  const double k2 = a2a1m2.property(k_energy_per_radian_sq_key);
+  const double k12 = m1a1m2.property(k_energy_per_radian_sq_key);
   int num_jacobian_gaussian = 0;
-  if (m1a1m2.has_property("num_jacobian_gaussian")) {
-    num_jacobian_gaussian = round(m1a1m2.property("num_jacobian_gaussian"));
+  if (m1a1m2.has_property(num_jacobian_gaussian_key)) {
+    num_jacobian_gaussian = round(m1a1m2.property(num_jacobian_gaussian_key));
   }
   DEBUG("num_jacobian_gaussian " << num_jacobian_gaussian);
   if (num_jacobian_gaussian <= 0) {
@@ -30,8 +30,10 @@ void BondHarmonic::serialize(std::ostream& ostr) const {
 }
 
 double BondHarmonic::energy(const double distance, const Bond& bond) const {
-  const double k = bond.property("k_energy_per_length_sq");
-  const double l0 = bond.property("equilibrium_length");
+  static const PropertyKey k_energy_per_length_sq_key("k_energy_per_length_sq");
+  static const PropertyKey equilibrium_length_key("equilibrium_length");
+  const double k = bond.property(k_energy_per_length_sq_key);
+  const double l0 = bond.property(equilibrium_length_key);
   const double dl = distance - l0;
   const double en = k*dl*dl;
   DEBUG("bond harmonic " << en);
@@ -40,8 +42,10 @@ double BondHarmonic::energy(const double distance, const Bond& bond) const {
 
 double BondHarmonic::random_distance(const Bond& bond, const double beta,
     const int dimen, Random * random) const {
-  const double equilibrium_length = bond.property("equilibrium_length");
-  const double beta_k = beta*bond.property("k_energy_per_length_sq");
+  static const PropertyKey equilibrium_length_key("equilibrium_length");
+  static const PropertyKey k_energy_per_length_sq_key("k_energy_per_length_sq");
+  const double equilibrium_length = bond.property(equilibrium_length_key);
+  const double beta_k = beta*bond.property(k_energy_per_length_sq_key);
   const double sigma = std::sqrt(1./2./beta_k);
   const double max_length_dm1 = std::pow(equilibrium_length + 3.*sigma, dimen - 1);
   int attempt = 0;
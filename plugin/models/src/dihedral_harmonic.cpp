@@ -30,10 +30,12 @@ void DihedralHarmonic::serialize(std::ostream& ostr) const {
 }
 
 double DihedralHarmonic::energy(const double radians, const Bond& dihedral) const {
+  static const PropertyKey equilibrium_degrees_key("equilibrium_degrees");
+  static const PropertyKey k_energy_per_radian_sq_key("k_energy_per_radian_sq");
   DEBUG("radians " << radians);
   const double equil_radians =
-    degrees_to_radians(dihedral.property("equilibrium_degrees"));
-  const double k = dihedral.property("k_energy_per_radian_sq");
+    degrees_to_radians(dihedral.property(equilibrium_degrees_key));
+  const double k = dihedral.property(k_energy_per_radian_sq_key);
   double delta_rad = radians - equil_radians;
   DEBUG("delta_rad " << delta_rad);
   return k*delta_rad*delta_rad;
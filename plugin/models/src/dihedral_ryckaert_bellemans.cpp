@@ -30,10 +30,14 @@ void DihedralRyckaertBellemans::serialize(std::ostream& ostr) const {
 }
 
 double DihedralRyckaertBellemans::energy(const double radians, const Bond& dihedral) const {
-  const double c0 = dihedral.property("c0");
-  const double c1 = dihedral.property("c1");
-  const double c2 = dihedral.property("c2");
-  const double c3 = dihedral.property("c3");
+  static const PropertyKey c0_key("c0");
+  static const PropertyKey c1_key("c1");
+  static const PropertyKey c2_key("c2");
+  static const PropertyKey c3_key("c3");
+  const double c0 = dihedral.property(c0_key);
+  const double c1 = dihedral.property(c1_key);
+  const double c2 = dihedral.property(c2_key);
+  const double c3 = dihedral.property(c3_key);
   const double cosphi = std::cos(radians);
   const double en = c0 + cosphi*(c1 + cosphi*(c2 + cosphi*c3));
   ASSERT(!std::isnan(en) && !std::isinf(en), "en: " << en << " radians: "
@@ -30,10 +30,14 @@ void DihedralTraPPE::serialize(std::ostream& ostr) const {
 }
 
 double DihedralTraPPE::energy(const double radians, const Bond& dihedral) const {
-  const double c0 = dihedral.property("c0");
-  const double c1 = dihedral.property("c1");
-  const double c2 = dihedral.property("c2");
-  const double c3 = dihedral.property("c3");
+  static const PropertyKey c0_key("c0");
+  static const PropertyKey c1_key("c1");
+  static const PropertyKey c2_key("c2");
+  static const PropertyKey c3_key("c3");
+  const double c0 = dihedral.property(c0_key);
+  const double c1 = dihedral.property(c1_key);
+  const double c2 = dihedral.property(c2_key);
+  const double c3 = dihedral.property(c3_key);
   const double en = c0 + c1*(1. + std::cos(radians))
                        + c2*(1. - std::cos(2.*radians))
                        + c3*(1. + std::cos(3.*radians));
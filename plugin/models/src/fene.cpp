@@ -32,11 +32,13 @@ void FENE::serialize(std::ostream& ostr) const {
 double FENE::energy(
     const double distance,
     const Bond& bond) const {
-  const double R0 = bond.property("R0");
+  static const PropertyKey R0_key("R0");
+  static const PropertyKey k_energy_per_length_sq_key("k_energy_per_length_sq");
+  const double R0 = bond.property(R0_key);
   if (distance >= R0) {
     return NEAR_INFINITY;
   }
-  const double k = bond.property("k_energy_per_length_sq");
+  const double k = bond.property(k_energy_per_length_sq_key);
   return energy_fene(distance, k, R0);
 }
 
@@ -52,8 +54,10 @@ double FENE::energy_fene(const double distance, const double k,
 
 double FENE::random_distance(const Bond& bond, const double beta,
     const int dimen, Random * random) const {
-  const double R0 = bond.property("R0");
-  const double k = bond.property("k_energy_per_length_sq");
+  static const PropertyKey R0_key("R0");
+  static const PropertyKey k_energy_per_length_sq_key("k_energy_per_length_sq");
+  const double R0 = bond.property(R0_key);
+  const double k = bond.property(k_energy_per_length_sq_key);
   double jacobian = 0;
   const double max_length_dm1 = std::pow(R0, dimen - 1);
   int attempt = 0;
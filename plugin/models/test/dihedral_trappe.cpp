@@ -0,0 +1,79 @@
+#include "utils/test/utils.h"
+#include "configuration/include/particle.h"
+#include "configuration/include/select.h"
+#include "configuration/include/configuration.h"
+#include "system/include/bond_visitor.h"
+#include "models/include/angle_harmonic.h"
+#include "models/include/dihedral_trappe.h"
+
+namespace feasst {
+
+TEST(DihedralTraPPE, n_decane) {
+  auto config = MakeConfiguration({{"cubic_side_length", "40"},
+    {"particle_type", "decane:../particle/n-decane.txt"},
+    {"add_num_decane_particles", "1"}});
+  const Particle& part = config->particle(0);
+  const Particle& part_type = config->particle_type(0);
+  const Particle& unique = config->unique_type(0);
+  AngleHarmonic angle_harmonic;
+  DihedralTraPPE dihedral_trappe;
+  const BondThreeBody& angle_model = angle_harmonic;
+  const BondFourBody& dihedral_model = dihedral_trappe;
+  std::vector<double> angle_en, dihedral_en;
+  double angle_sum = 0., dihedral_sum = 0.;
+  for (const Angle& angle : part_type.angles()) {
+    angle_en.push_back(angle_model.energy(
+      part.site(angle.site(0)).position(),
+      part.site(angle.site(1)).position(),
+      part.site(angle.site(2)).position(), unique.angle(angle.type())));
+    angle_sum += angle_en.back();
+  }
+  for (const Dihedral& dihedral : part_type.dihedrals()) {
+    dihedral_en.push_back(dihedral_model.energy(
+      part.site(dihedral.site(0)).position(),
+      part.site(dihedral.site(1)).position(),
+      part.site(dihedral.site(2)).position(),
+      part.site(dihedral.site(3)).position(),
+      unique.dihedral(dihedral.type())));
+    dihedral_sum += dihedral_en.back();
+  }
+  BondVisitor visitor;
+  visitor.compute_all(*config);
+  EXPECT_NEAR(0., visitor.energy_two_body(), NEAR_ZERO);
+  EXPECT_NEAR(angle_sum, visitor.energy_three_body(), 1e-10);
+  EXPECT_NEAR(dihedral_sum, visitor.energy_four_body(), 1e-10);
+
+  // only the terms with a selected site at an end
+  Select select;
+  select.add_site(0, 0);
+  select.add_site(0, 4);
+  visitor.compute_all(select, *config);
+  EXPECT_NEAR(angle_en[0] + angle_en[2] + angle_en[4],
+              visitor.energy_three_body(), 1e-10);
+  EXPECT_NEAR(dihedral_en[0] + dihedral_en[1] + dihedral_en[4],
+              visitor.energy_four_body(), 1e-10);
+}
+
+// The compiled terms are not reused for a Configuration with other types.
+TEST(DihedralTraPPE, other_configuration) {
+  auto decane = MakeConfiguration({{"cubic_side_length", "40"},
+    {"particle_type", "decane:../particle/n-decane.txt"},
+    {"add_num_decane_particles", "1"}});
+  auto hexane = MakeConfiguration({{"cubic_side_length", "40"},
+    {"particle_type", "hexane:../particle/n-hexane.txt"},
+    {"add_num_hexane_particles", "1"}});
+  BondVisitor visitor, hexane_visitor;
+  hexane_visitor.compute_all(*hexane);
+  visitor.compute_all(*decane);
+  visitor.compute_all(*hexane);
+  EXPECT_NEAR(hexane_visitor.energy(), visitor.energy(), NEAR_ZERO);
+  EXPECT_NEAR(hexane_visitor.energy_four_body(), visitor.energy_four_body(),
+              NEAR_ZERO);
+  EXPECT_NE(decane->particle_types_revision(),
+            hexane->particle_types_revision());
+  Configuration copy = *hexane;
+  EXPECT_EQ(hexane->particle_types_revision(),
+            copy.particle_types_revision());
+}
+
+}  // namespace feasst
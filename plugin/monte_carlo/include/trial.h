@@ -239,6 +239,7 @@ class Trial {
   // temporary or duplicate
   std::shared_ptr<Acceptance> acceptance_;
   std::vector<TrialStage*> stages_ptr_;
+  int profile_section_ = -1;
 
   void refresh_stages_ptr_();
 };
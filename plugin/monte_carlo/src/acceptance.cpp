@@ -48,11 +48,17 @@ void Acceptance::reset() {
   macrostate_shift_[0] = 0;
   macrostate_shift_type_.resize(1);
   macrostate_shift_type_[0] = 0.;
-  perturbed_.clear();
+  // reuse the perturbed selections of the previous trial, if available,
+  // to retain their capacity.
   perturbed_.resize(3);  // maximum number of configs
-  perturbed_[0] = std::make_shared<Select>();
-  perturbed_[1] = std::make_shared<Select>();
-  perturbed_[2] = std::make_shared<Select>();
+  for (std::shared_ptr<Select>& perturbed : perturbed_) {
+    if (perturbed) {
+      perturbed->clear();
+      perturbed->set_trial_state();
+    } else {
+      perturbed = std::make_shared<Select>();
+    }
+  }
 }
 
 void Acceptance::add_to_perturbed(const Select& select, const int config) {
@@ -233,7 +239,7 @@ void Acceptance::set_macrostate_shift_type(const int type, const int config) {
 }
 
 void Acceptance::sort_perturbed() {
-  for (auto pert : perturbed_) {
+  for (std::shared_ptr<Select>& pert : perturbed_) {
     pert->sort();
   }
 }
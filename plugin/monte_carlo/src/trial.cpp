@@ -2,6 +2,7 @@
 #include <memory>
 #include "utils/include/arguments.h"
 #include "utils/include/serialize_extra.h"
+#include "utils/include/profiler.h"
 #include "math/include/random.h"
 #include "configuration/include/particle_factory.h"
 #include "configuration/include/configuration.h"
@@ -192,6 +193,10 @@ bool Trial::attempt(Criteria * criteria, System * system, Random * random) {
     //DEBUG("all: " << system->configuration(iconf).selection_of_all().str());
   }
   increment_num_attempts();
+  if (profile_section_ == -1) {
+    profile_section_ = Profiler::section(class_name());
+  }
+  ProfileScope profile_trial(profile_section_);
   if (!acceptance_) {
     acceptance_ = std::make_shared<Acceptance>(class_name());
   }
@@ -202,14 +207,17 @@ bool Trial::attempt(Criteria * criteria, System * system, Random * random) {
   // Perform selections. If one selection fails, do not continue selecting.
   //for (TrialStage * stage : stages_ptr_) {
   TrialSelect * previous_select = NULL;
-  for (int stg = 0; stg < num_stages(); ++stg) {
-    TrialStage * stage = stages_ptr_[stg];
-    stage->before_select();
-    if (stg > 0) {
-      previous_select = stages_ptr_[stg - 1]->get_trial_select();
-    }
-    if (!acceptance_->reject()) {
-      stage->select(system, acceptance_.get(), random, previous_select);
+  { static const int profile_select = Profiler::section("select");
+    ProfileScope profile(profile_select);
+    for (int stg = 0; stg < num_stages(); ++stg) {
+      TrialStage * stage = stages_ptr_[stg];
+      stage->before_select();
+      if (stg > 0) {
+        previous_select = stages_ptr_[stg - 1]->get_trial_select();
+      }
+      if (!acceptance_->reject()) {
+        stage->select(system, acceptance_.get(), random, previous_select);
+      }
     }
   }
   if (acceptance_->reject()) {
@@ -226,11 +234,18 @@ bool Trial::attempt(Criteria * criteria, System * system, Random * random) {
     DEBUG("auto reject");
     *num_auto_reject_() += 1;
   }
-  if (criteria->is_accepted(*system, acceptance_.get(), random)) {
+  bool is_accepted;
+  { static const int profile_criteria = Profiler::section("criteria");
+    ProfileScope profile(profile_criteria);
+    is_accepted = criteria->is_accepted(*system, acceptance_.get(), random);
+  }
+  if (is_accepted) {
     DEBUG("accepted");
     increment_num_success_();
     DEBUG("is_finalize_delayed_ " << is_finalize_delayed_);
     if (!is_finalize_delayed_) {
+      static const int profile_finalize = Profiler::section("finalize");
+      ProfileScope profile(profile_finalize);
       finalize(system, criteria);
     }
     return true;
@@ -46,7 +46,7 @@ void TrialComputeTranslate::perturb_and_acceptance(
     // compute rosenbluth of new first
     compute_rosenbluth(0, criteria, system, acceptance, stages, random);
     if (first_stage->rosenbluth().chosen_step() != -1) {
-      new_ = std::make_shared<Select>(first_stage->rosenbluth().chosen());
+      *new_ = first_stage->rosenbluth().chosen();
       DEBUG("new " << new_->str() << " " << new_->site_positions()[0][0].str());
       // midstage will set new position as anchor
       for (TrialStage * stage : *stages) stage->mid_stage(system);
@@ -84,7 +84,7 @@ TrialComputeTranslate::TrialComputeTranslate(std::istream& istr)
   : TrialCompute(istr) {
   const int version = feasst_deserialize_version(istr);
   ASSERT(8958 == version, "mismatch version: " << version);
-  new_ = std::shared_ptr<Select>();
+  new_ = std::make_shared<Select>();
 }
 
 void TrialComputeTranslate::serialize_trial_compute_translate_(std::ostream& ostr) const {
@@ -278,7 +278,7 @@ bool TrialSelect::is_isotropic(const System * system) const {
 }
 
 void TrialSelect::set_mobile_original(const System * system) {
-  mobile_original_ = std::make_shared<Select>(*mobile_);
+  *mobile_original_ = *mobile_;
   DEBUG("is system isotropic? " << is_isotropic(system));
   if (!is_isotropic(system)) {
     const Configuration& config = configuration(*system);
@@ -355,12 +355,12 @@ const Select& TrialSelect::mobile() const { return *mobile_; }
 
 Select * TrialSelect::get_mobile() { return mobile_.get(); }
 
-void TrialSelect::set_mobile(const Select& mobile) { mobile_ = std::make_shared<Select>(mobile); }
+void TrialSelect::set_mobile(const Select& mobile) { *mobile_ = mobile; }
 
 const Select& TrialSelect::mobile_original() const { return *mobile_original_; }
 
 void TrialSelect::set_trial_state(const int state) { mobile_->set_trial_state(state); }
 
-void TrialSelect::reset_mobile() { mobile_ = std::make_shared<Select>(*mobile_original_); }
+void TrialSelect::reset_mobile() { *mobile_ = *mobile_original_; }
 
 }  // namespace feasst
@@ -1,6 +1,7 @@
 #include <cmath>
 #include "utils/include/serialize.h"
 #include "utils/include/arguments.h"
+#include "utils/include/profiler.h"
 #include "configuration/include/configuration.h"
 #include "system/include/thermo_params.h"
 #include "system/include/system.h"
@@ -101,7 +102,10 @@ void TrialStage::attempt(System * system,
 
   if (rosenbluth_->num() == 1) {
     select_->zero_exclude_energy();
-    perturb_->perturb(system, select_.get(), random, old, acceptance);
+    { static const int profile_perturb = Profiler::section("perturb");
+      ProfileScope profile(profile_perturb);
+      perturb_->perturb(system, select_.get(), random, old, acceptance);
+    }
     set_rosenbluth_energy_(0, system);
     rosenbluth_->compute(system->thermo_params().beta(), random, old);
   } else {
@@ -110,7 +114,11 @@ void TrialStage::attempt(System * system,
       bool is_position_held = false;
       if (step == 0 && old == 1) is_position_held = true;
       select_->zero_exclude_energy();
-      perturb_->perturb(system, select_.get(), random, is_position_held, acceptance);
+      { static const int profile_perturb = Profiler::section("perturb");
+        ProfileScope profile(profile_perturb);
+        perturb_->perturb(system, select_.get(), random, is_position_held,
+                          acceptance);
+      }
       DEBUG("updating state " << select_->mobile().trial_state());
       rosenbluth_->store(step, select_->mobile());
       DEBUG("ref " << reference_);
@@ -18,6 +18,9 @@
 #include "system/include/potential.h"
 #include "system/include/visit_model_inner.h"
 #include "monte_carlo/include/trial.h"
+#include "monte_carlo/include/trial_stage.h"
+#include "monte_carlo/include/trial_select.h"
+#include "monte_carlo/include/acceptance.h"
 #include "monte_carlo/include/monte_carlo.h"
 #include "monte_carlo/include/metropolis.h"
 #include "monte_carlo/include/constrain_num_particles.h"
@@ -327,6 +330,27 @@ TEST(MonteCarlo, lj_npt) {
   DEBUG("volume: " << vol.average() << " +/- " << vol.block_stdev());
 }
 
+TEST(MonteCarlo, dimer_npt_cell) {
+  auto mc = MakeMonteCarlo({{
+    {"Configuration", {{"cubic_side_length", "12"},
+      {"particle_type", "dimer:../particle/dimer.txt"}, {"cutoff", "2"}}},
+    {"Potential", {{"Model", "LennardJones"}, {"VisitModel", "VisitModelCell"},
+                   {"min_length", "2"}}},
+    {"ThermoParams", {{"beta", "1"}, {"pressure", "0.05"},
+                      {"chemical_potential", "-1"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{}}},
+    {"TrialRotate", {{}}},
+    {"CheckEnergy", {{"trials_per_update", "1"}, {"tolerance", "1e-8"}}},
+    {"TrialAdd", {{"particle_type", "dimer"}}},
+    {"Run", {{"until_num_particles", "20"}}},
+    {"Remove", {{"name", "TrialAdd"}}},
+    {"TrialVolume", {{"tunable_param", "0.1"}}},
+  }}, true);
+  mc->attempt(2e2);
+  EXPECT_EQ(20, mc->configuration().num_particles());
+}
+
 TEST(MonteCarlo, arglist_unrecognized) {
   TRY(
     MakeMonteCarlo({{{"Banana", {{}}}}}, true);
@@ -646,4 +670,29 @@ TEST(MonteCarlo, rotate2d) {
   }
 }
 
+// Trials reuse their selections instead of constructing new ones.
+TEST(MonteCarlo, reuse_select) {
+  auto mc = MakeMonteCarlo({{
+    {"Configuration", {{"cubic_side_length", "8"}, {"particle_type", "lj:../particle/lj_new.txt"},
+      {"add_particles_of_type0", "20"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", "1.2"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "1."}}},
+  }}, true);
+  mc->attempt(10);
+  const Select * mobile = &mc->trial(0).stage(0).select().mobile();
+  const Select * original = &mc->trial(0).stage(0).select().mobile_original();
+  const Select * perturbed = &mc->trial(0).accept().perturbed(0);
+  Select::reset_num_constructed();
+  mc->attempt(1e3);
+  EXPECT_EQ(mobile, &mc->trial(0).stage(0).select().mobile());
+  EXPECT_EQ(original, &mc->trial(0).stage(0).select().mobile_original());
+  EXPECT_EQ(perturbed, &mc->trial(0).accept().perturbed(0));
+  EXPECT_EQ(20, mc->configuration().num_particles());
+#ifdef FEASST_VISIT_COUNTERS
+  EXPECT_EQ(0, Select::num_constructed());
+#endif  // FEASST_VISIT_COUNTERS
+}
+
 }  // namespace feasst
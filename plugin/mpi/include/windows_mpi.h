@@ -0,0 +1,166 @@
+#ifndef FEASST_MPI_WINDOWS_MPI_H_
+#define FEASST_MPI_WINDOWS_MPI_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/include/arguments.h"
+#include "flat_histogram/include/ln_probability.h"
+
+namespace feasst {
+
+class MonteCarlo;
+class Random;
+class ThreadMPI;
+class Window;
+
+/**
+  Run FlatHistogram windows distributed over MPI processes (ranks), which may
+  span many nodes, in contrast with Clones and CollectionMatrixSplice which are
+  limited to the OMP threads of a single node.
+
+  Window w is owned by rank w % num_ranks, such that each rank may own more
+  than one window.
+  The MonteCarlo of each window is constructed on its rank from the same input,
+  where "[soft_macro_min]" and "[soft_macro_max]" are replaced by the
+  boundaries of the Window and "[sim_index]" is replaced by the window index.
+  As with Clones, each window has its own macrostate Histogram (e.g., the
+  boundaries are the min and max of the Histogram), and neighboring windows
+  must overlap by at least one macrostate.
+
+  Each rank runs its windows for hours_per, then all ranks exchange:
+
+  - A window whose Configuration is not within its macrostate range waits for
+    its lower neighbor to reach the overlap, and then receives the
+    Configuration of the lower neighbor (e.g., bottom up initialization as in
+    Clones::initialize).
+    Thus, the first window must begin within its range.
+  - If configuration_swaps, neighboring windows whose current macrostates are
+    both within the overlap of the two windows attempt to swap
+    Configurations.
+    Swaps are accepted with probability
+    min(1, exp(lnpi_i(m_i) - lnpi_i(m_j) + lnpi_j(m_j) - lnpi_j(m_i)))
+    where lnpi_i is the LnProbability of the Bias of window i and m_i is the
+    macrostate of window i.
+    Even and odd pairs of neighbors alternate between exchanges.
+    All ranks draw the same random numbers, such that no further communication
+    is required to decide acceptance.
+  - Each window sends its FlatHistogram to rank 0, which stitches the
+    LnProbability (see stitch_ln_prob) and writes ln_prob_file.
+
+  The exchanges repeat until all windows are complete.
+  Each window should Checkpoint and write its output files independently,
+  using "[sim_index]" in the file names.
+
+  For example, the feasst_mpi executable reads the following text file,
+  input.txt:
+
+  WindowsMPI hours_per 0.01 ln_prob_file ln_prob.txt
+  WindowExponential maximum 370 minimum 0 num 128 overlap 1 alpha 1.75
+  RandomMT19937 seed time
+  ...
+  FlatHistogram Macrostate MacrostateNumParticles width 1 max [soft_macro_max] min [soft_macro_min] Bias TransitionMatrix min_sweeps 100
+  Checkpoint checkpoint_file checkpoint[sim_index].fst num_hours 1
+
+  mpirun -np 64 feasst_mpi input.txt
+ */
+class WindowsMPI {
+ public:
+  //@{
+  /** @name Arguments
+    - hours_per: hours each window runs between exchanges (default: 0.01).
+    - ln_prob_file: if not empty, rank 0 writes the stitched ln_prob to this
+      file after each exchange, once all windows are initialized
+      (default: empty).
+    - configuration_swaps: if true, attempt swaps of Configurations between
+      overlapping windows (default: true).
+    - seed: seed of the random numbers for the swaps, which is the same on all
+      ranks (default: 1346867550).
+   */
+  explicit WindowsMPI(argtype args = argtype());
+  explicit WindowsMPI(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Construct the windows owned by this rank from the MonteCarlo arguments.
+  void initialize(const arglist& args, const Window& window);
+
+  /**
+    Perform one exchange of boundary configurations, configuration swaps and
+    ln_prob between all windows, as described above.
+    Return true if all windows are complete.
+   */
+  bool exchange();
+
+  /// Initialize, then run and exchange until all windows are complete.
+  void run(const arglist& args, const Window& window);
+
+  /// Return the rank of this process.
+  int rank() const;
+
+  /// Return the number of ranks.
+  int num_ranks() const;
+
+  /// Return the number of windows.
+  int num_windows() const { return static_cast<int>(windows_.size()); }
+
+  /// Return the rank that owns the window.
+  int owner(const int window) const { return window % num_ranks(); }
+
+  /// Return true if the window is owned by this rank.
+  bool is_owned(const int window) const { return owner(window) == rank(); }
+
+  /// Return the window, which must be owned by this rank.
+  const MonteCarlo& window(const int index) const;
+
+  /// Return true if the window is initialized.
+  bool is_initialized(const int window) const {
+    return is_initialized_[window] == 1; }
+
+  /// Return the number of attempted swaps between window and window + 1.
+  int num_swaps_attempted(const int window) const {
+    return swaps_attempted_[window]; }
+
+  /// Return the number of accepted swaps between window and window + 1.
+  int num_swaps_accepted(const int window) const {
+    return swaps_accepted_[window]; }
+
+  /// Return the stitched LnProbability of the most recent exchange.
+  /// Only available on rank 0.
+  const LnProbability& ln_prob() const { return ln_prob_; }
+
+  ~WindowsMPI();
+
+  //@}
+ private:
+  double hours_per_;
+  std::string ln_prob_file_;
+  bool configuration_swaps_;
+  std::shared_ptr<ThreadMPI> thread_;
+  std::shared_ptr<Random> random_;
+  std::vector<std::shared_ptr<MonteCarlo> > windows_;
+  std::vector<double> range_min_;
+  std::vector<double> range_max_;
+  std::vector<int> is_initialized_;
+  std::vector<int> swaps_attempted_;
+  std::vector<int> swaps_accepted_;
+  int parity_ = 0;
+  LnProbability ln_prob_;
+
+  bool in_range_(const double value, const int window) const;
+  double window_ln_prob_(const int window, const double value) const;
+  void transfer_(const int from, const int to);
+  void swap_(const int lower, const int upper);
+  void stitch_();
+};
+
+inline std::shared_ptr<WindowsMPI> MakeWindowsMPI(argtype args = argtype()) {
+  return std::make_shared<WindowsMPI>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_MPI_WINDOWS_MPI_H_
@@ -0,0 +1,299 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "mpi.h"
+#include "utils/include/arguments.h"
+#include "utils/include/arguments_extra.h"
+#include "utils/include/debug.h"
+#include "utils/include/io.h"
+#include "utils/include/max_precision.h"
+#include "math/include/histogram.h"
+#include "math/include/random_mt19937.h"
+#include "math/include/utils_math.h"
+#include "configuration/include/configuration.h"
+#include "monte_carlo/include/acceptance.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "flat_histogram/include/bias.h"
+#include "flat_histogram/include/macrostate.h"
+#include "flat_histogram/include/flat_histogram.h"
+#include "flat_histogram/include/window.h"
+#include "flat_histogram/include/clones.h"
+#include "actions/include/run.h"
+#include "mpi/include/thread_mpi.h"
+#include "mpi/include/windows_mpi.h"
+
+namespace feasst {
+
+WindowsMPI::WindowsMPI(argtype * args) {
+  hours_per_ = dble("hours_per", args, 0.01);
+  ln_prob_file_ = str("ln_prob_file", args, "");
+  configuration_swaps_ = boolean("configuration_swaps", args, true);
+  random_ = MakeRandomMT19937({{"seed", str(integer("seed", args, 1346867550))}});
+  thread_ = MakeThreadMPI();
+}
+WindowsMPI::WindowsMPI(argtype args) : WindowsMPI(&args) {
+  feasst_check_all_used(args);
+}
+WindowsMPI::~WindowsMPI() {}
+
+int WindowsMPI::rank() const { return thread_->thread(); }
+int WindowsMPI::num_ranks() const { return thread_->num(); }
+
+const MonteCarlo& WindowsMPI::window(const int index) const {
+  ASSERT(index < num_windows(), "index: " << index << " >= num: "
+    << num_windows());
+  ASSERT(is_owned(index), "window: " << index << " is owned by rank: "
+    << owner(index) << " instead of rank: " << rank());
+  return *windows_[index];
+}
+
+// Sum the data over all ranks.
+static void allreduce_sum_(std::vector<double> * data) {
+  MPI_Allreduce(MPI_IN_PLACE, data->data(), static_cast<int>(data->size()),
+                MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+}
+
+static void send_string_(const std::string& data, const int rank,
+                         const int tag) {
+  int size = static_cast<int>(data.size());
+  MPI_Send(&size, 1, MPI_INT, rank, tag, MPI_COMM_WORLD);
+  MPI_Send(data.data(), size, MPI_CHAR, rank, tag, MPI_COMM_WORLD);
+}
+
+static std::string recv_string_(const int rank, const int tag) {
+  int size;
+  MPI_Recv(&size, 1, MPI_INT, rank, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  std::string data(size, ' ');
+  MPI_Recv(&data[0], size, MPI_CHAR, rank, tag, MPI_COMM_WORLD,
+           MPI_STATUS_IGNORE);
+  return data;
+}
+
+static std::string sendrecv_string_(const std::string& data, const int rank,
+                                    const int tag) {
+  int size = static_cast<int>(data.size());
+  int other_size;
+  MPI_Sendrecv(&size, 1, MPI_INT, rank, tag,
+               &other_size, 1, MPI_INT, rank, tag,
+               MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  std::string other(other_size, ' ');
+  MPI_Sendrecv(data.data(), size, MPI_CHAR, rank, tag,
+               &other[0], other_size, MPI_CHAR, rank, tag,
+               MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  return other;
+}
+
+// Return the current value of the macrostate of the window.
+static double macrostate_value_(const MonteCarlo& mc) {
+  return const_cast<Macrostate&>(mc.criteria().macrostate()).value(
+    mc.system(), mc.criteria(), Acceptance());
+}
+
+static std::string serialize_configuration_(const MonteCarlo& mc) {
+  std::stringstream ss;
+  mc.configuration().serialize(ss);
+  return ss.str();
+}
+
+// Replace all particles of the window with those of the serialized
+// Configuration.
+static void replace_configuration_(const std::string& data, MonteCarlo * mc) {
+  std::stringstream ss(data);
+  replace_configuration(Configuration(ss), mc);
+}
+
+void WindowsMPI::initialize(const arglist& args, const Window& window) {
+  const int num = window.num();
+  const std::vector<std::vector<int> > bounds = window.boundaries();
+  windows_.clear();
+  windows_.resize(num);
+  range_min_.assign(num, 0.);
+  range_max_.assign(num, 0.);
+  swaps_attempted_.assign(num, 0);
+  swaps_accepted_.assign(num, 0);
+  std::vector<double> initialized(num, 0.);
+  for (int index = 0; index < num; ++index) {
+    if (is_owned(index)) {
+      arglist list = args;
+      replace_value("[soft_macro_min]", str(bounds[index][0]), &list);
+      replace_value("[soft_macro_max]", str(bounds[index][1]), &list);
+      replace_in_value("[sim_index]", sized_int_to_str(index, num), &list);
+      windows_[index] = std::make_shared<MonteCarlo>(list);
+      const Macrostate& macro = windows_[index]->criteria().macrostate();
+      range_min_[index] = macro.value(0);
+      range_max_[index] = macro.histogram().center_of_last_bin();
+      if (in_range_(macrostate_value_(*windows_[index]), index)) {
+        initialized[index] = 1.;
+      }
+    }
+  }
+  allreduce_sum_(&range_min_);
+  allreduce_sum_(&range_max_);
+  allreduce_sum_(&initialized);
+  is_initialized_.assign(num, 0);
+  for (int index = 0; index < num; ++index) {
+    is_initialized_[index] = static_cast<int>(initialized[index]);
+  }
+  ASSERT(is_initialized_[0] == 1,
+    "The first window must begin within its macrostate range");
+  parity_ = 0;
+}
+
+bool WindowsMPI::in_range_(const double value, const int window) const {
+  return is_in_interval(value, range_min_[window], range_max_[window]);
+}
+
+double WindowsMPI::window_ln_prob_(const int window,
+                                   const double value) const {
+  const FlatHistogram& fh = windows_[window]->criteria().flat_histogram();
+  return fh.bias().ln_prob().value(fh.macrostate().histogram().bin(value));
+}
+
+void WindowsMPI::transfer_(const int from, const int to) {
+  DEBUG("transfer configuration from window " << from << " to " << to);
+  if (is_owned(from) && is_owned(to)) {
+    replace_configuration_(serialize_configuration_(*windows_[from]),
+                           windows_[to].get());
+  } else if (is_owned(from)) {
+    send_string_(serialize_configuration_(*windows_[from]), owner(to), to);
+  } else if (is_owned(to)) {
+    replace_configuration_(recv_string_(owner(from), to), windows_[to].get());
+  }
+}
+
+void WindowsMPI::swap_(const int lower, const int upper) {
+  DEBUG("swap configurations of windows " << lower << " and " << upper);
+  if (is_owned(lower) && is_owned(upper)) {
+    const std::string lower_config = serialize_configuration_(*windows_[lower]);
+    replace_configuration_(serialize_configuration_(*windows_[upper]),
+                           windows_[lower].get());
+    replace_configuration_(lower_config, windows_[upper].get());
+  } else if (is_owned(lower)) {
+    replace_configuration_(sendrecv_string_(
+      serialize_configuration_(*windows_[lower]), owner(upper), upper),
+      windows_[lower].get());
+  } else if (is_owned(upper)) {
+    replace_configuration_(sendrecv_string_(
+      serialize_configuration_(*windows_[upper]), owner(lower), upper),
+      windows_[upper].get());
+  }
+}
+
+void WindowsMPI::stitch_() {
+  std::vector<std::unique_ptr<FlatHistogram> > fhs;
+  for (int index = 0; index < num_windows(); ++index) {
+    std::string data;
+    if (is_owned(index)) {
+      std::stringstream ss;
+      windows_[index]->criteria().serialize(ss);
+      data = ss.str();
+      if (rank() != 0) {
+        send_string_(data, 0, index);
+      }
+    } else if (rank() == 0) {
+      data = recv_string_(owner(index), index);
+    }
+    if (rank() == 0) {
+      std::stringstream ss(data);
+      fhs.push_back(std::make_unique<FlatHistogram>(ss));
+    }
+  }
+  if (rank() == 0) {
+    ln_prob_ = stitch_ln_prob(fhs);
+    if (!ln_prob_file_.empty()) {
+      std::ofstream file(ln_prob_file_);
+      for (const double value : ln_prob_.values()) {
+        file << MAX_PRECISION << value << std::endl;
+      }
+    }
+  }
+}
+
+bool WindowsMPI::exchange() {
+  const int num = num_windows();
+  // share the macrostate and completion of each window with all ranks.
+  std::vector<double> value(num, 0.), complete(num, 0.);
+  for (int index = 0; index < num; ++index) {
+    if (is_owned(index) && is_initialized_[index] == 1) {
+      value[index] = macrostate_value_(*windows_[index]);
+      if (windows_[index]->criteria().is_complete()) complete[index] = 1.;
+    }
+  }
+  allreduce_sum_(&value);
+  allreduce_sum_(&complete);
+
+  // send boundary configurations from the lower neighbor, if in range.
+  for (int index = 1; index < num; ++index) {
+    if (is_initialized_[index] == 0 && is_initialized_[index - 1] == 1 &&
+        in_range_(value[index - 1], index)) {
+      transfer_(index - 1, index);
+      is_initialized_[index] = 1;
+      value[index] = value[index - 1];
+    }
+  }
+
+  // swap configurations of overlapping neighbors.
+  if (configuration_swaps_) {
+    std::vector<int> pairs;
+    for (int lower = parity_; lower < num - 1; lower += 2) {
+      if (is_initialized_[lower] == 1 && is_initialized_[lower + 1] == 1 &&
+          in_range_(value[lower], lower + 1) &&
+          in_range_(value[lower + 1], lower)) {
+        pairs.push_back(lower);
+      }
+    }
+    parity_ = 1 - parity_;
+    std::vector<double> delta(2*num, 0.);
+    for (const int lower : pairs) {
+      const int upper = lower + 1;
+      if (is_owned(lower)) {
+        delta[2*lower] = window_ln_prob_(lower, value[upper])
+                       - window_ln_prob_(lower, value[lower]);
+      }
+      if (is_owned(upper)) {
+        delta[2*lower + 1] = window_ln_prob_(upper, value[lower])
+                           - window_ln_prob_(upper, value[upper]);
+      }
+    }
+    allreduce_sum_(&delta);
+    for (const int lower : pairs) {
+      ++swaps_attempted_[lower];
+      const double ln_accept = -delta[2*lower] - delta[2*lower + 1];
+      if (random_->uniform() < std::exp(ln_accept)) {
+        swap_(lower, lower + 1);
+        ++swaps_accepted_[lower];
+      }
+    }
+  }
+
+  bool all_initialized = true;
+  bool all_complete = true;
+  for (int index = 0; index < num; ++index) {
+    if (is_initialized_[index] == 0) all_initialized = false;
+    if (complete[index] == 0.) all_complete = false;
+  }
+  if (all_initialized && (!ln_prob_file_.empty() || all_complete)) {
+    stitch_();
+  }
+  return all_initialized && all_complete;
+}
+
+void WindowsMPI::run(const arglist& args, const Window& window) {
+  initialize(args, window);
+  bool complete = false;
+  while (!complete) {
+    for (int index = 0; index < num_windows(); ++index) {
+      if (is_owned(index) && is_initialized_[index] == 1) {
+        MakeRun({{"for_hours", str(hours_per_)}})->run(windows_[index].get());
+      }
+    }
+    complete = exchange();
+  }
+  for (int index = 0; index < num_windows(); ++index) {
+    if (is_owned(index)) {
+      windows_[index]->write_to_file();
+    }
+  }
+}
+
+}  // namespace feasst
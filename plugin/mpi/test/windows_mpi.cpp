@@ -0,0 +1,77 @@
+#include "utils/test/utils.h"
+#include "monte_carlo/include/criteria.h"
+#include "configuration/include/configuration.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "flat_histogram/include/window_exponential.h"
+#include "mpi/include/windows_mpi.h"
+
+namespace feasst {
+
+// Initialize two windows and exchange once without running trials.
+TEST(WindowsMPI, initialize) {
+  WindowsMPI windows({{"seed", "123"}, {"configuration_swaps", "true"}});
+  WindowExponential window({{"minimum", "0"}, {"maximum", "6"},
+    {"num", "2"}, {"overlap", "1"}, {"alpha", "1"}});
+  windows.initialize({
+    {"RandomMT19937", {{"seed", "1234"}}},
+    {"Configuration", {{"cubic_side_length", "8"}, {"particle_type", "../particle/lj.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "-2"}}},
+    {"FlatHistogram", {{"Macrostate", "MacrostateNumParticles"},
+      {"width", "1"}, {"max", "[soft_macro_max]"}, {"min", "[soft_macro_min]"},
+      {"Bias", "TransitionMatrix"}}},
+    {"TrialTransfer", {{"particle_type", "0"}}},
+  }, window);
+  EXPECT_EQ(2, windows.num_windows());
+  for (int index = 0; index < windows.num_windows(); ++index) {
+    EXPECT_EQ(index % windows.num_ranks(), windows.owner(index));
+  }
+  if (windows.is_owned(1)) {
+    EXPECT_EQ(0, windows.window(1).configuration().num_particles());
+  }
+  // the empty Configuration is only within the range of the first window
+  EXPECT_TRUE(windows.is_initialized(0));
+  EXPECT_FALSE(windows.is_initialized(1));
+  EXPECT_FALSE(windows.exchange());
+  EXPECT_FALSE(windows.is_initialized(1));
+  EXPECT_EQ(0, windows.num_swaps_attempted(0));
+}
+
+TEST(WindowsMPI, lj_LONG) {
+  WindowsMPI windows({{"hours_per", "0.00001"}, {"seed", "123"},
+    {"ln_prob_file", "tmp/windows_mpi_lnpi.txt"}});
+  WindowExponential window({{"minimum", "0"}, {"maximum", "8"},
+    {"num", "3"}, {"overlap", "2"}, {"alpha", "1"}});
+  windows.run({
+    {"RandomMT19937", {{"seed", "1234"}}},
+    {"Configuration", {{"cubic_side_length", "8"}, {"particle_type", "../particle/lj.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", str(1./1.5)}, {"chemical_potential", "-2.352321"}}},
+    {"FlatHistogram", {{"Macrostate", "MacrostateNumParticles"},
+      {"width", "1"}, {"max", "[soft_macro_max]"}, {"min", "[soft_macro_min]"},
+      {"Bias", "TransitionMatrix"}, {"min_sweeps", "10"}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialTransfer", {{"particle_type", "0"}, {"weight", "4"}}},
+    {"CriteriaUpdater", {{"trials_per_update", "1e2"}}},
+  }, window);
+  EXPECT_EQ(3, windows.num_windows());
+  int num_accepted = 0;
+  for (int index = 0; index < windows.num_windows(); ++index) {
+    EXPECT_TRUE(windows.is_initialized(index));
+    if (windows.is_owned(index)) {
+      EXPECT_TRUE(windows.window(index).criteria().is_complete());
+    }
+    if (index < windows.num_windows() - 1) {
+      EXPECT_GE(windows.num_swaps_attempted(index),
+                windows.num_swaps_accepted(index));
+      num_accepted += windows.num_swaps_accepted(index);
+    }
+  }
+  EXPECT_GT(num_accepted, 0);
+  if (windows.rank() == 0) {
+    EXPECT_EQ(9, windows.ln_prob().size());
+    EXPECT_NEAR(1., windows.ln_prob().sum_probability(), 1e-8);
+  }
+}
+
+}  // namespace feasst
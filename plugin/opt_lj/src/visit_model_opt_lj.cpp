@@ -6,6 +6,7 @@
 #include "configuration/include/domain.h"
 #include "configuration/include/configuration.h"
 #include "system/include/visit_model_inner.h"
+#include "system/include/visit_counters.h"
 #include "opt_lj/include/visit_model_opt_lj.h"
 
 namespace feasst {
@@ -68,8 +69,10 @@ void VisitModelOptLJ::compute(
             dz = zi - coord2[2];
             dz -= lz*std::rint(dz/lz);
             const double squared_distance = dx*dx + dy*dy + dz*dz;
+            FEASST_VISIT_COUNT(pairs_tested);
             const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
             if (squared_distance <= cutoff*cutoff) {
+              FEASST_VISIT_COUNT(pairs_in_cutoff);
 //                  const double en = lj_.energy(squared_distance,
 //                    type1,
 //                    type2,
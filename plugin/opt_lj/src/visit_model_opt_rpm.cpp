@@ -9,6 +9,7 @@
 #include "configuration/include/configuration.h"
 #include "configuration/include/physical_constants.h"
 #include "system/include/visit_model_inner.h"
+#include "system/include/visit_counters.h"
 #include "opt_lj/include/visit_model_opt_rpm.h"
 
 namespace feasst {
@@ -83,8 +84,10 @@ void VisitModelOptRPM::compute(
               dz -= lz*std::rint(dz/lz);
               pbc.set_coord(2, dz);
               const double squared_distance = dx*dx + dy*dy + dz*dz;
+              FEASST_VISIT_COUNT(pairs_tested);
               const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
               if (squared_distance <= cutoff*cutoff) {
+                FEASST_VISIT_COUNT(pairs_in_cutoff);
                 const double sigma = model_params.select(sigma_index()).mixed_values()[type1][type2];
                 if (squared_distance <= sigma*sigma) {
                   set_energy(NEAR_INFINITY);
@@ -140,8 +143,10 @@ void VisitModelOptRPM::compute(
               dz -= lz*std::rint(dz/lz);
               pbc.set_coord(2, dz);
               const double squared_distance = dx*dx + dy*dy + dz*dz;
+              FEASST_VISIT_COUNT(pairs_tested);
               const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
               if (squared_distance <= cutoff*cutoff) {
+                FEASST_VISIT_COUNT(pairs_in_cutoff);
                 const double sigma = model_params.select(sigma_index()).mixed_values()[type1][type2];
                 if (squared_distance <= sigma*sigma) {
                   set_energy(NEAR_INFINITY);
@@ -196,8 +201,10 @@ void VisitModelOptRPM::compute(
               dz -= lz*std::rint(dz/lz);
               pbc.set_coord(2, dz);
               const double squared_distance = dx*dx + dy*dy + dz*dz;
+              FEASST_VISIT_COUNT(pairs_tested);
               const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
               if (squared_distance <= cutoff*cutoff) {
+                FEASST_VISIT_COUNT(pairs_in_cutoff);
                 const double sigma = model_params.select(sigma_index()).mixed_values()[type1][type2];
                 if (squared_distance <= sigma*sigma) {
                   set_energy(NEAR_INFINITY);
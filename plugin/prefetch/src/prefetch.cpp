@@ -7,6 +7,7 @@
 #include "utils/include/arguments.h"
 #include "utils/include/serialize.h"
 #include "threads/include/thread_omp.h"
+#include "math/include/random_philox.h"
 #include "configuration/include/select.h"
 #include "configuration/include/configuration.h"
 #include "system/include/system.h"
@@ -82,8 +83,17 @@ void Prefetch::create(std::vector<Pool> * pool) {
   }
 
   // seed random number generators so that clones are not equal
-  for (int i = 0; i < num_threads_ - 1; ++i) {
-    clone_(i)->seed_random(rand());
+  if (random().class_name() == "RandomPhilox") {
+    // derive a stream for each clone, for reproducible parallel runs
+    for (int thread = 1; thread < num_threads_; ++thread) {
+      RandomPhilox * random = static_cast<RandomPhilox*>(
+        clone_(thread)->get_random());
+      random->set_stream(random->stream() + thread);
+    }
+  } else {
+    for (int i = 0; i < num_threads_ - 1; ++i) {
+      clone_(i)->seed_random(rand());
+    }
   }
 
   // run some checks before attempting trials
@@ -1,6 +1,10 @@
+#ifdef _OPENMP
+  #include <omp.h>
+#endif // _OPENMP
 #include "utils/test/utils.h"
 #include "threads/include/thread_omp.h"
 #include "math/include/random_mt19937.h"
+#include "math/include/random_philox.h"
 #include "math/include/histogram.h"
 #include "configuration/include/configuration.h"
 #include "configuration/include/domain.h"
@@ -69,6 +73,37 @@ TEST(Prefetch, NVT_benchmark) {
   run_prefetch(1e3, 1e1);
 }
 
+double run_prefetch_philox() {
+  auto mc = MakePrefetch({{"trials_per_check", "1"}});
+  mc->set(MakeRandomPhilox({{"seed", "123"}}));
+  mc->add(MakeConfiguration({{"cubic_side_length", "8"},
+                             {"particle_type", "lj:../particle/lj_new.txt"}}));
+  mc->add(MakePotential(MakeLennardJones()));
+  mc->set(MakeThermoParams({{"beta", "1.2"}, {"chemical_potential", "1."}}));
+  mc->set(MakeMetropolis());
+  mc->add(MakeTrialTranslate({{"tunable_param", "1."}}));
+  mc->add(MakeCheckEnergy({{"trials_per_update", "100"}}));
+  mc->add(MakeTrialAdd({{"particle_type", "lj"}}));
+  mc->run(MakeRun({{"until_num_particles", "20"}}));
+  mc->run(MakeRemove({{"name", "TrialAdd"}}));
+  mc->activate_prefetch(true);
+  mc->attempt(500);
+  return mc->criteria().current_energy();
+}
+
+// Prefetch with RandomPhilox derives streams instead of seeds by time.
+TEST(Prefetch, philox_reproducible) {
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+  omp_set_num_threads(4);
+  EXPECT_EQ(4, omp_get_max_threads());
+#endif // _OPENMP
+  EXPECT_EQ(run_prefetch_philox(), run_prefetch_philox());
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif // _OPENMP
+}
+
 TEST(Prefetch, NVT_benchmark_LONG) {
   run_prefetch(1e6, 1e3); // 5.4s on 4 cores of i7-4770K @ 3.5GHz
 }
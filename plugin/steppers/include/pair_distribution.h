@@ -44,6 +44,14 @@ typedef std::vector<grbintype> grtype;
   System.
   However, the pair distance calculation utilizes Potential::energy, which
   requires a pointer to Configuration.
+
+  Alternatively, the cell_list engine does not use Potential.
+  Instead, the physical sites are binned into cells with side lengths no
+  smaller than r_max, such that only neighboring cells are visited.
+  The cells are distributed among OpenMP threads, each of which accumulates
+  its own histograms before a reduction.
+  For large systems, this scales linearly with the number of sites rather
+  than quadratically.
  */
 class PairDistribution : public Modify {
  public:
@@ -51,6 +59,15 @@ class PairDistribution : public Modify {
   /** @name Arguments
     - dr: radial distribution bin size (default: 0.1).
     - print_intra: print the intramolecular distributions (default: false).
+    - r_max: maximum distance of the pair distributions
+      (default: half of the inscribed sphere diameter of the Domain).
+    - cell_list: if true, use the cell list engine described above.
+      Otherwise, use VisitModel (default: false).
+    - exclude: comma-separated list of pairs of site type names, joined by a
+      dash (e.g., "O-H,H-H"), which are not computed.
+      Requires cell_list (default: none).
+    - exclude_intra: if true, do not compute intramolecular distributions.
+      Requires cell_list (default: false).
    */
   explicit PairDistribution(argtype args = argtype());
   explicit PairDistribution(argtype * args);
@@ -67,6 +84,23 @@ class PairDistribution : public Modify {
 
   const grtype& radial(const Configuration& config);
 
+  /// Return the maximum distance of the pair distributions.
+  double r_max(const Configuration& config) const;
+
+  /// Return true if the cell list engine is used.
+  bool cell_list() const { return cell_list_; }
+
+  /// Return true if the pair of site types is excluded.
+  bool is_excluded(const int site_type1, const int site_type2) const;
+
+  /// Return the intermolecular histograms of each pair of site types.
+  const std::vector<std::vector<Histogram> >& inter() const {
+    return inter_.radial_; }
+
+  /// Return the intramolecular histograms of each pair of site types.
+  const std::vector<std::vector<Histogram> >& intra() const {
+    return intra_.radial_; }
+
   //const std::vector<std::vector<Histogram> >& radial() const { return radial_; }
 
   // serialize
@@ -89,9 +123,27 @@ class PairDistribution : public Modify {
   PairDistributionInner intra_;
   ModelParams params_;
   int num_updates_;
+  double r_max_;
+  bool cell_list_;
+  std::string exclude_;
+  bool exclude_intra_;
+  std::vector<std::vector<int> > excluded_;
 
   // temporary and not serialized
   grtype radial_;
+  std::vector<double> coord_;
+  std::vector<int> site_type_;
+  std::vector<int> particle_;
+  std::vector<int> num_cells_;
+  std::vector<int> cell_start_;
+  std::vector<int> cell_site_;
+  std::vector<std::vector<int> > neighbors_;
+
+  void update_cell_list_(const Configuration& config);
+  void bin_sites_(const Configuration& config);
+  void accumulate_cell_pairs_(const Configuration& config,
+    const int thread, const int num_threads, std::vector<double> * inter,
+    std::vector<double> * intra) const;
 };
 
 inline std::shared_ptr<PairDistribution> MakePairDistribution(
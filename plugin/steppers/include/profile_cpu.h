@@ -8,11 +8,23 @@ namespace feasst {
 
 /**
   Periodically write the profile of where CPU time is spent.
+
+  Optionally, also write a hierarchical profile from the Profiler of the
+  current thread, which breaks down the time of each Trial into the selection,
+  perturbation, each Potential, the Criteria and the finalization
+  (e.g., the update of the EnergyMap and cells).
+  The counts of each Potential are the number of pairs of sites for which a
+  distance was computed, as read from the VisitCounters.
+  Thus, the counts are zero unless compiled with the VisitCounters enabled.
  */
 class ProfileCPU : public AnalyzeWriteOnly {
  public:
   //@{
   /** @name Arguments
+    - hierarchical_file: if not empty, enable the Profiler and write the
+      hierarchical profile to this file, which is overwritten every write
+      (default: empty).
+    - hierarchical_format: "csv" or "json" (default: csv).
     - Stepper arguments.
    */
   explicit ProfileCPU(argtype args = argtype());
@@ -36,6 +48,11 @@ class ProfileCPU : public AnalyzeWriteOnly {
   void serialize(std::ostream& ostr) const override;
   explicit ProfileCPU(std::istream& istr);
   //@}
+ private:
+  std::string hierarchical_file_;
+  std::string hierarchical_format_;
+
+  void write_hierarchical_() const;
 };
 
 inline std::shared_ptr<ProfileCPU> MakeProfileCPU(argtype args = argtype()) {
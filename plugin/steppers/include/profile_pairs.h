@@ -0,0 +1,80 @@
+#ifndef FEASST_STEPPERS_PROFILE_PAIRS_H_
+#define FEASST_STEPPERS_PROFILE_PAIRS_H_
+
+#include <vector>
+#include "monte_carlo/include/analyze.h"
+
+namespace feasst {
+
+/**
+  Report the VisitCounters per attempt of each Trial, averaged over the
+  trials since the previous write.
+  For example, the number of pairs tested and within the cutoff per attempt
+  may be used to tune the min_length of VisitModelCell, the cutoff or the
+  CutoffOuter.
+
+  The counters are only available when compiled with
+  "cmake -DUSE_VISIT_COUNTERS=ON ..".
+  Otherwise, all counters are zero.
+
+  If trials_per_update is one, every Trial is counted.
+  Otherwise, the Trial following each update is counted.
+  Only the counters of the thread of the MonteCarlo are included.
+ */
+class ProfilePairs : public Analyze {
+ public:
+  //@{
+  /** @name Arguments
+    - Stepper arguments.
+   */
+  explicit ProfilePairs(argtype args = argtype());
+  explicit ProfilePairs(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  std::string header(const MonteCarlo& mc) const override;
+  void initialize(MonteCarlo * mc) override;
+  void update(const MonteCarlo& mc) override;
+  std::string write(const MonteCarlo& mc) override;
+
+  /// Return the number of counted attempts of each Trial since the last write.
+  const std::vector<double>& attempts() const { return attempts_; }
+
+  /// Return the sum of each VisitCounters::Counter (second index) for each
+  /// Trial (first index) since the last write.
+  const std::vector<std::vector<double> >& counts() const { return counts_; }
+
+  // serialize
+  std::string class_name() const override {
+    return std::string("ProfilePairs"); }
+  std::shared_ptr<Analyze> create(std::istream& istr) const override {
+    return std::make_shared<ProfilePairs>(istr); }
+  std::shared_ptr<Analyze> create(argtype * args) const override {
+    return std::make_shared<ProfilePairs>(args); }
+  void serialize(std::ostream& ostr) const override;
+  explicit ProfilePairs(std::istream& istr);
+
+  //@}
+ private:
+  std::vector<double> attempts_;
+  std::vector<std::vector<double> > counts_;
+
+  // temporary and not to be serialized
+  std::vector<double> previous_;
+  bool is_previous_ = false;
+
+  void zero_();
+  void store_previous_();
+};
+
+inline std::shared_ptr<ProfilePairs> MakeProfilePairs(
+    argtype args = argtype()) {
+  return std::make_shared<ProfilePairs>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_STEPPERS_PROFILE_PAIRS_H_
@@ -0,0 +1,109 @@
+#ifndef FEASST_STEPPERS_REPLICAS_H_
+#define FEASST_STEPPERS_REPLICAS_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/include/arguments.h"
+#include "math/include/accumulator.h"
+
+namespace feasst {
+
+class MonteCarlo;
+
+/**
+  Run a number of independent replicas of the same MonteCarlo input, each with
+  a different seed of the Random number generator, then merge the Accumulator
+  of each Analyze over all replicas.
+
+  Set the number of threads using the BASH environmental command:
+
+  export OMP_NUM_THREADS=2
+
+  If OMP is available, the replicas are distributed over the threads.
+  Otherwise, the replicas are run serially.
+
+  The seed of each replica is derived from the seed argument and the replica
+  index, and overrides the seed of any Random given in the input.
+  If no Random is given, RandomMT19937 is used.
+  Any value containing "[replica_index]" in the input is replaced with the
+  index of the replica, which should be used to give each replica unique
+  output file names.
+
+  Because the replicas are statistically independent, the block averages of
+  the merged Accumulator (see Accumulator::merge) provide uncertainties without
+  the need to post-process the output files of each replica.
+  Analyze within an AnalyzeFactory (e.g., multistate) are merged individually.
+
+  For example, in a text input file to the feasst executable:
+
+  Replicas num_replicas 8 seed 123 output_file replicas.csv
+  ...
+  Energy trials_per_write 1e5 output_file en[replica_index].txt
+  Run num_trials 1e7
+ */
+class Replicas {
+ public:
+  //@{
+  /** @name Arguments
+    - num_replicas: number of independent replicas (default: 1).
+    - seed: integer used to derive the seed of each replica
+      (default: 1346867550).
+    - output_file: if not empty, write the merged Accumulators to this file
+      after the replicas are run (default: empty).
+   */
+  explicit Replicas(argtype args = argtype());
+  explicit Replicas(argtype * args);
+
+  //@}
+  /** @name Public Functions
+   */
+  //@{
+
+  /// Return the number of replicas.
+  int num_replicas() const { return num_replicas_; }
+
+  /// Return the seed of the given replica.
+  int seed(const int replica) const;
+
+  /// Run each replica with the given MonteCarlo arguments, and merge.
+  void run(const arglist& args);
+
+  /// Return the replica of the given index.
+  const MonteCarlo& replica(const int index) const;
+
+  /// Return the names of the merged Accumulators, which are the class names
+  /// of the Analyze followed by the index in an AnalyzeFactory, if applicable.
+  const std::vector<std::string>& names() const { return names_; }
+
+  /// Return the Accumulators merged over all replicas.
+  const std::vector<Accumulator>& accumulators() const { return accumulators_; }
+
+  /// Return the merged Accumulator of the given name.
+  const Accumulator& accumulator(const std::string& name) const;
+
+  /// Return the merged Accumulators in human readable format.
+  std::string write() const;
+
+  ~Replicas();
+
+  //@}
+ private:
+  int num_replicas_;
+  int seed_;
+  std::string output_file_;
+  std::vector<std::shared_ptr<MonteCarlo> > replicas_;
+  std::vector<std::string> names_;
+  std::vector<Accumulator> accumulators_;
+
+  void merge_();
+};
+
+inline std::shared_ptr<Replicas> MakeReplicas(argtype args = argtype()) {
+  return std::make_shared<Replicas>(args);
+}
+
+}  // namespace feasst
+
+#endif  // FEASST_STEPPERS_REPLICAS_H_
@@ -26,6 +26,20 @@ namespace feasst {
   its complex conjugate:
 
   \f$I(q) = |F(\vec{q})|^2\f$.
+
+  By default, \f$F(\vec{q})\f$ is computed directly from every site upon each
+  update, which is O(N K) for N sites and K wave vectors.
+  Alternatively, the incremental mode maintains the structure factor of each
+  site type,
+
+  \f$S_t(\vec{q}) = \sum_{i \in t} \exp(-i \vec{q} \cdot \vec{r}_i)\f$,
+
+  and updates these sums after every accepted trial using only the perturbed
+  sites, with \f$\exp(i \vec{q} \cdot \vec{r})\f$ obtained by the same cos/sin
+  recursion as in Ewald.
+  Each update then costs O(K), independent of the number of sites, so that
+  the intensity may be sampled as often as every trial.
+  The sums are recomputed from scratch after a change in volume.
  */
 class Scattering : public Analyze {
  public:
@@ -33,6 +47,8 @@ class Scattering : public Analyze {
   /** @name Arguments
     - num_frequency: the number of linearly spaced frequencies between the
       largest and the smallest, 2*pi/minimum_domain_length (default: 100).
+    - incremental: if true, maintain the per-site-type structure factors
+      after every accepted trial, as described above (default: false).
     - Stepper arguments.
   */
   explicit Scattering(argtype args = argtype());
@@ -44,11 +60,29 @@ class Scattering : public Analyze {
   //@{
 
   void initialize(MonteCarlo * mc) override;
+
+  /// In incremental mode, update the structure factors after each trial.
+  void trial(const MonteCarlo& mc) override;
+
   void update(const MonteCarlo& mc) override;
   std::string write(const MonteCarlo& mc) override;
 
   int num_vectors() const { return static_cast<int>(kvecs_.size()); }
 
+  /// Return true if the incremental mode is used.
+  bool incremental() const { return incremental_; }
+
+  /// Return the real part of the structure factor of a site type.
+  const std::vector<double>& struct_fact_real(const int site_type) const {
+    return struct_fact_real_[site_type]; }
+
+  /// Return the imaginary part of the structure factor of a site type.
+  const std::vector<double>& struct_fact_imag(const int site_type) const {
+    return struct_fact_imag_[site_type]; }
+
+  /// Recompute the structure factors of every site type from scratch.
+  void compute_struct_fact(const Configuration& config);
+
   // serialize
   std::string class_name() const override { return std::string("Scattering"); }
   void serialize(std::ostream& ostr) const override;
@@ -61,10 +95,29 @@ class Scattering : public Analyze {
   //@}
  private:
   int num_frequency_;
+  bool incremental_;
   std::vector<Position> kvecs_;
+  std::vector<int> wave_num_;
   std::vector<std::vector<double> > site_ff_;
   std::vector<Accumulator> iq_;
 
+  // temporary and not serialized
+  std::vector<std::vector<double> > struct_fact_real_;
+  std::vector<std::vector<double> > struct_fact_imag_;
+  std::vector<double> unit_;
+  std::vector<double> eik_;
+  // site positions and types (-1 if absent) as last added to the sums.
+  std::vector<std::vector<std::vector<double> > > stored_position_;
+  std::vector<std::vector<int> > stored_type_;
+  double stored_volume_ = -1.;
+
+  void update_eik_(const std::vector<double>& position);
+  void add_site_(const std::vector<double>& position, const int type,
+                 const double sign);
+  void remove_stored_(const int particle_index, const int site_index);
+  void store_site_(const int particle_index, const int site_index,
+                   const Configuration& config);
+
 //  std::vector<double> iq_() const;
 };
 
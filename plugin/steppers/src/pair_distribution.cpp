@@ -1,7 +1,12 @@
+#include <cmath>
+#include "threads/include/thread_omp.h"
 #include "utils/include/arguments.h"
+#include "utils/include/io.h"
 #include "utils/include/utils.h"
 #include "utils/include/serialize_extra.h"
 #include "math/include/utils_math.h"
+#include "configuration/include/select.h"
+#include "configuration/include/particle_factory.h"
 #include "configuration/include/domain.h"
 #include "configuration/include/configuration.h"
 #include "system/include/system.h"
@@ -54,6 +59,12 @@ PairDistribution::PairDistribution(argtype * args) : Modify(args) {
   //DEBUG("args " << args_.status());
   dr_ = dble("dr", args, 0.1);
   print_intra_ = boolean("print_intra", args, false);
+  r_max_ = dble("r_max", args, -1.);
+  cell_list_ = boolean("cell_list", args, false);
+  exclude_ = str("exclude", args, "");
+  exclude_intra_ = boolean("exclude_intra", args, false);
+  ASSERT(cell_list_ || (exclude_.empty() && !exclude_intra_),
+    "exclude and exclude_intra require cell_list");
   DEBUG("is multistate? " << is_multistate());
   DEBUG("is multistate agg? " << is_multistate_aggregate());
   DEBUG("output_file " << output_file());
@@ -82,20 +93,51 @@ void PairDistribution::initialize(MonteCarlo * mc) {
     }
   }
 
-  // set cutoff to half the minimum box length
+  // resolve the excluded pairs of site types
+  excluded_.clear();
+  resize(num_site_types, num_site_types, &excluded_);
+  fill(0, &excluded_);
+  if (!exclude_.empty()) {
+    for (const std::string& pair : split(exclude_, ',')) {
+      const std::vector<std::string> names = split(pair, '-');
+      ASSERT(names.size() == 2, "exclude:" << exclude_ << " requires pairs "
+        << "of site type names joined by a dash");
+      const int itype = config->site_type_name_to_index(names[0]);
+      const int jtype = config->site_type_name_to_index(names[1]);
+      excluded_[itype][jtype] = 1;
+      excluded_[jtype][itype] = 1;
+    }
+  }
+
+  // set cutoff to r_max, by default half the minimum box length
   params_ = deep_copy(config->model_params());
-  const double min_side = config->domain().inscribed_sphere_diameter();
-  DEBUG("min_side " << min_side);
+  const double rmax = r_max(*config);
+  DEBUG("r_max " << rmax);
   for (int itype = 0; itype < num_site_types; ++itype) {
-    params_.set("cutoff", itype, 0.5*min_side);
+    params_.set("cutoff", itype, rmax);
     for (int jtype = 0; jtype < num_site_types; ++jtype) {
-      params_.set("cutoff", itype, jtype, 0.5*min_side);
+      params_.set("cutoff", itype, jtype, rmax);
     }
   }
   inter_visit_.precompute(config);
   intra_visit_.precompute(config);
 }
 
+double PairDistribution::r_max(const Configuration& config) const {
+  if (r_max_ > 0) {
+    return r_max_;
+  }
+  return 0.5*config.domain().inscribed_sphere_diameter();
+}
+
+bool PairDistribution::is_excluded(const int site_type1,
+    const int site_type2) const {
+  if (site_type1 < static_cast<int>(excluded_.size())) {
+    return excluded_[site_type1][site_type2] == 1;
+  }
+  return false;
+}
+
 std::string PairDistribution::header(const MonteCarlo& mc) const {
   const Configuration& config = configuration(mc.system());
   const int num_site_types = config.num_site_types();
@@ -123,8 +165,229 @@ void PairDistribution::update(MonteCarlo * mc) {
   ++num_updates_;
   //DEBUG(params_.cutoff().size());
   //DEBUG(params_.cutoff().mixed_value(0, 0));
-  inter_visit_.compute(&inter_, params_, config, 0);
-  intra_visit_.compute(&intra_, params_, config, 0);
+  if (cell_list_) {
+    update_cell_list_(*config);
+  } else {
+    inter_visit_.compute(&inter_, params_, config, 0);
+    intra_visit_.compute(&intra_, params_, config, 0);
+  }
+}
+
+void PairDistribution::bin_sites_(const Configuration& config) {
+  const Domain& domain = config.domain();
+  const int dimen = config.dimension();
+  const double rmax = r_max(config);
+
+  // gather the physical sites
+  coord_.clear();
+  site_type_.clear();
+  particle_.clear();
+  const Select& select = config.group_select(0);
+  for (int sel = 0; sel < select.num_particles(); ++sel) {
+    const int part_index = select.particle_index(sel);
+    const Particle& part = config.select_particle(part_index);
+    for (const int site_index : select.site_indices(sel)) {
+      const Site& site = part.site(site_index);
+      if (site.is_physical()) {
+        const std::vector<double>& coord = site.position().coord();
+        coord_.insert(coord_.end(), coord.begin(), coord.begin() + dimen);
+        site_type_.push_back(site.type());
+        particle_.push_back(part_index);
+      }
+    }
+  }
+  const int num_sites = static_cast<int>(site_type_.size());
+
+  // Cells are no smaller than r_max. If there are less than three cells in a
+  // dimension, neighboring cells would be visited more than once, so instead
+  // use only one cell in that dimension.
+  num_cells_.resize(dimen);
+  int num_cells = 1;
+  for (int dim = 0; dim < dimen; ++dim) {
+    num_cells_[dim] = static_cast<int>(domain.side_length(dim)/rmax);
+    if (num_cells_[dim] < 3) {
+      num_cells_[dim] = 1;
+    }
+    num_cells *= num_cells_[dim];
+  }
+
+  // counting sort of the sites into cells
+  std::vector<int> cell_of_site(num_sites);
+  cell_start_.assign(num_cells + 1, 0);
+  for (int site = 0; site < num_sites; ++site) {
+    int cell = 0;
+    for (int dim = dimen - 1; dim >= 0; --dim) {
+      const int num = num_cells_[dim];
+      int bin = static_cast<int>(std::floor(num*(
+        coord_[dimen*site + dim]/domain.side_length(dim) + 0.5)));
+      if (domain.periodic(dim)) {
+        bin = (bin % num + num) % num;
+      } else {
+        bin = std::max(0, std::min(num - 1, bin));
+      }
+      cell = cell*num + bin;
+    }
+    cell_of_site[site] = cell;
+    ++cell_start_[cell + 1];
+  }
+  for (int cell = 0; cell < num_cells; ++cell) {
+    cell_start_[cell + 1] += cell_start_[cell];
+  }
+  cell_site_.resize(num_sites);
+  std::vector<int> filled(cell_start_.begin(), cell_start_.end() - 1);
+  for (int site = 0; site < num_sites; ++site) {
+    cell_site_[filled[cell_of_site[site]]++] = site;
+  }
+
+  // store the unique neighbors of each cell, including itself, with an equal
+  // or larger index such that each pair of cells is visited only once.
+  neighbors_.resize(num_cells);
+  std::vector<int> cell_coord(dimen), neigh_coord(dimen);
+  int num_offsets = 1;
+  for (int dim = 0; dim < dimen; ++dim) num_offsets *= 3;
+  for (int cell = 0; cell < num_cells; ++cell) {
+    int remain = cell;
+    for (int dim = 0; dim < dimen; ++dim) {
+      cell_coord[dim] = remain % num_cells_[dim];
+      remain /= num_cells_[dim];
+    }
+    std::vector<int> * neighbors = &neighbors_[cell];
+    neighbors->clear();
+    for (int offset = 0; offset < num_offsets; ++offset) {
+      int off = offset;
+      bool is_valid = true;
+      for (int dim = 0; dim < dimen; ++dim) {
+        const int num = num_cells_[dim];
+        int coord = cell_coord[dim] + off % 3 - 1;
+        off /= 3;
+        if (domain.periodic(dim)) {
+          coord = (coord + num) % num;
+        } else if (coord < 0 || coord >= num) {
+          is_valid = false;
+        }
+        neigh_coord[dim] = coord;
+      }
+      if (is_valid) {
+        int neigh = 0;
+        for (int dim = dimen - 1; dim >= 0; --dim) {
+          neigh = neigh*num_cells_[dim] + neigh_coord[dim];
+        }
+        if (neigh >= cell && !find_in_list(neigh, *neighbors)) {
+          neighbors->push_back(neigh);
+        }
+      }
+    }
+  }
+}
+
+void PairDistribution::accumulate_cell_pairs_(const Configuration& config,
+    const int thread, const int num_threads, std::vector<double> * inter,
+    std::vector<double> * intra) const {
+  const Domain& domain = config.domain();
+  const int dimen = config.dimension();
+  const int num_site_types = config.num_site_types();
+  const double rmax = r_max(config);
+  const double rmax_sq = rmax*rmax;
+  const int num_bins = static_cast<int>(inter->size())/
+                       num_site_types/num_site_types;
+  const int num_cells = static_cast<int>(neighbors_.size());
+  std::vector<double> side(dimen);
+  std::vector<bool> periodic(dimen);
+  for (int dim = 0; dim < dimen; ++dim) {
+    side[dim] = domain.side_length(dim);
+    periodic[dim] = domain.periodic(dim);
+  }
+  for (int cell = thread; cell < num_cells; cell += num_threads) {
+    for (const int neigh : neighbors_[cell]) {
+      for (int ii = cell_start_[cell]; ii < cell_start_[cell + 1]; ++ii) {
+        const int site1 = cell_site_[ii];
+        const int type1 = site_type_[site1];
+        const double * coord1 = &coord_[dimen*site1];
+        int jj = cell_start_[neigh];
+        if (neigh == cell) {
+          jj = ii + 1;
+        }
+        for (; jj < cell_start_[neigh + 1]; ++jj) {
+          const int site2 = cell_site_[jj];
+          const int type2 = site_type_[site2];
+          const bool is_intra = particle_[site1] == particle_[site2];
+          if (excluded_[type1][type2] == 1 || (is_intra && exclude_intra_)) {
+            continue;
+          }
+          const double * coord2 = &coord_[dimen*site2];
+          double r2 = 0.;
+          for (int dim = 0; dim < dimen; ++dim) {
+            double dx = coord1[dim] - coord2[dim];
+            if (periodic[dim]) {
+              dx -= side[dim]*std::rint(dx/side[dim]);
+            }
+            r2 += dx*dx;
+          }
+          if (r2 <= rmax_sq) {
+            const int bin = static_cast<int>(std::round(
+              (std::sqrt(r2) - 0.5*dr_)/dr_));
+            if (bin < num_bins) {
+              std::vector<double> * hist = inter;
+              if (is_intra) {
+                hist = intra;
+              }
+              (*hist)[(type1*num_site_types + type2)*num_bins + bin] += 1.;
+              (*hist)[(type2*num_site_types + type1)*num_bins + bin] += 1.;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void PairDistribution::update_cell_list_(const Configuration& config) {
+  ASSERT(!config.domain().is_tilted(),
+    "cell_list is not implemented for tilted domains");
+  bin_sites_(config);
+  const int num_site_types = config.num_site_types();
+  const int num_bins = static_cast<int>(std::round(r_max(config)/dr_)) + 1;
+  const int size = num_site_types*num_site_types*num_bins;
+  std::vector<double> inter(size, 0.), intra(size, 0.);
+  #ifdef _OPENMP
+  #pragma omp parallel
+  {
+    auto thread = MakeThreadOMP();
+    std::vector<double> inter_t(size, 0.), intra_t(size, 0.);
+    accumulate_cell_pairs_(config, thread->thread(), thread->num(),
+                           &inter_t, &intra_t);
+    #pragma omp critical
+    {
+      for (int index = 0; index < size; ++index) {
+        inter[index] += inter_t[index];
+        intra[index] += intra_t[index];
+      }
+    }
+  }
+  #else // _OPENMP
+  accumulate_cell_pairs_(config, 0, 1, &inter, &intra);
+  #endif // _OPENMP
+
+  // reduce into the histograms
+  for (int itype = 0; itype < num_site_types; ++itype) {
+    for (int jtype = 0; jtype < num_site_types; ++jtype) {
+      Histogram * inter_hist = &inter_.radial_[itype][jtype];
+      Histogram * intra_hist = &intra_.radial_[itype][jtype];
+      for (int bin = 0; bin < num_bins; ++bin) {
+        const int index = (itype*num_site_types + jtype)*num_bins + bin;
+        for (const std::pair<Histogram *, double>& hc :
+             {std::make_pair(inter_hist, inter[index]),
+              std::make_pair(intra_hist, intra[index])}) {
+          if (hc.second > 0) {
+            if (bin >= hc.first->size()) {
+              hc.first->add((bin + 0.5)*dr_, false);
+            }
+            hc.first->add_to_bin(bin, hc.second);
+          }
+        }
+      }
+    }
+  }
 }
 
 std::string PairDistribution::write(MonteCarlo * mc) {
@@ -169,7 +432,7 @@ const grtype& PairDistribution::radial(const Configuration& config) {
   const std::vector<int> num_sites_of_type = config.num_sites_of_type();
   std::vector<std::vector<int> > num_sites_of_type_in_particle =
     config.num_site_types_per_particle_type();
-  const int max_bin = static_cast<int>(0.5*config.domain().inscribed_sphere_diameter()/dr_);
+  const int max_bin = static_cast<int>(r_max(config)/dr_);
 
   // find maximum bin in radial
   int maxi = 0, maxj = 0, max_bin_radial = -1;
@@ -214,7 +477,7 @@ const grtype& PairDistribution::radial(const Configuration& config) {
         const double num_jtype = num_sites_of_type[jtype];
         const Histogram& hist = inter_.radial_[itype][jtype];
         double grbin = nn;
-        if (bin < hist.size()) {
+        if (bin < hist.size() && !is_excluded(itype, jtype)) {
           grbin = hist.histogram()[bin]
             /(num_itype - norm_fac)
             /num_jtype
@@ -230,7 +493,7 @@ const grtype& PairDistribution::radial(const Configuration& config) {
 
 void PairDistribution::serialize(std::ostream& ostr) const {
   Stepper::serialize(ostr);
-  feasst_serialize_version(2034, ostr);
+  feasst_serialize_version(2035, ostr);
   feasst_serialize(dr_, ostr);
   feasst_serialize(print_intra_, ostr);
   feasst_serialize_fstobj(inter_visit_, ostr);
@@ -239,11 +502,16 @@ void PairDistribution::serialize(std::ostream& ostr) const {
   feasst_serialize_fstobj(intra_, ostr);
   feasst_serialize_fstobj(params_, ostr);
   feasst_serialize(num_updates_, ostr);
+  feasst_serialize(r_max_, ostr);
+  feasst_serialize(cell_list_, ostr);
+  feasst_serialize(exclude_, ostr);
+  feasst_serialize(exclude_intra_, ostr);
+  feasst_serialize(excluded_, ostr);
 }
 
 PairDistribution::PairDistribution(std::istream& istr) : Modify(istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(version == 2034, "mismatch version:" << version);
+  ASSERT(version >= 2034 && version <= 2035, "mismatch version:" << version);
   feasst_deserialize(&dr_, istr);
   feasst_deserialize(&print_intra_, istr);
   feasst_deserialize_fstobj(&inter_visit_, istr);
@@ -252,6 +520,16 @@ PairDistribution::PairDistribution(std::istream& istr) : Modify(istr) {
   feasst_deserialize_fstobj(&intra_, istr);
   feasst_deserialize_fstobj(&params_, istr);
   feasst_deserialize(&num_updates_, istr);
+  r_max_ = -1.;
+  cell_list_ = false;
+  exclude_intra_ = false;
+  if (version >= 2035) {
+    feasst_deserialize(&r_max_, istr);
+    feasst_deserialize(&cell_list_, istr);
+    feasst_deserialize(&exclude_, istr);
+    feasst_deserialize(&exclude_intra_, istr);
+    feasst_deserialize(&excluded_, istr);
+  }
 }
 
 PairDistribution::PairDistribution(const Modify& pair_distribution) {
@@ -1,5 +1,7 @@
 #include "utils/include/arguments.h"
+#include <fstream>
 #include "utils/include/serialize.h"
+#include "utils/include/profiler.h"
 #include "utils/include/timer_rdtsc.h"
 #include "math/include/accumulator.h"
 #include "monte_carlo/include/criteria.h"
@@ -13,7 +15,12 @@ namespace feasst {
 
 FEASST_MAPPER(ProfileCPU,);
 
-ProfileCPU::ProfileCPU(argtype * args) : AnalyzeWriteOnly(args) {}
+ProfileCPU::ProfileCPU(argtype * args) : AnalyzeWriteOnly(args) {
+  hierarchical_file_ = str("hierarchical_file", args, "");
+  hierarchical_format_ = str("hierarchical_format", args, "csv");
+  ASSERT(hierarchical_format_ == "csv" || hierarchical_format_ == "json",
+    "unrecognized hierarchical_format: " << hierarchical_format_);
+}
 ProfileCPU::ProfileCPU(argtype args) : ProfileCPU(&args) {
   feasst_check_all_used(args);
 }
@@ -24,6 +31,9 @@ void ProfileCPU::initialize(MonteCarlo * mc) {
   mc->get_trial_factory()->set_timer();
   mc->get_analyze_factory()->set_timer();
   mc->get_modify_factory()->set_timer();
+  if (!hierarchical_file_.empty()) {
+    Profiler::thread_profiler()->enable();
+  }
   printer(header(*mc), output_file(mc->criteria()));
 }
 
@@ -61,8 +71,26 @@ std::string ProfileCPU::header(const MonteCarlo& mc) const {
   return ss.str();
 }
 
+void ProfileCPU::write_hierarchical_() const {
+  Profiler * profiler = Profiler::thread_profiler();
+  // the Profiler is not serialized, so enable again upon restart
+  if (!profiler->is_enabled()) {
+    profiler->enable();
+    return;
+  }
+  std::ofstream file(hierarchical_file_);
+  if (hierarchical_format_ == "json") {
+    file << profiler->json();
+  } else {
+    file << profiler->csv();
+  }
+}
+
 std::string ProfileCPU::write(const MonteCarlo& mc) {
   std::stringstream ss;
+  if (!hierarchical_file_.empty()) {
+    write_hierarchical_();
+  }
   #ifndef IS_X86
     ss << "ProfileCPU only works on x86 architectures." << std::endl;
     return ss.str();
@@ -107,12 +135,18 @@ std::string ProfileCPU::write(const MonteCarlo& mc) {
 
 void ProfileCPU::serialize(std::ostream& ostr) const {
   Stepper::serialize(ostr);
-  feasst_serialize_version(7176, ostr);
+  feasst_serialize_version(7177, ostr);
+  feasst_serialize(hierarchical_file_, ostr);
+  feasst_serialize(hierarchical_format_, ostr);
 }
 
 ProfileCPU::ProfileCPU(std::istream& istr) : AnalyzeWriteOnly(istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(version == 7176, "mismatch version:" << version);
+  ASSERT(version >= 7176 && version <= 7177, "mismatch version:" << version);
+  if (version >= 7177) {
+    feasst_deserialize(&hierarchical_file_, istr);
+    feasst_deserialize(&hierarchical_format_, istr);
+  }
 }
 
 }  // namespace feasst
@@ -0,0 +1,120 @@
+#include "utils/include/serialize.h"
+#include "utils/include/arguments.h"
+#include "system/include/visit_counters.h"
+#include "monte_carlo/include/trial_factory.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "steppers/include/profile_pairs.h"
+
+namespace feasst {
+
+FEASST_MAPPER(ProfilePairs,);
+
+ProfilePairs::ProfilePairs(argtype * args) : Analyze(args) {}
+ProfilePairs::ProfilePairs(argtype args) : ProfilePairs(&args) {
+  feasst_check_all_used(args);
+}
+
+void ProfilePairs::zero_() {
+  std::fill(attempts_.begin(), attempts_.end(), 0.);
+  for (std::vector<double>& count : counts_) {
+    std::fill(count.begin(), count.end(), 0.);
+  }
+}
+
+void ProfilePairs::store_previous_() {
+  const VisitCounters& counters = *VisitCounters::thread_counters();
+  previous_.resize(VisitCounters::num_counters);
+  for (int counter = 0; counter < VisitCounters::num_counters; ++counter) {
+    previous_[counter] = static_cast<double>(counters.count(counter));
+  }
+}
+
+void ProfilePairs::initialize(MonteCarlo * mc) {
+  Analyze::initialize(mc);
+  if (!VisitCounters::is_enabled()) {
+    WARN("ProfilePairs requires cmake -DUSE_VISIT_COUNTERS=ON");
+  }
+  const int num_trials = mc->trial_factory().num();
+  attempts_.resize(num_trials);
+  counts_.resize(num_trials,
+                 std::vector<double>(VisitCounters::num_counters));
+  zero_();
+  store_previous_();
+  is_previous_ = trials_per_update() == 1;
+  printer(header(*mc), output_file(mc->criteria()));
+}
+
+std::string ProfilePairs::header(const MonteCarlo& mc) const {
+  std::stringstream ss;
+  ss << "#per attempt" << std::endl << "trial,attempts,";
+  for (int counter = 0; counter < VisitCounters::num_counters; ++counter) {
+    ss << VisitCounters::name(counter) << ",";
+  }
+  ss << std::endl;
+  return ss.str();
+}
+
+void ProfilePairs::update(const MonteCarlo& mc) {
+  const VisitCounters& counters = *VisitCounters::thread_counters();
+  if (is_previous_) {
+    const int trial = mc.trial_factory().last_index();
+    if (trial >= 0 && trial < static_cast<int>(attempts_.size())) {
+      attempts_[trial] += 1.;
+      for (int counter = 0; counter < VisitCounters::num_counters; ++counter) {
+        counts_[trial][counter] += static_cast<double>(
+          counters.count(counter)) - previous_[counter];
+      }
+    }
+  }
+  store_previous_();
+  // Unless every trial is counted, trigger an update on the next trial.
+  if (trials_per_update() == 1) {
+    is_previous_ = true;
+  } else if (is_previous_) {
+    is_previous_ = false;
+  } else {
+    is_previous_ = true;
+    trials_since_update_ = trials_per_update();
+  }
+}
+
+std::string ProfilePairs::write(const MonteCarlo& mc) {
+  std::stringstream ss;
+  if (rewrite_header()) {
+    ss << header(mc);
+  }
+  const std::vector<std::shared_ptr<Trial> >& trials =
+    mc.trial_factory().trials();
+  for (int trial = 0; trial < static_cast<int>(attempts_.size()); ++trial) {
+    ss << trials[trial]->name_or_description() << ","
+       << attempts_[trial] << ",";
+    for (const double count : counts_[trial]) {
+      if (attempts_[trial] > 0) {
+        ss << count/attempts_[trial];
+      } else {
+        ss << 0;
+      }
+      ss << ",";
+    }
+    ss << std::endl;
+  }
+  zero_();
+  DEBUG(ss.str());
+  return ss.str();
+}
+
+void ProfilePairs::serialize(std::ostream& ostr) const {
+  Stepper::serialize(ostr);
+  feasst_serialize_version(5236, ostr);
+  feasst_serialize(attempts_, ostr);
+  feasst_serialize(counts_, ostr);
+}
+
+ProfilePairs::ProfilePairs(std::istream& istr) : Analyze(istr) {
+  const int version = feasst_deserialize_version(istr);
+  ASSERT(version == 5236, "mismatch version:" << version);
+  feasst_deserialize(&attempts_, istr);
+  feasst_deserialize(&counts_, istr);
+}
+
+}  // namespace feasst
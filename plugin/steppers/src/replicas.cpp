@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include "utils/include/custom_exception.h"
+#include "utils/include/arguments.h"
+#include "utils/include/arguments_extra.h"
+#include "utils/include/debug.h"
+#include "utils/include/io.h"
+#include "utils/include/utils.h"
+#include "utils/include/max_precision.h"
+#include "utils/include/serialize_extra.h"
+#include "threads/include/thread_omp.h"
+#include "monte_carlo/include/analyze.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "steppers/include/replicas.h"
+
+namespace feasst {
+
+Replicas::Replicas(argtype * args) {
+  num_replicas_ = integer("num_replicas", args, 1);
+  ASSERT(num_replicas_ > 0, "num_replicas: " << num_replicas_ << " must be > 0");
+  seed_ = integer("seed", args, 1346867550);
+  output_file_ = str("output_file", args, "");
+}
+Replicas::Replicas(argtype args) : Replicas(&args) {
+  feasst_check_all_used(args);
+}
+Replicas::~Replicas() {}
+
+// Mix the seed and replica index with the finalizer of splitmix64, such that
+// neighboring replicas obtain uncorrelated seeds.
+int Replicas::seed(const int replica) const {
+  uint64_t z = static_cast<uint64_t>(static_cast<uint32_t>(seed_)) +
+               static_cast<uint64_t>(replica + 1)*0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return static_cast<int>(z & 0x7FFFFFFFULL);
+}
+
+// Return a copy of the arguments for the given replica.
+static arglist replica_args_(const arglist& args, const int replica,
+                             const int seed) {
+  arglist list = args;
+  replace_in_value("[replica_index]", str(replica), &list);
+  bool found_random = false;
+  for (std::pair<std::string, argtype>& pair : list) {
+    if (pair.first.substr(0, 6) == "Random") {
+      pair.second["seed"] = str(seed);
+      found_random = true;
+    }
+  }
+  if (!found_random) {
+    list.insert(list.begin(), {"RandomMT19937", {{"seed", str(seed)}}});
+  }
+  return list;
+}
+
+void Replicas::run(const arglist& args) {
+  replicas_.clear();
+  replicas_.resize(num_replicas_);
+#ifdef _OPENMP
+  bool terminated = false;
+  #pragma omp parallel
+  {
+    auto thread = MakeThreadOMP();
+    try {
+      for (int replica = thread->thread();
+           replica < num_replicas_;
+           replica += thread->num()) {
+        DEBUG("thread " << thread->thread() << " replica " << replica);
+        replicas_[replica] = std::make_shared<MonteCarlo>(
+          replica_args_(args, replica, seed(replica)), replica != 0);
+      }
+    } catch(const feasst::CustomException& e) {
+      WARN(e.what());
+      #pragma omp critical
+      {
+        terminated = true;
+      }
+    }
+  }
+  if (terminated) {
+    FATAL("Replicas::run was terminated.");
+  }
+#else // _OPENMP
+  for (int replica = 0; replica < num_replicas_; ++replica) {
+    replicas_[replica] = std::make_shared<MonteCarlo>(
+      replica_args_(args, replica, seed(replica)), replica != 0);
+  }
+#endif // _OPENMP
+  merge_();
+  if (!output_file_.empty()) {
+    std::ofstream file(output_file_);
+    file << write();
+  }
+}
+
+const MonteCarlo& Replicas::replica(const int index) const {
+  ASSERT(index < static_cast<int>(replicas_.size()),
+    "index: " << index << " >= number of replicas: " << replicas_.size());
+  return *replicas_[index];
+}
+
+void Replicas::merge_() {
+  names_.clear();
+  accumulators_.clear();
+  const MonteCarlo& first = replica(0);
+  for (int index = 0; index < first.num_analyzers(); ++index) {
+    const Analyze& an = first.analyze(index);
+    if (an.class_name() == "AnalyzeFactory") {
+      for (int index2 = 0; index2 < static_cast<int>(an.analyzers().size());
+           ++index2) {
+        names_.push_back(an.analyze(index2).class_name() + str(index2));
+        accumulators_.push_back(deep_copy(an.analyze(index2).accumulator()));
+        for (int rep = 1; rep < num_replicas_; ++rep) {
+          const Analyze& an2 = replica(rep).analyze(index);
+          accumulators_.back().merge(an2.analyze(index2).accumulator());
+        }
+      }
+    } else {
+      names_.push_back(an.class_name());
+      accumulators_.push_back(deep_copy(an.accumulator()));
+      for (int rep = 1; rep < num_replicas_; ++rep) {
+        accumulators_.back().merge(replica(rep).analyze(index).accumulator());
+      }
+    }
+  }
+}
+
+const Accumulator& Replicas::accumulator(const std::string& name) const {
+  int index;
+  ASSERT(find_in_list(name, names_, &index), "name: " << name << " not found");
+  return accumulators_[index];
+}
+
+std::string Replicas::write() const {
+  std::stringstream ss;
+  ss << "name,num_replicas,num_values,average,stdev,block_stdev" << std::endl;
+  for (int index = 0; index < static_cast<int>(names_.size()); ++index) {
+    const Accumulator& acc = accumulators_[index];
+    ss << names_[index] << ","
+       << num_replicas_ << ","
+       << acc.num_values() << ","
+       << MAX_PRECISION << acc.average() << ","
+       << acc.stdev() << ","
+       << acc.block_stdev() << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace feasst
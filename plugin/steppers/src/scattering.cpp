@@ -9,6 +9,10 @@
 #include "configuration/include/domain.h"
 #include "configuration/include/configuration.h"
 #include "system/include/system.h"
+#include "monte_carlo/include/acceptance.h"
+#include "monte_carlo/include/criteria.h"
+#include "monte_carlo/include/trial.h"
+#include "monte_carlo/include/trial_factory.h"
 #include "monte_carlo/include/monte_carlo.h"
 #include "steppers/include/scattering.h"
 
@@ -18,6 +22,7 @@ FEASST_MAPPER(Scattering,);
 
 Scattering::Scattering(argtype * args) : Analyze(args) {
   num_frequency_ = integer("num_frequency", args, 100);
+  incremental_ = boolean("incremental", args, false);
 }
 Scattering::Scattering(argtype args) : Scattering(&args) {
   feasst_check_all_used(args);
@@ -30,15 +35,21 @@ void Scattering::initialize(MonteCarlo * mc) {
   ASSERT(!config.domain().is_tilted(), "not implemented for tilted domains.");
   Position kvec;
   kvecs_.clear();
+  wave_num_.clear();
   site_ff_.clear();
+  unit_.resize(3);
+  for (int dim = 0; dim < 3; ++dim) {
+    unit_[dim] = 2*PI/config.domain().side_length(dim);
+  }
   for (int kx = -num_frequency_; kx < num_frequency_; ++kx) {
     for (int ky = -num_frequency_; ky < num_frequency_; ++ky) {
       for (int kz = -num_frequency_; kz < num_frequency_; ++kz) {
         if (kx != 0 || ky != 0 || kz != 0) {
-          kvec.set_vector({2*PI*kx/config.domain().side_length(0),
-                           2*PI*ky/config.domain().side_length(1),
-                           2*PI*kz/config.domain().side_length(2)});
+          kvec.set_vector({kx*unit_[0], ky*unit_[1], kz*unit_[2]});
           kvecs_.push_back(kvec);
+          wave_num_.push_back(kx);
+          wave_num_.push_back(ky);
+          wave_num_.push_back(kz);
           const double k = kvec.distance();
           std::vector<double> ff;
           for (int site_type = 0; site_type < config.num_site_types(); ++site_type) {
@@ -53,25 +64,183 @@ void Scattering::initialize(MonteCarlo * mc) {
   }
   iq_.clear();
   iq_.resize(num_vectors());
+  if (incremental_) {
+    compute_struct_fact(config);
+  }
 }
 
-void Scattering::update(const MonteCarlo& mc) {
-  std::vector<double> fq(2*num_vectors());
-  const Configuration& config = configuration(mc.system());
+void Scattering::update_eik_(const std::vector<double>& position) {
+  const int num_k = 2*num_frequency_ + 1;
+  eik_.resize(6*num_k);
+  for (int dim = 0; dim < 3; ++dim) {
+    // shift the origin such that negative wave numbers are valid indices
+    double * eikr = &eik_[2*dim*num_k + num_frequency_];
+    double * eiki = eikr + num_k;
+    const double kr = unit_[dim]*position[dim];
+    eikr[0] = 1.;
+    eiki[0] = 0.;
+    eikr[1] = std::cos(kr);
+    eiki[1] = std::sin(kr);
+    for (int k = 2; k <= num_frequency_; ++k) {
+      eikr[k] = eikr[k - 1]*eikr[1] - eiki[k - 1]*eiki[1];
+      eiki[k] = eikr[k - 1]*eiki[1] + eiki[k - 1]*eikr[1];
+    }
+    for (int k = 1; k <= num_frequency_; ++k) {
+      eikr[-k] = eikr[k];
+      eiki[-k] = -eiki[k];
+    }
+  }
+}
+
+void Scattering::add_site_(const std::vector<double>& position,
+    const int type, const double sign) {
+  update_eik_(position);
+  const int num_k = 2*num_frequency_ + 1;
+  const double * eikrx = &eik_[num_frequency_];
+  const double * eikix = eikrx + num_k;
+  const double * eikry = eikix + num_k;
+  const double * eikiy = eikry + num_k;
+  const double * eikrz = eikiy + num_k;
+  const double * eikiz = eikrz + num_k;
+  std::vector<double> * sf_real = &struct_fact_real_[type];
+  std::vector<double> * sf_imag = &struct_fact_imag_[type];
+  for (int k = 0; k < num_vectors(); ++k) {
+    const int kx = wave_num_[3*k];
+    const int ky = wave_num_[3*k + 1];
+    const int kz = wave_num_[3*k + 2];
+    const double eikr = eikrx[kx]*eikry[ky]*eikrz[kz]
+                      - eikix[kx]*eikiy[ky]*eikrz[kz]
+                      - eikix[kx]*eikry[ky]*eikiz[kz]
+                      - eikrx[kx]*eikiy[ky]*eikiz[kz];
+    const double eiki = -eikix[kx]*eikiy[ky]*eikiz[kz]
+                      + eikrx[kx]*eikry[ky]*eikiz[kz]
+                      + eikrx[kx]*eikiy[ky]*eikrz[kz]
+                      + eikix[kx]*eikry[ky]*eikrz[kz];
+    (*sf_real)[k] += sign*eikr;
+    (*sf_imag)[k] -= sign*eiki;
+  }
+}
+
+void Scattering::remove_stored_(const int particle_index,
+    const int site_index) {
+  if (particle_index < static_cast<int>(stored_type_.size())) {
+    std::vector<int> * types = &stored_type_[particle_index];
+    if (site_index < static_cast<int>(types->size())) {
+      const int type = (*types)[site_index];
+      if (type != -1) {
+        add_site_(stored_position_[particle_index][site_index], type, -1.);
+        (*types)[site_index] = -1;
+      }
+    }
+  }
+}
+
+void Scattering::store_site_(const int particle_index, const int site_index,
+    const Configuration& config) {
+  const Particle& part = config.select_particle(particle_index);
+  if (particle_index >= static_cast<int>(stored_type_.size())) {
+    stored_type_.resize(particle_index + 1);
+    stored_position_.resize(particle_index + 1);
+  }
+  std::vector<int> * types = &stored_type_[particle_index];
+  if (part.num_sites() > static_cast<int>(types->size())) {
+    types->resize(part.num_sites(), -1);
+    stored_position_[particle_index].resize(part.num_sites());
+  }
+  const Site& site = part.site(site_index);
+  if (site.is_physical()) {
+    const std::vector<double>& position = site.position().coord();
+    add_site_(position, site.type(), 1.);
+    stored_position_[particle_index][site_index] = position;
+    (*types)[site_index] = site.type();
+  }
+}
+
+void Scattering::compute_struct_fact(const Configuration& config) {
+  ASSERT(num_frequency_ > 0, "num_frequency: " << num_frequency_);
+  const int num_site_types = config.num_site_types();
+  struct_fact_real_.assign(num_site_types, std::vector<double>(num_vectors(), 0.));
+  struct_fact_imag_.assign(num_site_types, std::vector<double>(num_vectors(), 0.));
+  stored_type_.clear();
+  stored_position_.clear();
   const Select& selection = config.group_select(0);
   for (int select_index = 0;
        select_index < selection.num_particles();
        ++select_index) {
     const int part_index = selection.particle_index(select_index);
-    const Particle& part = config.select_particle(part_index);
     for (int site_index : selection.site_indices(select_index)) {
-      const Site& site = part.site(site_index);
-      if (site.is_physical()) {
-        for (int k = 0; k < num_vectors(); ++k) {
-          const double kr = site.position().dot_product(kvecs_[k]);
-          const double ff = site_ff_[k][site.type()];
-          fq[k] += ff*std::cos(kr);
-          fq[k+num_vectors()] -= ff*std::sin(kr);
+      store_site_(part_index, site_index, config);
+    }
+  }
+  stored_volume_ = config.domain().volume();
+}
+
+void Scattering::trial(const MonteCarlo& mc) {
+  if (incremental_) {
+    const Configuration& config = configuration(mc.system());
+    if (config.num_site_types() != static_cast<int>(struct_fact_real_.size()) ||
+        config.domain().volume() != stored_volume_) {
+      compute_struct_fact(config);
+    } else if (mc.criteria().was_accepted()) {
+      const int trial_index = mc.trial_factory().last_index();
+      if (trial_index != -1) {
+        const Acceptance& accept = mc.trial(trial_index).accept();
+        if (configuration_index() <
+            static_cast<int>(accept.perturbed().size())) {
+          const Select& perturbed = accept.perturbed(configuration_index());
+          const int state = perturbed.trial_state();
+          if (state == 4) {
+            compute_struct_fact(config);
+          } else {
+            for (int select_index = 0;
+                 select_index < perturbed.num_particles();
+                 ++select_index) {
+              const int part_index = perturbed.particle_index(select_index);
+              for (int site_index : perturbed.site_indices(select_index)) {
+                remove_stored_(part_index, site_index);
+                if (state != 2) {
+                  store_site_(part_index, site_index, config);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  Analyze::trial(mc);
+}
+
+void Scattering::update(const MonteCarlo& mc) {
+  std::vector<double> fq(2*num_vectors());
+  const Configuration& config = configuration(mc.system());
+  if (incremental_) {
+    for (int type = 0; type < static_cast<int>(struct_fact_real_.size());
+         ++type) {
+      const std::vector<double>& sf_real = struct_fact_real_[type];
+      const std::vector<double>& sf_imag = struct_fact_imag_[type];
+      for (int k = 0; k < num_vectors(); ++k) {
+        const double ff = site_ff_[k][type];
+        fq[k] += ff*sf_real[k];
+        fq[k+num_vectors()] += ff*sf_imag[k];
+      }
+    }
+  } else {
+    const Select& selection = config.group_select(0);
+    for (int select_index = 0;
+         select_index < selection.num_particles();
+         ++select_index) {
+      const int part_index = selection.particle_index(select_index);
+      const Particle& part = config.select_particle(part_index);
+      for (int site_index : selection.site_indices(select_index)) {
+        const Site& site = part.site(site_index);
+        if (site.is_physical()) {
+          for (int k = 0; k < num_vectors(); ++k) {
+            const double kr = site.position().dot_product(kvecs_[k]);
+            const double ff = site_ff_[k][site.type()];
+            fq[k] += ff*std::cos(kr);
+            fq[k+num_vectors()] -= ff*std::sin(kr);
+          }
         }
       }
     }
@@ -117,15 +286,20 @@ std::string Scattering::write(const MonteCarlo& mc) {
 
 void Scattering::serialize(std::ostream& ostr) const {
   Stepper::serialize(ostr);
-  feasst_serialize_version(6301, ostr);
+  feasst_serialize_version(6302, ostr);
   feasst_serialize(num_frequency_, ostr);
+  feasst_serialize(incremental_, ostr);
 }
 
 Scattering::Scattering(std::istream& istr)
   : Analyze(istr) {
   const int version = feasst_deserialize_version(istr);
-  ASSERT(6301 == version, "version mismatch:" << version);
+  ASSERT(version >= 6301 && version <= 6302, "version mismatch:" << version);
   feasst_deserialize(&num_frequency_, istr);
+  incremental_ = false;
+  if (version >= 6302) {
+    feasst_deserialize(&incremental_, istr);
+  }
 }
 
 }  // namespace feasst
@@ -67,4 +67,51 @@ TEST(PairDistribution, gr_LONG) {
   EXPECT_NEAR(en.average()/num, -5.517, 0.075);
 }
 
+TEST(PairDistribution, cell_list) {
+  auto mc = MakeMonteCarlo({{
+    {"Configuration", {{"cubic_side_length", "12"}, {"particle_type", "../particle/trimer.txt"}}},
+    {"Potential", {{"VisitModel", "DontVisitModel"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "1"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "3"}}},
+    {"TrialAdd", {{"particle_type", "0"}}},
+    {"Run", {{"until_num_particles", "200"}}},
+    {"Remove", {{"name", "TrialAdd"}}},
+  }}, true);
+  auto visit = MakePairDistribution({{"dr", "0.05"}, {"r_max", "3.5"},
+    {"trials_per_write", "-1"}});
+  auto cell = MakePairDistribution({{"dr", "0.05"}, {"r_max", "3.5"},
+    {"cell_list", "true"}, {"trials_per_write", "-1"}});
+  auto excl = MakePairDistribution({{"dr", "0.05"}, {"r_max", "3.5"},
+    {"cell_list", "true"}, {"exclude", "A-R"}, {"exclude_intra", "true"},
+    {"trials_per_write", "-1"}});
+  for (auto pd : {visit, cell, excl}) mc->add(pd);
+  mc->attempt(20);
+  EXPECT_TRUE(cell->cell_list());
+  EXPECT_TRUE(excl->is_excluded(1, 0));
+  EXPECT_FALSE(excl->is_excluded(1, 1));
+  for (int itype = 0; itype < 2; ++itype) {
+    for (int jtype = 0; jtype < 2; ++jtype) {
+      const std::deque<double>& hv = visit->inter()[itype][jtype].histogram();
+      const std::deque<double>& hc = cell->inter()[itype][jtype].histogram();
+      const std::deque<double>& he = excl->inter()[itype][jtype].histogram();
+      EXPECT_EQ(hv.size(), hc.size());
+      EXPECT_EQ(hv, hc);
+      if (itype == jtype) {
+        EXPECT_EQ(hv, he);
+      } else {
+        for (const double count : he) EXPECT_EQ(count, 0.);
+      }
+      const std::deque<double>& iv = visit->intra()[itype][jtype].histogram();
+      const std::deque<double>& ic = cell->intra()[itype][jtype].histogram();
+      EXPECT_EQ(iv, ic);
+      for (const double count : excl->intra()[itype][jtype].histogram()) {
+        EXPECT_EQ(count, 0.);
+      }
+    }
+  }
+  auto cell2 = test_serialize(*cell);
+  EXPECT_TRUE(cell2.cell_list());
+}
+
 }  // namespace feasst
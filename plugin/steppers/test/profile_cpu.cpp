@@ -1,4 +1,7 @@
 #include "utils/test/utils.h"
+#include "utils/include/profiler.h"
+#include "system/include/visit_counters.h"
+#include "monte_carlo/include/monte_carlo.h"
 #include "steppers/include/profile_cpu.h"
 
 namespace feasst {
@@ -8,4 +11,35 @@ TEST(ProfileCPU, serialize) {
   auto obj2 = test_serialize_unique(*obj);
 }
 
+TEST(ProfileCPU, hierarchical) {
+  MonteCarlo mc;
+  mc.begin({
+    {"RandomMT19937", {{"seed", "123"}}},
+    {"Configuration", {{"cubic_side_length", "12"}, {"particle_type", "../particle/lj.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}, {"VisitModel", "VisitModelCell"}, {"min_length", "3"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "1"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialAdd", {{"particle_type", "0"}}},
+    {"Run", {{"until_num_particles", "20"}}},
+    {"ProfileCPU", {{"trials_per_write", "100"}, {"hierarchical_file", "tmp/prof.csv"}}},
+    {"Run", {{"num_trials", "200"}}},
+  });
+  const Profiler& profiler = *Profiler::thread_profiler();
+  EXPECT_TRUE(profiler.is_enabled());
+  const int node = profiler.node("TrialTranslate/perturb");
+  ASSERT_GT(node, 0);
+  EXPECT_GT(profiler.calls(node), 0);
+  const int pot = profiler.node("TrialTranslate/VisitModelCell:LennardJones");
+  ASSERT_GT(pot, 0);
+  if (VisitCounters::is_enabled()) {
+    EXPECT_GT(profiler.counts(pot), 0);
+  } else {
+    EXPECT_EQ(0, profiler.counts(pot));
+  }
+  EXPECT_GT(profiler.node("TrialTranslate/finalize/cell_update"), 0);
+  Profiler::thread_profiler()->enable(false);
+  Profiler::thread_profiler()->reset();
+}
+
 }  // namespace feasst
@@ -0,0 +1,39 @@
+#include "utils/test/utils.h"
+#include "system/include/visit_counters.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "steppers/include/profile_pairs.h"
+
+namespace feasst {
+
+TEST(ProfilePairs, serialize) {
+  auto obj = MakeProfilePairs();
+  auto obj2 = test_serialize_unique(*obj);
+}
+
+TEST(ProfilePairs, lj) {
+  MonteCarlo mc;
+  mc.begin({
+    {"RandomMT19937", {{"seed", "123"}}},
+    {"Configuration", {{"cubic_side_length", "12"}, {"particle_type", "../particle/lj.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}, {"VisitModel", "VisitModelCell"}, {"min_length", "3"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "1"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialAdd", {{"particle_type", "0"}}},
+    {"Run", {{"until_num_particles", "20"}}},
+    {"Remove", {{"name", "TrialAdd"}}},
+    {"ProfilePairs", {{"trials_per_write", "1e8"}}},
+    {"Run", {{"num_trials", "100"}}},
+  });
+  const auto& prof = static_cast<const ProfilePairs&>(mc.analyze(0));
+  EXPECT_EQ(100, prof.attempts()[0]);
+  if (VisitCounters::is_enabled()) {
+    const std::vector<double>& counts = prof.counts()[0];
+    EXPECT_GT(counts[VisitCounters::pairs_tested], 0);
+    EXPECT_GE(counts[VisitCounters::pairs_tested],
+              counts[VisitCounters::pairs_in_cutoff]);
+    EXPECT_GT(counts[VisitCounters::cells_visited], 0);
+  }
+}
+
+}  // namespace feasst
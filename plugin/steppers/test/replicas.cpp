@@ -0,0 +1,42 @@
+#include "utils/test/utils.h"
+#include "math/include/accumulator.h"
+#include "monte_carlo/include/analyze.h"
+#include "monte_carlo/include/monte_carlo.h"
+#include "steppers/include/replicas.h"
+
+namespace feasst {
+
+TEST(Replicas, lj) {
+  Replicas replicas({{"num_replicas", "3"}, {"seed", "123"}});
+  EXPECT_NE(replicas.seed(0), replicas.seed(1));
+  EXPECT_NE(replicas.seed(1), replicas.seed(2));
+  replicas.run({
+    {"Configuration", {{"cubic_side_length", "8"}, {"particle_type", "../particle/lj.txt"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", "1"}, {"chemical_potential", "1"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "1"}}},
+    {"TrialAdd", {{"particle_type", "0"}}},
+    {"Run", {{"until_num_particles", "20"}}},
+    {"Remove", {{"name", "TrialAdd"}}},
+    {"Energy", {{"trials_per_write", "-1"}}},
+    {"Run", {{"num_trials", "256"}}},
+  });
+  EXPECT_EQ(3, replicas.num_replicas());
+  EXPECT_EQ(1, static_cast<int>(replicas.names().size()));
+  const Accumulator& en = replicas.accumulator("Energy");
+  double av = 0.;
+  double num = 0.;
+  for (int rep = 0; rep < replicas.num_replicas(); ++rep) {
+    const Accumulator& acc = replicas.replica(rep).analyze(0).accumulator();
+    av += acc.sum();
+    num += acc.num_values();
+  }
+  EXPECT_EQ(num, en.num_values());
+  EXPECT_NEAR(av/num, en.average(), 1e-8);
+  EXPECT_NE(replicas.replica(0).analyze(0).accumulator().average(),
+            replicas.replica(1).analyze(0).accumulator().average());
+  DEBUG(replicas.write());
+}
+
+}  // namespace feasst
@@ -1,4 +1,5 @@
 #include "utils/test/utils.h"
+#include "monte_carlo/include/monte_carlo.h"
 #include "steppers/include/scattering.h"
 
 namespace feasst {
@@ -8,4 +9,33 @@ TEST(Scattering, serialize) {
   auto an2 = test_serialize<Scattering, Analyze>(*an);
 }
 
+TEST(Scattering, incremental) {
+  auto mc = MakeMonteCarlo({{
+    {"Configuration", {{"cubic_side_length", "8"}, {"particle_type", "lj:../particle/lj_new.txt"}, {"cutoff", "2"}}},
+    {"Potential", {{"Model", "LennardJones"}}},
+    {"ThermoParams", {{"beta", "1.2"}, {"chemical_potential", "-2."}, {"pressure", "0.01"}}},
+    {"Metropolis", {{}}},
+    {"TrialTranslate", {{"tunable_param", "1."}}},
+    {"TrialTransfer", {{"particle_type", "lj"}}},
+    {"TrialVolume", {{"tunable_param", "0.5"}}},
+    {"Run", {{"until_num_particles", "10"}}},
+  }}, true);
+  auto direct = MakeScattering({{"num_frequency", "2"}, {"trials_per_write", "-1"}});
+  auto incr = MakeScattering({{"num_frequency", "2"}, {"trials_per_write", "-1"},
+    {"incremental", "true"}});
+  mc->add(direct);
+  mc->add(incr);
+  mc->attempt(1e3);
+  EXPECT_TRUE(incr->incremental());
+  const std::vector<double> sf_real = incr->struct_fact_real(0);
+  const std::vector<double> sf_imag = incr->struct_fact_imag(0);
+  incr->compute_struct_fact(mc->configuration());
+  EXPECT_EQ(static_cast<int>(sf_real.size()), incr->num_vectors());
+  for (int k = 0; k < incr->num_vectors(); ++k) {
+    EXPECT_NEAR(sf_real[k], incr->struct_fact_real(0)[k], 1e-8);
+    EXPECT_NEAR(sf_imag[k], incr->struct_fact_imag(0)[k], 1e-8);
+  }
+  EXPECT_EQ(direct->write(*mc), incr->write(*mc));
+}
+
 }  // namespace feasst
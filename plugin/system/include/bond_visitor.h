@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace feasst {
 
@@ -13,9 +14,21 @@ class Select;
 class RigidBond;
 class RigidAngle;
 class RigidDihedral;
+class BondTwoBody;
+class BondThreeBody;
+class BondFourBody;
 
 typedef std::map<std::string, std::string> argtype;
 
+/**
+  Compute the energy of the bonds, angles and dihedrals of a selection.
+
+  The bonded terms of each particle type are compiled into a table upon the
+  first computation with a Configuration, or when the particle types of the
+  Configuration are revised.
+  For each site, the table lists the other sites, unique type and model of
+  each term in which the site is at an end.
+ */
 class BondVisitor {
  public:
   /**
@@ -61,6 +74,29 @@ class BondVisitor {
   std::shared_ptr<RigidBond> bond_;
   std::shared_ptr<RigidAngle> angle_;
   std::shared_ptr<RigidDihedral> dihedral_;
+
+  // not serialized
+  // For each particle type and site, the terms in which the site is at an
+  // end, in the same order as Particle::bond_neighbors, etc.
+  // Bonds are stored as site1, type, angles as site1, site2, type and
+  // dihedrals as site1, site2, site3, type, where the type is the index of
+  // the term in Configuration::unique_type.
+  std::vector<std::vector<std::vector<int> > > bond_terms_;
+  std::vector<std::vector<std::vector<int> > > angle_terms_;
+  std::vector<std::vector<std::vector<int> > > dihedral_terms_;
+  // For each particle type and unique type of term, the model.
+  std::vector<std::vector<const BondTwoBody*> > bond_models_;
+  std::vector<std::vector<const BondThreeBody*> > angle_models_;
+  std::vector<std::vector<const BondFourBody*> > dihedral_models_;
+  // Temporarily set to 1 for the sites in the selection.
+  std::vector<int> is_selected_;
+  // The Configuration and revision of its particle types that were compiled.
+  const Configuration * compiled_config_ = nullptr;
+  int compiled_revision_ = -1;
+
+  void compile_(const Configuration& config);
+  void select_sites_(const std::vector<int>& sites, const int num_sites,
+                     const int value);
 };
 
 inline std::shared_ptr<BondVisitor> MakeBondVisitor(
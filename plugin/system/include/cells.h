@@ -10,6 +10,12 @@ namespace feasst {
 
 /**
   Divide a cuboid domain into cells.
+
+  The sites within each cell are stored contiguously as parallel arrays of
+  particle and site indices, in no particular order.
+  The slot of each site within its cell is also stored, so that a site is
+  added or removed in constant time by swapping with the last site in the
+  cell.
  */
 class Cells {
  public:
@@ -46,11 +52,24 @@ class Cells {
   /// The second is a list of neighboring cells (including self).
   const std::vector<std::vector<int> >& neighbor() const { return neighbor_; }
 
-  /// Return the particles and sites within the cells.
-  /// The first index is the cell index.
-  const std::vector<Select>& particles() const { return particles_; }
+  /// Return the particle index of each site within a cell.
+  const std::vector<int>& particle_indices(const int cell) const {
+    return particle_[cell]; }
+
+  /// Return the site index of each site within a cell, in the same order as
+  /// particle_indices.
+  const std::vector<int>& site_indices(const int cell) const {
+    return site_[cell]; }
+
+  /// Return the number of sites within a cell.
+  int num_sites(const int cell) const {
+    return static_cast<int>(particle_[cell].size()); }
 
-  /// Return the number of particles within the cells.
+  /// Return the particles and sites within a cell as a Select.
+  /// This is not optimized, and is intended for testing.
+  Select particles(const int cell) const;
+
+  /// Return the number of sites within the cells.
   int num_sites() const;
 
   /// Return the unique number cell in which the scaled coordinate resides.
@@ -63,10 +82,19 @@ class Cells {
   /// Set the type.
   void set_type(const int type) { type_ = type; }
 
-  void add(const Select& select, const int cell) {
-    particles_[cell].add(select); }
-  void remove(const Select& select, const int cell) {
-    particles_[cell].remove(select); }
+  /// Add a site to a cell.
+  void add(const int particle_index, const int site_index, const int cell);
+
+  /// Remove a site from a cell, if present.
+  void remove(const int particle_index, const int site_index, const int cell);
+
+  /// Move a site from the old to the new cell.
+  void update(const int particle_index, const int site_index,
+              const int cell_new, const int cell_old);
+
+  /// Add, remove or update all sites in the Select.
+  void add(const Select& select, const int cell);
+  void remove(const Select& select, const int cell);
   void update(const Select& select, const int cell_new, const int cell_old);
 
   std::string str() const;
@@ -84,7 +112,13 @@ class Cells {
 
   // per cell vectors
   std::vector<std::vector<int> > neighbor_;
-  std::vector<Select> particles_;  // particles for each cell
+  std::vector<std::vector<int> > particle_;  // particle of each site in cell
+  std::vector<std::vector<int> > site_;  // site of each site in cell
+
+  // per particle vector of the slot of each site within its cell, or -1.
+  std::vector<std::vector<int> > slot_;
+
+  int find_slot_(const int particle_index, const int site_index) const;
 
   /// Return the unique cell id number for a given cell vector.
   int id_(std::vector<int> position);
@@ -201,6 +201,11 @@ class Potential {
   argtype override_args_;
   int configuration_index_;
   std::string config_;
+
+  // temporary and not serialized
+  // The Profiler section of this Potential, or -1 if not yet named.
+  int profile_section_ = -1;
+  int profile_section_id_();
 };
 
 inline std::shared_ptr<Potential> MakePotential(argtype args = argtype()) {
@@ -0,0 +1,64 @@
+#ifndef FEASST_SYSTEM_VISIT_COUNTERS_H_
+#define FEASST_SYSTEM_VISIT_COUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+namespace feasst {
+
+/**
+  Count the work performed by VisitModel, VisitModelCell and VisitModelInner,
+  such as the number of pairs of sites for which a distance was computed.
+  Each thread has its own counters.
+
+  The counters are disabled by default, such that they have no cost.
+  To enable, compile with "cmake -DUSE_VISIT_COUNTERS=ON ..".
+  See ProfilePairs to report the counters per Trial.
+ */
+class VisitCounters {
+ public:
+  /// The counters.
+  enum Counter {
+    pairs_tested,     ///< pair distances computed between physical sites
+    pairs_in_cutoff,  ///< pair distances within the cutoff
+    cells_visited,    ///< cells looped over by VisitModelCell
+    early_exits,      ///< energy_cutoff returns or particles skipped by
+                      ///< CutoffOuter
+    num_counters
+  };
+
+  /// Return true if compiled with the counters enabled.
+  static bool is_enabled();
+
+  /// Return the name of the counter.
+  static std::string name(const int counter);
+
+  /// Return the counters of the current thread.
+  static VisitCounters * thread_counters() {
+    static thread_local VisitCounters counters;
+    return &counters;
+  }
+
+  /// Increment the counter.
+  void increment(const int counter) { ++counts_[counter]; }
+
+  /// Return the value of the counter.
+  int64_t count(const int counter) const { return counts_[counter]; }
+
+  /// Set all counters to zero.
+  void reset();
+
+ private:
+  int64_t counts_[num_counters] = {0};
+};
+
+#ifdef FEASST_VISIT_COUNTERS
+  #define FEASST_VISIT_COUNT(counter) \
+    VisitCounters::thread_counters()->increment(VisitCounters::counter)
+#else  // FEASST_VISIT_COUNTERS
+  #define FEASST_VISIT_COUNT(counter)
+#endif  // FEASST_VISIT_COUNTERS
+
+}  // namespace feasst
+
+#endif  // FEASST_SYSTEM_VISIT_COUNTERS_H_
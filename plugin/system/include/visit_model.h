@@ -46,6 +46,17 @@ class VisitModel {
       Must be > 1e10 because too low could result in an accepted trial.
       If -1, ignore energy_cutoff (default: -1).
     - VisitModelInner: derived class VisitModelInner (default: VisitModelInner).
+    - parallel: if true and compiled with OpenMP, compute the energy of the
+      entire configuration (e.g., System::energy) in parallel, with each
+      thread accumulating the energy of its own part of the loop into a
+      separate copy of the VisitModelInner.
+      Only VisitModelCell also computes a selection in parallel, such as the
+      selection of all particles in a change in volume.
+      The partial energies are summed in the same order, regardless of the
+      number of threads.
+      Only used with the base VisitModelInner, without an EnergyMap or an
+      energy_cutoff, because the Model energy is assumed to be thread safe.
+      Otherwise, the computation is serial (default: false).
    */
   explicit VisitModel(argtype args);
   explicit VisitModel(argtype * args);
@@ -57,6 +68,10 @@ class VisitModel {
 
   double energy_cutoff() const { return energy_cutoff_; }
 
+  /// Return true if the energy of the entire configuration may be computed
+  /// in parallel.
+  bool parallel() const { return parallel_; }
+
   void set_inner(const std::shared_ptr<VisitModelInner> inner);
 
   const VisitModelInner& inner() const;
@@ -224,6 +239,9 @@ class VisitModel {
   // If possible, query energy map of old configuration instead of pair loop
   bool is_queryable_(const Select& selection, const bool is_old_config, VisitModelInner * inner);
 
+  // Return true if the entire configuration is computed in parallel.
+  bool is_parallel_(const VisitModelInner& inner) const;
+
  private:
   double energy_ = 0.;
   std::shared_ptr<VisitModelInner> inner_;
@@ -232,6 +250,7 @@ class VisitModel {
   int cutoff_index_ = -1;
   int charge_index_ = -1;
   double energy_cutoff_;
+  bool parallel_ = false;
 };
 
 inline std::shared_ptr<VisitModel> MakeVisitModel(argtype args = argtype()) {
@@ -17,10 +17,11 @@ typedef std::map<std::string, std::string> argtype;
 /**
   Compute many-body inter-particle interactions using a cell list.
 
-  For a triclinic domain, the minimum cell length is increased by the ratio
-  of the minimum side length by the maximum inscribed sphere.
-  Use of OptPotential in such a case is recommended to catch possible errors
-  with this assumption.
+  The cells are defined in scaled coordinates, and thus are aligned with the
+  vectors of a triclinic domain.
+  The number of cells in each dimension is given by the perpendicular width
+  of the domain (see Domain::perpendicular_width) divided by min_length,
+  such that each cell is at least min_length wide in every direction.
  */
 class VisitModelCell : public VisitModel {
  public:
@@ -105,12 +106,14 @@ class VisitModelCell : public VisitModel {
   int group_index_;
   std::string group_;
 
-  // temporary and not serialized
-  std::shared_ptr<Select> one_site_select_;
-
   void position_tracker_(const Select& select, Configuration * config);
   double min_len_(const Configuration& config) const;
   void rebuild_(const Configuration& config);
+  bool is_rebuild_required_(const Configuration& config) const;
+  void compute_all_(ModelTwoBody * model,
+                    const ModelParams& model_params,
+                    Configuration * config,
+                    const bool is_old_config);
 };
 
 inline std::shared_ptr<VisitModelCell> MakeVisitModelCell(
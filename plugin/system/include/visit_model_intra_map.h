@@ -24,6 +24,11 @@ typedef std::map<std::string, std::string> argtype;
   By default, all interactions are included except with self and there is no
   dihedral weight, so the user must specific if bonds, angles or dihedrals are
   to be excluded.
+
+  The map is also compiled into a list of the included pairs of each particle
+  type, which is used when the selection contains every site of the particle.
+  Otherwise, such as for a partial regrowth or pivot, only the pairs which
+  include a site in the selection are computed.
  */
 class VisitModelIntraMap : public VisitModel {
  public:
@@ -82,6 +87,15 @@ class VisitModelIntraMap : public VisitModel {
   bool exclude_dihedrals_;
   double dihedral_weight_;
   std::vector<std::vector<std::vector<int> > > include_map_;
+
+  // not serialized
+  // For each particle type, the site1, site2 and include_map of each included
+  // pair, where site1 < site2.
+  std::vector<std::vector<int> > pair_list_;
+  // Temporarily set to 1 for the sites in the selection.
+  std::vector<int> is_selected_;
+
+  void build_pair_list_();
 };
 
 inline std::shared_ptr<VisitModelIntraMap> MakeVisitModelIntraMap(
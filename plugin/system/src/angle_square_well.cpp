@@ -30,19 +30,23 @@ void AngleSquareWell::serialize(std::ostream& ostr) const {
 }
 
 double AngleSquareWell::energy(const double radians, const Bond& angle) const {
+  static const PropertyKey minimum_key("minimum");
+  static const PropertyKey min_degrees_key("min_degrees");
+  static const PropertyKey maximum_key("maximum");
+  static const PropertyKey max_degrees_key("max_degrees");
   double minimum;
-  if (angle.has_property("minimum")) {
-    minimum = degrees_to_radians(angle.property("minimum"));
+  if (angle.has_property(minimum_key)) {
+    minimum = degrees_to_radians(angle.property(minimum_key));
     // WARN("AngleSquareWell minimum is deprecated. Use min_degrees.");
   } else {
-    minimum = degrees_to_radians(angle.property("min_degrees"));
+    minimum = degrees_to_radians(angle.property(min_degrees_key));
   }
   double maximum;
-  if (angle.has_property("maximum")) {
-    maximum = degrees_to_radians(angle.property("maximum"));
+  if (angle.has_property(maximum_key)) {
+    maximum = degrees_to_radians(angle.property(maximum_key));
     // WARN("AngleSquareWell maximum is deprecated. Use max_degrees.");
   } else {
-    maximum = degrees_to_radians(angle.property("max_degrees"));
+    maximum = degrees_to_radians(angle.property(max_degrees_key));
   }
   TRACE("radians " << radians);
   ASSERT(!std::isnan(radians), "radians is nan");
@@ -30,8 +30,10 @@ void BondSquareWell::serialize(std::ostream& ostr) const {
 }
 
 double BondSquareWell::energy(const double distance, const Bond& bond) const {
-  const double maximum = bond.property("maximum");
-  const double minimum = bond.property("minimum");
+  static const PropertyKey maximum_key("maximum");
+  static const PropertyKey minimum_key("minimum");
+  const double maximum = bond.property(maximum_key);
+  const double minimum = bond.property(minimum_key);
   if (distance < minimum || distance > maximum) {
     return NEAR_INFINITY;
   }
@@ -40,8 +42,10 @@ double BondSquareWell::energy(const double distance, const Bond& bond) const {
 
 double BondSquareWell::random_distance(const Bond& bond, const double beta,
     const int dimen, Random * random) const {
-  return random->uniform_real(bond.property("minimum"),
-                              bond.property("maximum"));
+  static const PropertyKey minimum_key("minimum");
+  static const PropertyKey maximum_key("maximum");
+  return random->uniform_real(bond.property(minimum_key),
+                              bond.property(maximum_key));
 }
 
 }  // namespace feasst
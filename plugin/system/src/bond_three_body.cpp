@@ -47,11 +47,12 @@ double BondThreeBody::energy(const Position& ri, const Position& rj,
 
 double BondThreeBody::random_angle_radians(const Angle& angle,
     const double beta, const int dimension, Random * random) const {
+  static const PropertyKey minimum_degrees_key("minimum_degrees");
   ASSERT(dimension == 2 || dimension == 3,
     "unrecognized dimension: " << dimension);
   double min_rad = 0.;
-  if (angle.has_property("minimum_degrees")) {
-    min_rad = degrees_to_radians(angle.property("minimum_degrees"));
+  if (angle.has_property(minimum_degrees_key)) {
+    min_rad = degrees_to_radians(angle.property(minimum_degrees_key));
   }
   int attempt = 0;
   while (attempt < 1e6) {
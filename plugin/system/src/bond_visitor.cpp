@@ -61,8 +61,88 @@ BondVisitor::BondVisitor(std::istream& istr) {
   feasst_deserialize(&verbose_, istr);
 }
 
+void BondVisitor::compile_(const Configuration& config) {
+  if (&config == compiled_config_ &&
+      config.particle_types_revision() == compiled_revision_) {
+    return;
+  }
+  compiled_config_ = &config;
+  compiled_revision_ = config.particle_types_revision();
+  const int num_types = config.num_particle_types();
+  bond_terms_.assign(num_types, std::vector<std::vector<int> >());
+  angle_terms_.assign(num_types, std::vector<std::vector<int> >());
+  dihedral_terms_.assign(num_types, std::vector<std::vector<int> >());
+  bond_models_.assign(num_types, std::vector<const BondTwoBody*>());
+  angle_models_.assign(num_types, std::vector<const BondThreeBody*>());
+  dihedral_models_.assign(num_types, std::vector<const BondFourBody*>());
+  for (int ptype = 0; ptype < num_types; ++ptype) {
+    const Particle& unique_part = config.unique_type(ptype);
+    for (const Bond& bond : unique_part.bonds()) {
+      ASSERT(bond_->deserialize_map().count(bond.model()) == 1,
+        "bond model " << bond.model() << " not recognized.");
+      bond_models_[ptype].push_back(
+        bond_->deserialize_map()[bond.model()].get());
+    }
+    for (const Angle& angle : unique_part.angles()) {
+      ASSERT(angle_->deserialize_map().count(angle.model()) == 1,
+        "angle model " << angle.model() << " not recognized.");
+      angle_models_[ptype].push_back(
+        angle_->deserialize_map()[angle.model()].get());
+    }
+    for (const Dihedral& dihedral : unique_part.dihedrals()) {
+      ASSERT(dihedral_->deserialize_map().count(dihedral.model()) == 1,
+        "dihedral model " << dihedral.model() << " not recognized.");
+      dihedral_models_[ptype].push_back(
+        dihedral_->deserialize_map()[dihedral.model()].get());
+    }
+    const Particle& part_type = config.particle_type(ptype);
+    const int num_sites = part_type.num_sites();
+    bond_terms_[ptype].resize(num_sites);
+    angle_terms_[ptype].resize(num_sites);
+    dihedral_terms_[ptype].resize(num_sites);
+    for (int site0 = 0; site0 < num_sites; ++site0) {
+      if (part_type.num_bonds() > 0) {
+        for (int site1 : part_type.bond_neighbors(site0)) {
+          std::vector<int> * terms = &bond_terms_[ptype][site0];
+          terms->push_back(site1);
+          terms->push_back(part_type.bond(site0, site1).type());
+        }
+      }
+      if (part_type.num_angles() > 0) {
+        for (const std::vector<int>& ang : part_type.angle_neighbors(site0)) {
+          std::vector<int> * terms = &angle_terms_[ptype][site0];
+          terms->push_back(ang[0]);
+          terms->push_back(ang[1]);
+          terms->push_back(part_type.angle(site0, ang[0], ang[1]).type());
+        }
+      }
+      if (part_type.num_dihedrals() > 0) {
+        for (const std::vector<int>& dih : part_type.dihedral_neighbors(site0)) {
+          std::vector<int> * terms = &dihedral_terms_[ptype][site0];
+          terms->push_back(dih[0]);
+          terms->push_back(dih[1]);
+          terms->push_back(dih[2]);
+          terms->push_back(part_type.dihedral(site0, dih[0], dih[1],
+                                              dih[2]).type());
+        }
+      }
+    }
+  }
+}
+
+void BondVisitor::select_sites_(const std::vector<int>& sites,
+    const int num_sites, const int value) {
+  if (static_cast<int>(is_selected_.size()) < num_sites) {
+    is_selected_.resize(num_sites, 0);
+  }
+  for (const int site : sites) {
+    is_selected_[site] = value;
+  }
+}
+
 void BondVisitor::compute_two(const Select& selection,
     const Configuration& config) {
+  compile_(config);
   double en = 0.;
   //TRACE(selection.str());
   for (int select_index = 0;
@@ -70,27 +150,26 @@ void BondVisitor::compute_two(const Select& selection,
        ++select_index) {
     const int part_index = selection.particle_index(select_index);
     const Particle& part = config.select_particle(part_index);
-    const Particle& unique_part = config.unique_type(part.type());
-    const Particle& part_type = config.particle_type(part.type());
-    if (part_type.num_bonds() == 0) continue;
-    for (int site0_index : selection.site_indices(select_index)) {
+    const int ptype = part.type();
+    if (config.particle_type(ptype).num_bonds() == 0) continue;
+    const Particle& unique_part = config.unique_type(ptype);
+    const std::vector<int>& sites = selection.site_indices(select_index);
+    select_sites_(sites, part.num_sites(), 1);
+    for (int site0_index : sites) {
       DEBUG("site0_index " << site0_index);
       const Site& site0 = part.site(site0_index);
-      for (int site1_index : part_type.bond_neighbors(site0_index)) {
+      const std::vector<int>& terms = bond_terms_[ptype][site0_index];
+      for (int index = 0; index < static_cast<int>(terms.size()); index += 2) {
+        const int site1_index = terms[index];
         DEBUG("site1_index " << site1_index);
         const Site& site1 = part.site(site1_index);
         if (site1.is_physical()) {
-          if (site0_index < site1_index ||
-              !find_in_list(site1_index,
-                            selection.site_indices(select_index))) {
+          if (site0_index < site1_index || is_selected_[site1_index] == 0) {
             const Position& ri = site0.position();
             const Position& rj = site1.position();
-            const Bond& bond_type = part_type.bond(site0_index, site1_index);
-            const Bond& bond = unique_part.bond(bond_type.type());
-            ASSERT(bond_->deserialize_map().count(bond.model()) == 1,
-              "bond model " << bond.model() << " not recognized.");
-            en += bond_->deserialize_map()[bond.model()]->energy(
-              ri, rj, bond);
+            const int type = terms[index + 1];
+            const Bond& bond = unique_part.bond(type);
+            en += bond_models_[ptype][type]->energy(ri, rj, bond);
             if (verbose_) {
               if (std::abs(en) > NEAR_ZERO) {
                 TRACE("bond ij " << part_index << " " << bond.site(0) << " "
@@ -101,6 +180,7 @@ void BondVisitor::compute_two(const Select& selection,
         }
       }
     }
+    select_sites_(sites, part.num_sites(), 0);
   }
   energy_two_body_ = en;
 }
@@ -109,21 +189,25 @@ void BondVisitor::compute_three(
     const Select& selection,
     const Configuration& config) {
   TRACE("BondThreeBody of " << selection.str());
+  compile_(config);
   double en = 0.;
   for (int select_index = 0;
        select_index < selection.num_particles();
        ++select_index) {
     const int part_index = selection.particle_index(select_index);
     const Particle& part = config.select_particle(part_index);
-    const Particle& part_type = config.particle_type(part.type());
-    if (part_type.num_angles() == 0) continue;
-    const Particle& unique_part = config.unique_type(part.type());
-    for (int site0_index : selection.site_indices(select_index)) {
+    const int ptype = part.type();
+    if (config.particle_type(ptype).num_angles() == 0) continue;
+    const Particle& unique_part = config.unique_type(ptype);
+    const std::vector<int>& sites = selection.site_indices(select_index);
+    select_sites_(sites, part.num_sites(), 1);
+    for (int site0_index : sites) {
       const Site& site0 = part.site(site0_index);
       DEBUG("site0_index " << site0_index);
-      for (const std::vector<int>& ang : part_type.angle_neighbors(site0_index)) {
-        const int site1_index = ang[0];
-        const int site2_index = ang[1];
+      const std::vector<int>& terms = angle_terms_[ptype][site0_index];
+      for (int index = 0; index < static_cast<int>(terms.size()); index += 3) {
+        const int site1_index = terms[index];
+        const int site2_index = terms[index + 1];
         const Site& site1 = part.site(site1_index);
         const Site& site2 = part.site(site2_index);
         if (site1.is_physical() && site2.is_physical()) {
@@ -133,17 +217,13 @@ void BondVisitor::compute_three(
              Therefore, when avoiding double counts for whole-molecule compute,
              check that site0 < site2, unless site2 isn't in selection.
            */
-          if (site0_index < site2_index ||
-              !find_in_list(site2_index, selection.site_indices(select_index))) {
+          if (site0_index < site2_index || is_selected_[site2_index] == 0) {
             TRACE("sites " << site0_index << " " << site1_index << " " << site2_index);
             const Position * ri = &site0.position();
             const Position * rj = &site1.position();
             const Position * rk = &site2.position();
-            const Angle& angle_type = part_type.angle(site0_index,
-              site1_index, site2_index);
-            const Angle& angle = unique_part.angle(angle_type.type());
-            ASSERT(angle_->deserialize_map().count(angle.model()) == 1,
-              "angle model " << angle.model() << " not recognized.");
+            const int type = terms[index + 2];
+            const Angle& angle = unique_part.angle(type);
 
             // In 2D, angle i-j-k is not the same as k-j-i.
             // angle i-j-k = 2pi - angle k-j-i
@@ -154,8 +234,7 @@ void BondVisitor::compute_three(
                 rk = &site0.position();
               }
             }
-            en += angle_->deserialize_map()[angle.model()]->energy(
-              *ri, *rj, *rk, angle);
+            en += angle_models_[ptype][type]->energy(*ri, *rj, *rk, angle);
             if (verbose_) {
               if (std::abs(en) > NEAR_ZERO) {
                 const double ang = rj->vertex_angle_radians(*ri, *rk);
@@ -174,6 +253,7 @@ void BondVisitor::compute_three(
         }
       }
     }
+    select_sites_(sites, part.num_sites(), 0);
   }
   energy_three_body_ = en;
 }
@@ -181,21 +261,25 @@ void BondVisitor::compute_three(
 void BondVisitor::compute_four(
     const Select& selection,
     const Configuration& config) {
+  compile_(config);
   double en = 0.;
   for (int select_index = 0;
        select_index < selection.num_particles();
        ++select_index) {
     const int part_index = selection.particle_index(select_index);
     const Particle& part = config.select_particle(part_index);
-    const Particle& unique_part = config.unique_type(part.type());
-    const Particle& part_type = config.particle_type(part.type());
-    if (part_type.num_dihedrals() == 0) continue;
-    for (int site0_index : selection.site_indices(select_index)) {
+    const int ptype = part.type();
+    if (config.particle_type(ptype).num_dihedrals() == 0) continue;
+    const Particle& unique_part = config.unique_type(ptype);
+    const std::vector<int>& sites = selection.site_indices(select_index);
+    select_sites_(sites, part.num_sites(), 1);
+    for (int site0_index : sites) {
       const Site& site0 = part.site(site0_index);
-      for (const std::vector<int>& dih : part_type.dihedral_neighbors(site0_index)) {
-        const int site1_index = dih[0];
-        const int site2_index = dih[1];
-        const int site3_index = dih[2];
+      const std::vector<int>& terms = dihedral_terms_[ptype][site0_index];
+      for (int index = 0; index < static_cast<int>(terms.size()); index += 4) {
+        const int site1_index = terms[index];
+        const int site2_index = terms[index + 1];
+        const int site3_index = terms[index + 2];
         const Site& site1 = part.site(site1_index);
         const Site& site2 = part.site(site2_index);
         const Site& site3 = part.site(site3_index);
@@ -206,8 +290,7 @@ void BondVisitor::compute_four(
              Therefore, when avoiding double counts for whole-molecule compute,
              check that site0 < site3, unless site3 isn't in selection.
            */
-          if (site0_index < site3_index ||
-              !find_in_list(site3_index, selection.site_indices(select_index))) {
+          if (site0_index < site3_index || is_selected_[site3_index] == 0) {
             const Position& ri = site0.position();
             const Position& rj = site1.position();
             const Position& rk = site2.position();
@@ -216,15 +299,12 @@ void BondVisitor::compute_four(
             TRACE("rj " << rj.str());
             TRACE("rk " << rk.str());
             TRACE("rl " << rl.str());
-            const Dihedral& dihedral_type = part_type.dihedral(site0_index, site1_index,
-              site2_index, site3_index);
-            TRACE("type of dihedral " << dihedral_type.type());
-            const Dihedral& dihedral = unique_part.dihedral(dihedral_type.type());
+            const int type = terms[index + 3];
+            TRACE("type of dihedral " << type);
+            const Dihedral& dihedral = unique_part.dihedral(type);
             TRACE("model of dihedral " << dihedral.model());
-            ASSERT(dihedral_->deserialize_map().count(dihedral.model()) == 1,
-              "dihedral model " << dihedral.model() << " not recognized.");
-            en += dihedral_->deserialize_map()[dihedral.model()]->energy(
-              ri, rj, rk, rl, dihedral);
+            en += dihedral_models_[ptype][type]->energy(ri, rj, rk, rl,
+                                                        dihedral);
             TRACE("en: " << en << " sites " << site0_index << " " << site1_index << " " << site2_index << " " << site3_index);
             if (verbose_) {
               if (std::abs(en) > NEAR_ZERO) {
@@ -235,6 +315,7 @@ void BondVisitor::compute_four(
         }
       }
     }
+    select_sites_(sites, part.num_sites(), 0);
   }
   energy_four_body_ = en;
 }
@@ -55,7 +55,8 @@ void Cells::build_neighbors_2D_() {
 }
 
 void Cells::build_particles_() {
-  particles_.resize(num_total());
+  particle_.resize(num_total());
+  site_.resize(num_total());
 }
 
 int Cells::num_total() const {
@@ -65,6 +66,9 @@ int Cells::num_total() const {
 void Cells::clear() {
   num_.clear();
   neighbor_.clear();
+  particle_.clear();
+  site_.clear();
+  slot_.clear();
 }
 
 int Cells::id_(std::vector<int> position) {
@@ -107,52 +111,146 @@ int Cells::id(const std::vector<double>& scaled_coord) const {
 
 int Cells::num_sites() const {
   int num = 0;
-  for (const Select& sel : particles()) {
-    num += sel.num_sites();
+  for (const std::vector<int>& particles : particle_) {
+    num += static_cast<int>(particles.size());
   }
   return num;
 }
 
+Select Cells::particles(const int cell) const {
+  Select select;
+  for (int index = 0; index < num_sites(cell); ++index) {
+    select.add_site(particle_[cell][index], site_[cell][index]);
+  }
+  return select;
+}
+
 std::string Cells::str() const {
   std::stringstream ss;
-  for (int cell = 0; cell < num_total(); ++cell) {
-    const Select& select = particles_[cell];
-    if (select.num_particles() != 0) {
-      ss << "cell: " << cell << " p: " << select.str();
+  for (int cell = 0; cell < static_cast<int>(particle_.size()); ++cell) {
+    if (num_sites(cell) != 0) {
+      ss << "cell: " << cell << " p: " << particles(cell).str();
     }
   }
   return ss.str();
 }
 
 void Cells::serialize(std::ostream& sstr) const {
-  feasst_serialize_version(958, sstr);
+  feasst_serialize_version(959, sstr);
   feasst_serialize(type_, sstr);
   feasst_serialize(num_, sstr);
   feasst_serialize(neighbor_, sstr);
   feasst_serialize(group_, sstr);
-  feasst_serialize_fstobj(particles_, sstr);
+  feasst_serialize(particle_, sstr);
+  feasst_serialize(site_, sstr);
+  feasst_serialize(slot_, sstr);
 }
 
 Cells::Cells(std::istream& sstr) {
   const int version = feasst_deserialize_version(sstr);
-  ASSERT(version == 958, "unrecognized version: " << version);
+  ASSERT(version >= 958 && version <= 959,
+    "unrecognized version: " << version);
   feasst_deserialize(&type_, sstr);
   feasst_deserialize(&num_, sstr);
   feasst_deserialize(&neighbor_, sstr);
   feasst_deserialize(&group_, sstr);
-  feasst_deserialize_fstobj(&particles_, sstr);
+  if (version >= 959) {
+    feasst_deserialize(&particle_, sstr);
+    feasst_deserialize(&site_, sstr);
+    feasst_deserialize(&slot_, sstr);
+  } else {
+    std::vector<Select> particles;
+    feasst_deserialize_fstobj(&particles, sstr);
+    build_particles_();
+    for (int cell = 0; cell < static_cast<int>(particles.size()); ++cell) {
+      add(particles[cell], cell);
+    }
+  }
+}
+
+int Cells::find_slot_(const int particle_index, const int site_index) const {
+  if (particle_index < static_cast<int>(slot_.size())) {
+    const std::vector<int>& slots = slot_[particle_index];
+    if (site_index < static_cast<int>(slots.size())) {
+      return slots[site_index];
+    }
+  }
+  return -1;
+}
+
+void Cells::add(const int particle_index, const int site_index,
+                const int cell) {
+  ASSERT(cell < static_cast<int>(particle_.size()),
+    "cell:" << cell << " >= number of cells:" << particle_.size());
+  ASSERT(find_slot_(particle_index, site_index) == -1,
+    "particle:" << particle_index << " site:" << site_index <<
+    " is already in a cell");
+  if (particle_index >= static_cast<int>(slot_.size())) {
+    slot_.resize(particle_index + 1);
+  }
+  std::vector<int> * slots = &slot_[particle_index];
+  if (site_index >= static_cast<int>(slots->size())) {
+    slots->resize(site_index + 1, -1);
+  }
+  (*slots)[site_index] = static_cast<int>(particle_[cell].size());
+  particle_[cell].push_back(particle_index);
+  site_[cell].push_back(site_index);
 }
 
-void Cells::update(const Select& select, const int cell_new, const int cell_old) {
-  //ASSERT(cell_old < static_cast<int>(particles_.size()),
-  //  "cell_old:" << cell_old << " >= number of cells:" << particles_.size());
-  // skip if there are no longer that many cells
-  if (cell_old < static_cast<int>(particles_.size())) {
-    particles_[cell_old].remove(select);
+void Cells::remove(const int particle_index, const int site_index,
+                   const int cell) {
+  // skip if there are no longer that many cells, or the site was not added
+  // since the cells were rebuilt.
+  if (cell >= static_cast<int>(particle_.size())) {
+    return;
+  }
+  const int slot = find_slot_(particle_index, site_index);
+  if (slot == -1) {
+    return;
   }
-  ASSERT(cell_new < static_cast<int>(particles_.size()),
-    "cell_new:" << cell_new << " >= number of cells:" << particles_.size());
-  particles_[cell_new].add(select);
+  std::vector<int> * particles = &particle_[cell];
+  std::vector<int> * sites = &site_[cell];
+  ASSERT(slot < static_cast<int>(particles->size()) &&
+         (*particles)[slot] == particle_index &&
+         (*sites)[slot] == site_index,
+    "particle:" << particle_index << " site:" << site_index <<
+    " is not in cell:" << cell);
+  const int last_particle = particles->back();
+  const int last_site = sites->back();
+  (*particles)[slot] = last_particle;
+  (*sites)[slot] = last_site;
+  slot_[last_particle][last_site] = slot;
+  particles->pop_back();
+  sites->pop_back();
+  slot_[particle_index][site_index] = -1;
+}
+
+void Cells::update(const int particle_index, const int site_index,
+                   const int cell_new, const int cell_old) {
+  remove(particle_index, site_index, cell_old);
+  add(particle_index, site_index, cell_new);
+}
+
+void Cells::add(const Select& select, const int cell) {
+  for (int sp = 0; sp < select.num_particles(); ++sp) {
+    for (const int site_index : select.site_indices(sp)) {
+      add(select.particle_index(sp), site_index, cell);
+    }
+  }
+}
+
+void Cells::remove(const Select& select, const int cell) {
+  for (int sp = 0; sp < select.num_particles(); ++sp) {
+    for (const int site_index : select.site_indices(sp)) {
+      remove(select.particle_index(sp), site_index, cell);
+    }
+  }
+}
+
+void Cells::update(const Select& select, const int cell_new,
+                   const int cell_old) {
+  remove(select, cell_old);
+  add(select, cell_new);
 }
 
 }  // namespace feasst
@@ -3,6 +3,7 @@
 #include "utils/include/arguments_extra.h"
 #include "utils/include/serialize.h"
 #include "utils/include/cache.h"
+#include "utils/include/profiler.h"
 #include "math/include/constants.h"
 #include "math/include/utils_math.h"
 #include "math/include/table.h"
@@ -13,6 +14,7 @@
 #include "configuration/include/model_params.h"
 #include "system/include/model.h"
 #include "system/include/visit_model.h"
+#include "system/include/visit_counters.h"
 #include "system/include/model_empty.h"
 #include "system/include/model_two_body.h"
 #include "system/include/model_two_body_table.h"
@@ -158,15 +160,32 @@ const ModelParams& Potential::model_params(const Configuration& config) const {
   return config.model_params();
 }
 
+// Return the number of pairs tested by the current thread, if counted.
+static int64_t pairs_tested_() {
+  return VisitCounters::thread_counters()->count(VisitCounters::pairs_tested);
+}
+
+// Lazily obtain the Profiler section, named by the VisitModel and Model.
+int Potential::profile_section_id_() {
+  if (profile_section_ == -1) {
+    profile_section_ = Profiler::section(visit_model_->class_name() + ":" +
+                                         model_->class_name());
+  }
+  return profile_section_;
+}
+
 double Potential::energy(Configuration * config) {
   ASSERT(visit_model_, "visitor must be set.");
   if (prevent_cache_ || !cache_->is_unloading(&stored_energy_)) {
+    ProfileScope profile(profile_section_id_());
+    const int64_t pairs = pairs_tested_();
     if (model_params_override_) {
       stored_energy_ = model_->compute(*model_params_, group_index_, config,
                                        visit_model_.get());
     } else {
       stored_energy_ = model_->compute(group_index_, config, visit_model_.get());
     }
+    Profiler::thread_profiler()->count(pairs_tested_() - pairs);
     DEBUG("caching " << stored_energy_ << " in " << model_->class_name());
     cache_->load(stored_energy_);
   }
@@ -176,6 +195,8 @@ double Potential::energy(Configuration * config) {
 double Potential::select_energy(const Select& select, Configuration * config) {
   ASSERT(visit_model_, "visitor must be set.");
   if (prevent_cache_ || !cache_->is_unloading(&stored_energy_)) {
+    ProfileScope profile(profile_section_id_());
+    const int64_t pairs = pairs_tested_();
     if (model_params_override_) {
       stored_energy_ = model_->compute(*model_params_, select, group_index_,
                                        config, visit_model_.get());
@@ -183,6 +204,7 @@ double Potential::select_energy(const Select& select, Configuration * config) {
       stored_energy_ = model_->compute(select, group_index_, config,
                                        visit_model_.get());
     }
+    Profiler::thread_profiler()->count(pairs_tested_() - pairs);
     DEBUG("caching " << stored_energy_ << " in " << model_->class_name());
     cache_->load(stored_energy_);
   }
@@ -30,8 +30,10 @@ void RigidAngle::serialize(std::ostream& ostr) const {
 }
 
 double RigidAngle::energy(const double radians, const Bond& angle) const {
-  const double theta = degrees_to_radians(angle.property("degrees"));
-  const double delta = degrees_to_radians(angle.property("delta"));
+  static const PropertyKey degrees_key("degrees");
+  static const PropertyKey delta_key("delta");
+  const double theta = degrees_to_radians(angle.property(degrees_key));
+  const double delta = degrees_to_radians(angle.property(delta_key));
   ASSERT(!std::isnan(radians), "radians is nan");
   if (std::abs(radians - theta) > delta) {
     FATAL("radians(" << radians << ")-theta(" << theta << ")=" << radians - theta
@@ -42,7 +44,8 @@ double RigidAngle::energy(const double radians, const Bond& angle) const {
 
 double RigidAngle::random_angle_radians(const Angle& angle, const double beta,
     const int dimension, Random * random) const {
-  return degrees_to_radians(angle.property("degrees"));
+  static const PropertyKey degrees_key("degrees");
+  return degrees_to_radians(angle.property(degrees_key));
 }
 
 void RigidAngle::random_branch(
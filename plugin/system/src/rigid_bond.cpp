@@ -29,8 +29,10 @@ void RigidBond::serialize(std::ostream& ostr) const {
 }
 
 double RigidBond::energy(const double distance, const Bond& bond) const {
-  const double length = bond.property("length");
-  const double delta = bond.property("delta");
+  static const PropertyKey length_key("length");
+  static const PropertyKey delta_key("delta");
+  const double length = bond.property(length_key);
+  const double delta = bond.property(delta_key);
   if (std::abs(distance - length) > delta) {
     FATAL("distance(" << distance << ")-length(" << length << ")=" <<
       distance - length << " > delta: " << delta);
@@ -40,7 +42,8 @@ double RigidBond::energy(const double distance, const Bond& bond) const {
 
 double RigidBond::random_distance(const Bond& bond, const double beta,
     const int dimen, Random * random) const {
-  return bond.property("length");
+  static const PropertyKey length_key("length");
+  return bond.property(length_key);
 }
 
 }  // namespace feasst
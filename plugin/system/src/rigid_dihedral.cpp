@@ -30,9 +30,11 @@ void RigidDihedral::serialize(std::ostream& ostr) const {
 }
 
 double RigidDihedral::energy(const double radians, const Bond& dihedral) const {
+  static const PropertyKey degrees_key("degrees");
+  static const PropertyKey delta_key("delta");
   TRACE("radians " << radians);
-  const double theta = degrees_to_radians(dihedral.property("degrees"));
-  const double delta = degrees_to_radians(dihedral.property("delta"));
+  const double theta = degrees_to_radians(dihedral.property(degrees_key));
+  const double delta = degrees_to_radians(dihedral.property(delta_key));
   ASSERT(!std::isnan(radians), "radians is nan");
   if (std::abs(radians - theta) > delta) {
     return NEAR_INFINITY;
@@ -42,7 +44,8 @@ double RigidDihedral::energy(const double radians, const Bond& dihedral) const {
 
 double RigidDihedral::random_dihedral_radians(const Dihedral& dihedral,
     const double beta, const int dimension, Random * random) const {
-  return degrees_to_radians(dihedral.property("degrees"));
+  static const PropertyKey degrees_key("degrees");
+  return degrees_to_radians(dihedral.property(degrees_key));
 }
 
 }  // namespace feasst
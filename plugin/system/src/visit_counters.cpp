@@ -0,0 +1,30 @@
+#include "utils/include/debug.h"
+#include "system/include/visit_counters.h"
+
+namespace feasst {
+
+bool VisitCounters::is_enabled() {
+  #ifdef FEASST_VISIT_COUNTERS
+    return true;
+  #else  // FEASST_VISIT_COUNTERS
+    return false;
+  #endif  // FEASST_VISIT_COUNTERS
+}
+
+std::string VisitCounters::name(const int counter) {
+  switch (counter) {
+    case pairs_tested: return std::string("pairs_tested");
+    case pairs_in_cutoff: return std::string("pairs_in_cutoff");
+    case cells_visited: return std::string("cells_visited");
+    case early_exits: return std::string("early_exits");
+    default: FATAL("unrecognized counter: " << counter);
+  }
+}
+
+void VisitCounters::reset() {
+  for (int counter = 0; counter < num_counters; ++counter) {
+    counts_[counter] = 0;
+  }
+}
+
+}  // namespace feasst
@@ -4,6 +4,7 @@
 #include "utils/include/arguments.h"
 #include "utils/include/utils.h"
 #include "utils/include/serialize_extra.h"
+#include "utils/include/profiler.h"
 #include "math/include/constants.h"
 #include "math/include/position.h"
 #include "configuration/include/particle_factory.h"
@@ -16,6 +17,7 @@
 #include "system/include/model_two_body.h"
 #include "system/include/model_three_body.h"
 #include "system/include/ideal_gas.h"
+#include "system/include/visit_counters.h"
 #include "system/include/visit_model_inner.h"
 #include "system/include/visit_model.h"
 
@@ -33,6 +35,7 @@ VisitModel::VisitModel(argtype * args) {
     ASSERT(energy_cutoff_ > 1e10, "energy_cutoff:" << energy_cutoff_ <<
       " should be > 1e10 to avoid any trial with a chance of being accepted.");
   }
+  parallel_ = boolean("parallel", args, false);
 }
 VisitModel::VisitModel(argtype args) : VisitModel(&args) {
   feasst_check_all_used(args);
@@ -122,6 +125,42 @@ void VisitModel::compute(
   TRACE("group index " << group_index);
   const Select& selection = config->group_select(group_index);
   TRACE("num p " << selection.num_particles());
+#ifdef _OPENMP
+  if (is_parallel_(*inner)) {
+    const int num = selection.num_particles();
+    std::vector<double> energies(num, 0.);
+    #pragma omp parallel
+    {
+      VisitModelInner thread_inner(*inner);
+      Position relative = *relative_, pbc = *pbc_;
+      #pragma omp for schedule(dynamic)
+      for (int select1_index = 0; select1_index < num - 1; ++select1_index) {
+        thread_inner.set_energy(0.);
+        const int part1_index = selection.particle_index(select1_index);
+        for (int select2_index = select1_index + 1;
+             select2_index < num;
+             ++select2_index) {
+          const int part2_index = selection.particle_index(select2_index);
+          for (int site1_index : selection.site_indices(select1_index)) {
+            for (int site2_index : selection.site_indices(select2_index)) {
+              thread_inner.compute(part1_index, site1_index, part2_index,
+                site2_index, config, model_params, model, false, &relative,
+                &pbc);
+            }
+          }
+        }
+        energies[select1_index] = thread_inner.energy();
+      }
+    }
+    double energy = 0.;
+    for (const double en : energies) {
+      energy += en;
+    }
+    inner->set_energy(energy);
+    set_energy(inner->energy());
+    return;
+  }
+#endif // _OPENMP
   for (int select1_index = 0;
        select1_index < selection.num_particles() - 1;
        ++select1_index) {
@@ -136,6 +175,7 @@ void VisitModel::compute(
           inner->compute(part1_index, site1_index, part2_index,
             site2_index, config, model_params, model, false, relative_.get(), pbc_.get());
           if ((energy_cutoff_ != -1) && (inner->energy() > energy_cutoff_)) {
+            FEASST_VISIT_COUNT(early_exits);
             set_energy(inner->energy());
             return;
           }
@@ -190,6 +230,7 @@ void VisitModel::compute(
                                     is_old_config,
                                     relative_.get(), pbc_.get());
               if ((energy_cutoff_ != -1) && (inner->energy() > energy_cutoff_)) {
+                FEASST_VISIT_COUNT(early_exits);
                 set_energy(inner->energy());
                 return;
               }
@@ -231,6 +272,7 @@ void VisitModel::compute(
                                     is_old_config,
                                     relative_.get(), pbc_.get());
               if ((energy_cutoff_ != -1) && (inner->energy() > energy_cutoff_)) {
+                FEASST_VISIT_COUNT(early_exits);
                 set_energy(inner->energy());
                 return;
               }
@@ -281,6 +323,7 @@ void VisitModel::compute_between_selection(
                                   is_old_config,
                                   relative_.get(), pbc_.get());
             if ((energy_cutoff_ != -1) && (inner->energy() > energy_cutoff_)) {
+              FEASST_VISIT_COUNT(early_exits);
               set_energy(inner->energy());
               return;
             }
@@ -339,7 +382,7 @@ std::shared_ptr<VisitModel> VisitModel::factory(const std::string name, argtype
 }
 
 void VisitModel::serialize_visit_model_(std::ostream& ostr) const {
-  feasst_serialize_version(545, ostr);
+  feasst_serialize_version(546, ostr);
   feasst_serialize(energy_, ostr);
   feasst_serialize(epsilon_index_, ostr);
   feasst_serialize(sigma_index_, ostr);
@@ -349,12 +392,13 @@ void VisitModel::serialize_visit_model_(std::ostream& ostr) const {
   feasst_serialize_fstdr(inner_, ostr);
   feasst_serialize_fstobj(data_, ostr);
   feasst_serialize_fstobj(manual_data_, ostr);
+  feasst_serialize(parallel_, ostr);
 }
 
 VisitModel::VisitModel(std::istream& istr) {
   istr >> class_name_;
   const int version = feasst_deserialize_version(istr);
-  ASSERT(545 == version, "mismatch: " << version);
+  ASSERT(version >= 545 && version <= 546, "mismatch: " << version);
   feasst_deserialize(&energy_, istr);
   feasst_deserialize(&epsilon_index_, istr);
   feasst_deserialize(&sigma_index_, istr);
@@ -371,6 +415,9 @@ VisitModel::VisitModel(std::istream& istr) {
   }
   feasst_deserialize_fstobj(&data_, istr);
   feasst_deserialize_fstobj(&manual_data_, istr);
+  if (version >= 546) {
+    feasst_deserialize(&parallel_, istr);
+  }
 }
 
 void VisitModel::record_pair_(const int part1_index, const int site1_index, const int part2_index, const int site2_index, const Position& rel, int * num_pair, VisitModelInner * inner) {
@@ -700,6 +747,8 @@ void VisitModel::zero_energy() {
 void VisitModel::revert(const Select& select) { inner_->revert(select); }
 
 void VisitModel::finalize(const Select& select, Configuration * config) {
+  static const int profile_section = Profiler::section("energy_map_finalize");
+  ProfileScope profile(profile_section);
   inner_->finalize(select);
 }
 
@@ -738,4 +787,9 @@ bool VisitModel::is_queryable_(const Select& selection, const bool is_old_config
   return false;
 }
 
+bool VisitModel::is_parallel_(const VisitModelInner& inner) const {
+  return parallel_ && energy_cutoff_ == -1 && !inner.is_energy_map() &&
+    inner.class_name() == "VisitModelInner";
+}
+
 }  // namespace feasst
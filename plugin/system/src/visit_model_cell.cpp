@@ -2,6 +2,7 @@
 #include "utils/include/io.h"
 #include "utils/include/utils.h"
 #include "utils/include/serialize.h"
+#include "utils/include/profiler.h"
 #include "configuration/include/particle_factory.h"
 #include "configuration/include/group.h"
 #include "configuration/include/domain.h"
@@ -11,6 +12,7 @@
 #include "system/include/model_two_body.h"
 #include "system/include/model_three_body.h"
 #include "system/include/cells.h"
+#include "system/include/visit_counters.h"
 #include "system/include/visit_model_inner.h"
 #include "system/include/visit_model_cell.h"
 
@@ -71,11 +73,17 @@ double VisitModelCell::min_len_(const Configuration& config) const {
   } else {
     min_length = str_to_double(min_length_);
   }
-  // increase min_length to account for triclinic cells
-  const double factor = config.domain().min_side_length() /
-                        config.domain().inscribed_sphere_diameter();
-  DEBUG("factor " << factor << " new min_length " << factor*min_length);
-  return factor*min_length;
+  return min_length;
+}
+
+// Return the perpendicular widths of the domain, which are the side lengths
+// unless the domain is tilted.
+static std::vector<double> cell_widths_(const Domain& domain) {
+  std::vector<double> widths(domain.dimension());
+  for (int dim = 0; dim < domain.dimension(); ++dim) {
+    widths[dim] = domain.perpendicular_width(dim);
+  }
+  return widths;
 }
 
 void VisitModelCell::precompute(Configuration * config) {
@@ -101,7 +109,7 @@ void VisitModelCell::rebuild_(const Configuration& config) {
   DEBUG("rebuilding");
   const double min_length = min_len_(config);
   Cells cells;
-  cells.create(min_length, config.domain().side_lengths().coord());
+  cells.create(min_length, cell_widths_(config.domain()));
   cells.set_group(group_index_);
   if (cells_->num_total() == 0) {
     // if first initialize of cells
@@ -114,20 +122,39 @@ void VisitModelCell::rebuild_(const Configuration& config) {
   } else {
     FATAL("Requested cell list rejected: min_length:" << min_length <<
           " did not meet requirements when the minimum domain side length " <<
-          "is " << config.domain().min_side_length());
+          "is " << config.domain().min_side_length() << " and the " <<
+          "inscribed sphere diameter is " <<
+          config.domain().inscribed_sphere_diameter());
   }
   DEBUG("num cells " << cells_->num_total());
   DEBUG("volume " << config.domain().volume());
 }
 
+bool VisitModelCell::is_rebuild_required_(const Configuration& config) const {
+  const double min_length = min_len_(config);
+  const std::vector<double> widths = cell_widths_(config.domain());
+  if (static_cast<int>(widths.size()) != static_cast<int>(cells_->num().size())) {
+    return true;
+  }
+  for (int dim = 0; dim < static_cast<int>(widths.size()); ++dim) {
+    if (static_cast<int>(widths[dim]/min_length) != cells_->num(dim)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void VisitModelCell::change_volume(const double delta_volume, const int dimension, Configuration * config) {
-  // HWH optimize check if rebuild is necessary
-  bool rebuild = true;
-  if (rebuild) {
+  // Cells are defined in scaled coordinates, so only rebuild if the number of
+  // cells changes. Otherwise, only the sites which are not scaled with the
+  // domain (e.g., in rigid molecules) may change cells.
+  if (is_rebuild_required_(*config)) {
+    static const int profile_section = Profiler::section("cell_rebuild");
+    ProfileScope profile(profile_section);
     rebuild_(*config);
     DEBUG("position updates after change volume rebuild");
-    position_tracker_(config->group_select(group_index_), config);
   }
+  position_tracker_(config->group_select(group_index_), config);
 }
 
 void VisitModelCell::compute(
@@ -135,9 +162,17 @@ void VisitModelCell::compute(
     const ModelParams& model_params,
     Configuration * config,
     const int group_index) {
+  ASSERT(group_index == group_index_, "not equivalent");
+  compute_all_(model, model_params, config, false);
+}
+
+void VisitModelCell::compute_all_(
+    ModelTwoBody * model,
+    const ModelParams& model_params,
+    Configuration * config,
+    const bool is_old_config) {
   zero_energy();
   const Domain& domain = config->domain();
-  ASSERT(group_index == group_index_, "not equivalent");
   VisitModelInner * inner = get_inner_();
   init_relative_(domain);
 
@@ -152,57 +187,84 @@ void VisitModelCell::compute(
     site -> site
    */
 
-  // loop through neighboring cells where cell1 < cell2 only
-  for (int cell1 = 0; cell1 < cells_->num_total(); ++cell1) {
-    const Select& select1 = cells_->particles()[cell1];
-    for (int cell2 : cells_->neighbor()[cell1]) {
-      if (cell1 < cell2) {
-        const Select& select2 = cells_->particles()[cell2];
-        for (int select1_index = 0;
-             select1_index < select1.num_particles();
-             ++select1_index) {
-          const int part1_index = select1.particle_index(select1_index);
-          for (int select2_index = 0;
-               select2_index < select2.num_particles();
-               ++select2_index) {
-            const int part2_index = select2.particle_index(select2_index);
-            if (part1_index != part2_index) {
-              for (int site1_index : select1.site_indices(select1_index)) {
-                for (int site2_index : select2.site_indices(select2_index)) {
-                  inner->compute(part1_index, site1_index, part2_index,
-                                        site2_index, config, model_params,
-                                        model, false, relative_.get(), pbc_.get());
-                  if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                    set_energy(inner->energy());
-                    return;
-                  }
+#ifdef _OPENMP
+  // each cell1 accumulates the energy of its neighboring cells and itself
+  if (is_parallel_(*inner)) {
+    const int num_cells = cells_->num_total();
+    std::vector<double> energies(num_cells, 0.);
+    #pragma omp parallel
+    {
+      VisitModelInner thread_inner(*inner);
+      Position relative = *relative_, pbc = *pbc_;
+      #pragma omp for schedule(dynamic)
+      for (int cell1 = 0; cell1 < num_cells; ++cell1) {
+        thread_inner.set_energy(0.);
+        const std::vector<int>& parts1 = cells_->particle_indices(cell1);
+        const std::vector<int>& sites1 = cells_->site_indices(cell1);
+        const int num1 = static_cast<int>(parts1.size());
+        for (int cell2 : cells_->neighbor()[cell1]) {
+          if (cell1 < cell2) {
+            FEASST_VISIT_COUNT(cells_visited);
+            const std::vector<int>& parts2 = cells_->particle_indices(cell2);
+            const std::vector<int>& sites2 = cells_->site_indices(cell2);
+            const int num2 = static_cast<int>(parts2.size());
+            for (int index1 = 0; index1 < num1; ++index1) {
+              for (int index2 = 0; index2 < num2; ++index2) {
+                if (parts1[index1] != parts2[index2]) {
+                  thread_inner.compute(parts1[index1], sites1[index1],
+                    parts2[index2], sites2[index2], config, model_params,
+                    model, is_old_config, &relative, &pbc);
                 }
               }
             }
           }
         }
+        FEASST_VISIT_COUNT(cells_visited);
+        for (int index1 = 0; index1 < num1 - 1; ++index1) {
+          for (int index2 = index1 + 1; index2 < num1; ++index2) {
+            if (parts1[index1] != parts1[index2]) {
+              thread_inner.compute(parts1[index1], sites1[index1],
+                parts1[index2], sites1[index2], config, model_params, model,
+                is_old_config, &relative, &pbc);
+            }
+          }
+        }
+        energies[cell1] = thread_inner.energy();
       }
     }
+    double energy = 0.;
+    for (const double en : energies) {
+      energy += en;
+    }
+    inner->set_energy(energy);
+    set_energy(inner->energy());
+    return;
   }
+#endif // _OPENMP
 
-  // loop through the same cell only
+  // loop through neighboring cells where cell1 < cell2 only
   for (int cell1 = 0; cell1 < cells_->num_total(); ++cell1) {
-    const Select& select = cells_->particles()[cell1];
-    for (int select1_index = 0;
-         select1_index < select.num_particles() - 1;
-         ++select1_index) {
-      const int part1_index = select.particle_index(select1_index);
-      for (int select2_index = select1_index + 1;
-           select2_index < select.num_particles();
-           ++select2_index) {
-        const int part2_index = select.particle_index(select2_index);
-        if (part1_index != part2_index) {
-          for (int site1_index : select.site_indices(select1_index)) {
-            for (int site2_index : select.site_indices(select2_index)) {
+    const std::vector<int>& parts1 = cells_->particle_indices(cell1);
+    const std::vector<int>& sites1 = cells_->site_indices(cell1);
+    const int num1 = static_cast<int>(parts1.size());
+    for (int cell2 : cells_->neighbor()[cell1]) {
+      if (cell1 < cell2) {
+        FEASST_VISIT_COUNT(cells_visited);
+        const std::vector<int>& parts2 = cells_->particle_indices(cell2);
+        const std::vector<int>& sites2 = cells_->site_indices(cell2);
+        const int num2 = static_cast<int>(parts2.size());
+        for (int index1 = 0; index1 < num1; ++index1) {
+          const int part1_index = parts1[index1];
+          const int site1_index = sites1[index1];
+          for (int index2 = 0; index2 < num2; ++index2) {
+            const int part2_index = parts2[index2];
+            if (part1_index != part2_index) {
+              const int site2_index = sites2[index2];
               inner->compute(part1_index, site1_index, part2_index,
-                                    site2_index, config, model_params, model,
-                                    false, relative_.get(), pbc_.get());
+                             site2_index, config, model_params,
+                             model, is_old_config, relative_.get(), pbc_.get());
               if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+                FEASST_VISIT_COUNT(early_exits);
                 set_energy(inner->energy());
                 return;
               }
@@ -212,6 +274,32 @@ void VisitModelCell::compute(
       }
     }
   }
+
+  // loop through the same cell only
+  for (int cell1 = 0; cell1 < cells_->num_total(); ++cell1) {
+    const std::vector<int>& parts = cells_->particle_indices(cell1);
+    const std::vector<int>& sites = cells_->site_indices(cell1);
+    const int num = static_cast<int>(parts.size());
+    FEASST_VISIT_COUNT(cells_visited);
+    for (int index1 = 0; index1 < num - 1; ++index1) {
+      const int part1_index = parts[index1];
+      const int site1_index = sites[index1];
+      for (int index2 = index1 + 1; index2 < num; ++index2) {
+        const int part2_index = parts[index2];
+        if (part1_index != part2_index) {
+          const int site2_index = sites[index2];
+          inner->compute(part1_index, site1_index, part2_index,
+                         site2_index, config, model_params, model,
+                         is_old_config, relative_.get(), pbc_.get());
+          if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+            FEASST_VISIT_COUNT(early_exits);
+            set_energy(inner->energy());
+            return;
+          }
+        }
+      }
+    }
+  }
   set_energy(inner->energy());
 }
 
@@ -232,6 +320,17 @@ void VisitModelCell::compute(
     return;
   }
 
+  // If the selection is the entire group, such as for a change in volume,
+  // loop over pairs of cells instead of excluding the selection.
+  const Select& select_all = config->group_select(group_index);
+  if (selection.num_particles() > 1 &&
+      selection.num_particles() == select_all.num_particles() &&
+      selection.is_equal(select_all)) {
+    DEBUG("computing entire select");
+    compute_all_(model, model_params, config, is_old_config);
+    return;
+  }
+
   // If only one particle in selection, simply exclude part1==part2
   DEBUG("num particles in selection " << selection.num_particles());
   if (selection.num_particles() == 1) {
@@ -244,24 +343,24 @@ void VisitModelCell::compute(
         const Site& site1 = part1.site(site1_index);
         const int cell1_index = cell_id_opt_(domain, site1.position());
         for (int cell2_index : cells_->neighbor()[cell1_index]) {
-          const Select& cell2_parts = cells_->particles()[cell2_index];
-          for (int select2_index = 0;
-               select2_index < cell2_parts.num_particles();
-               ++select2_index) {
-            const int part2_index = cell2_parts.particle_index(select2_index);
+          FEASST_VISIT_COUNT(cells_visited);
+          const std::vector<int>& parts2 =
+            cells_->particle_indices(cell2_index);
+          const std::vector<int>& sites2 = cells_->site_indices(cell2_index);
+          const int num2 = static_cast<int>(parts2.size());
+          for (int index2 = 0; index2 < num2; ++index2) {
+            const int part2_index = parts2[index2];
             if (part1_index != part2_index) {
-              TRACE("indices " <<
-                    feasst_str(cell2_parts.site_indices(select2_index)));
-              for (int site2_index : cell2_parts.site_indices(select2_index)) {
-                TRACE("index: " << part1_index << " " << part2_index << " " <<
-                     site1_index << " " << site2_index);
-                inner->compute(part1_index, site1_index, part2_index,
-                                      site2_index, config, model_params, model,
-                                      is_old_config, relative_.get(), pbc_.get());
-                if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                  set_energy(inner->energy());
-                  return;
-                }
+              const int site2_index = sites2[index2];
+              TRACE("index: " << part1_index << " " << part2_index << " " <<
+                   site1_index << " " << site2_index);
+              inner->compute(part1_index, site1_index, part2_index,
+                             site2_index, config, model_params, model,
+                             is_old_config, relative_.get(), pbc_.get());
+              if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+                FEASST_VISIT_COUNT(early_exits);
+                set_energy(inner->energy());
+                return;
               }
             }
           }
@@ -281,24 +380,33 @@ void VisitModelCell::compute(
         const Site& site1 = part1.site(site1_index);
         const int cell1_index = cell_id_opt_(domain, site1.position());
         for (int cell2_index : cells_->neighbor()[cell1_index]) {
-          const Select& cell2_parts = cells_->particles()[cell2_index];
-          for (int select2_index = 0;
-               select2_index < cell2_parts.num_particles();
-               ++select2_index) {
-            const int part2_index = cell2_parts.particle_index(select2_index);
-            if (!find_in_list(part2_index, selection.particle_indices())) {
-              TRACE("indices " <<
-                    feasst_str(cell2_parts.site_indices(select2_index)));
-              for (int site2_index : cell2_parts.site_indices(select2_index)) {
-                TRACE("index: " << part1_index << " " << part2_index << " " <<
-                     site1_index << " " << site2_index);
-                inner->compute(part1_index, site1_index, part2_index,
-                                      site2_index, config, model_params, model,
-                                      is_old_config, relative_.get(), pbc_.get());
-                if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                  set_energy(inner->energy());
-                  return;
-                }
+          FEASST_VISIT_COUNT(cells_visited);
+          const std::vector<int>& parts2 =
+            cells_->particle_indices(cell2_index);
+          const std::vector<int>& sites2 = cells_->site_indices(cell2_index);
+          const int num2 = static_cast<int>(parts2.size());
+          // sites of the same particle are often adjacent, so avoid repeated
+          // searches of the selection for the same particle.
+          int last_part2_index = -1;
+          bool is_in_selection = false;
+          for (int index2 = 0; index2 < num2; ++index2) {
+            const int part2_index = parts2[index2];
+            if (part2_index != last_part2_index) {
+              last_part2_index = part2_index;
+              is_in_selection = find_in_list(part2_index,
+                                             selection.particle_indices());
+            }
+            if (!is_in_selection) {
+              const int site2_index = sites2[index2];
+              TRACE("index: " << part1_index << " " << part2_index << " " <<
+                   site1_index << " " << site2_index);
+              inner->compute(part1_index, site1_index, part2_index,
+                             site2_index, config, model_params, model,
+                             is_old_config, relative_.get(), pbc_.get());
+              if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+                FEASST_VISIT_COUNT(early_exits);
+                set_energy(inner->energy());
+                return;
               }
             }
           }
@@ -329,30 +437,30 @@ void VisitModelCell::compute(
 
   // loop through neighboring cells where cell1 < cell2 only
   for (int cell1 = 0; cell1 < cells_->num_total(); ++cell1) {
-    const Select& select1 = cells_->particles()[cell1];
+    const std::vector<int>& parts1 = cells_->particle_indices(cell1);
+    const std::vector<int>& sites1 = cells_->site_indices(cell1);
+    const int num1 = static_cast<int>(parts1.size());
     for (int cell2 : cells_->neighbor()[cell1]) {
       if (cell1 < cell2) {
-        const Select& select2 = cells_->particles()[cell2];
-        for (int select1_index = 0;
-             select1_index < select1.num_particles();
-             ++select1_index) {
-          const int part1_index = select1.particle_index(select1_index);
-          for (int select2_index = 0;
-               select2_index < select2.num_particles();
-               ++select2_index) {
-            const int part2_index = select2.particle_index(select2_index);
+        FEASST_VISIT_COUNT(cells_visited);
+        const std::vector<int>& parts2 = cells_->particle_indices(cell2);
+        const std::vector<int>& sites2 = cells_->site_indices(cell2);
+        const int num2 = static_cast<int>(parts2.size());
+        for (int index1 = 0; index1 < num1; ++index1) {
+          const int part1_index = parts1[index1];
+          const int site1_index = sites1[index1];
+          for (int index2 = 0; index2 < num2; ++index2) {
+            const int part2_index = parts2[index2];
             if (part1_index != part2_index) {
-              for (int site1_index : select1.site_indices(select1_index)) {
-                for (int site2_index : select2.site_indices(select2_index)) {
-                  inner->compute(part1_index, site1_index, part2_index,
-                                 site2_index, config, model_params,
-                                 two_body, false, relative_.get(), pbc_.get());
-                  record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
-                  if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                    set_energy(inner->energy());
-                    return;
-                  }
-                }
+              const int site2_index = sites2[index2];
+              inner->compute(part1_index, site1_index, part2_index,
+                             site2_index, config, model_params,
+                             two_body, false, relative_.get(), pbc_.get());
+              record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
+              if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+                FEASST_VISIT_COUNT(early_exits);
+                set_energy(inner->energy());
+                return;
               }
             }
           }
@@ -363,27 +471,25 @@ void VisitModelCell::compute(
 
   // loop through the same cell only
   for (int cell1 = 0; cell1 < cells_->num_total(); ++cell1) {
-    const Select& select = cells_->particles()[cell1];
-    for (int select1_index = 0;
-         select1_index < select.num_particles() - 1;
-         ++select1_index) {
-      const int part1_index = select.particle_index(select1_index);
-      for (int select2_index = select1_index + 1;
-           select2_index < select.num_particles();
-           ++select2_index) {
-        const int part2_index = select.particle_index(select2_index);
+    const std::vector<int>& parts = cells_->particle_indices(cell1);
+    const std::vector<int>& sites = cells_->site_indices(cell1);
+    const int num = static_cast<int>(parts.size());
+    FEASST_VISIT_COUNT(cells_visited);
+    for (int index1 = 0; index1 < num - 1; ++index1) {
+      const int part1_index = parts[index1];
+      const int site1_index = sites[index1];
+      for (int index2 = index1 + 1; index2 < num; ++index2) {
+        const int part2_index = parts[index2];
         if (part1_index != part2_index) {
-          for (int site1_index : select.site_indices(select1_index)) {
-            for (int site2_index : select.site_indices(select2_index)) {
-              inner->compute(part1_index, site1_index, part2_index,
-                             site2_index, config, model_params, two_body,
-                             false, relative_.get(), pbc_.get());
-              record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
-              if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                set_energy(inner->energy());
-                return;
-              }
-            }
+          const int site2_index = sites[index2];
+          inner->compute(part1_index, site1_index, part2_index,
+                         site2_index, config, model_params, two_body,
+                         false, relative_.get(), pbc_.get());
+          record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
+          if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+            FEASST_VISIT_COUNT(early_exits);
+            set_energy(inner->energy());
+            return;
           }
         }
       }
@@ -433,46 +539,48 @@ void VisitModelCell::compute(
         const Site& site1 = part1.site(site1_index);
         const int cell1_index = cell_id_opt_(domain, site1.position());
         for (int cell2_index : cells_->neighbor()[cell1_index]) {
-          const Select& cell2_parts = cells_->particles()[cell2_index];
-          for (int select2_index = 0;
-               select2_index < cell2_parts.num_particles();
-               ++select2_index) {
-            const int part2_index = cell2_parts.particle_index(select2_index);
+          FEASST_VISIT_COUNT(cells_visited);
+          const std::vector<int>& parts2 =
+            cells_->particle_indices(cell2_index);
+          const std::vector<int>& sites2 = cells_->site_indices(cell2_index);
+          const int num2 = static_cast<int>(parts2.size());
+          for (int index2 = 0; index2 < num2; ++index2) {
+            const int part2_index = parts2[index2];
             if (part1_index != part2_index) {
-              TRACE("indices " <<
-                    feasst_str(cell2_parts.site_indices(select2_index)));
-              for (int site2_index : cell2_parts.site_indices(select2_index)) {
-                TRACE("index: " << part1_index << " " << part2_index << " " <<
-                     site1_index << " " << site2_index);
-                inner->compute(part1_index, site1_index, part2_index,
-                               site2_index, config, model_params, two_body,
-                               is_old_config, relative_.get(), pbc_.get());
-                record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
-                if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
-                  set_energy(inner->energy());
-                  return;
-                }
+              const int site2_index = sites2[index2];
+              TRACE("index: " << part1_index << " " << part2_index << " " <<
+                   site1_index << " " << site2_index);
+              inner->compute(part1_index, site1_index, part2_index,
+                             site2_index, config, model_params, two_body,
+                             is_old_config, relative_.get(), pbc_.get());
+              record_pair_(part1_index, site1_index, part2_index, site2_index, *relative_, &num_pair, inner);
+              if ((energy_cutoff() != -1) && (inner->energy() > energy_cutoff())) {
+                FEASST_VISIT_COUNT(early_exits);
+                set_energy(inner->energy());
+                return;
+              }
 
-                // now find all pairs of those paired with the pair
-                if (inner->interacted()) {
-                  for (int cell3_index : cells_->neighbor()[cell2_index]) {
-                    const Select& cell3_parts = cells_->particles()[cell3_index];
-                    for (int select3_index = 0;
-                         select3_index < cell3_parts.num_particles();
-                         ++select3_index) {
-                      const int part3_index = cell3_parts.particle_index(select3_index);
-                      DEBUG("part3_index " << part3_index);
-                      if ((part3_index != part1_index) &&
-                          (part3_index != part2_index)) {
-                        for (const int site3_index : cell3_parts.site_indices(select3_index)) {
-                          DEBUG("site3_index " << site3_index);
-                          // check if 3 was already found as a neighbor of 1
-                          if (!find_in_pair3body(part3_index, site3_index, num_pair)) {
-                            inner->compute(part3_index, site3_index, part2_index,
-                              site2_index, config, model_params, &ideal_gas, false, relative_.get(), pbc_.get());
-                            record_pair_(part3_index, site3_index, part2_index, site2_index, *relative_, &num_pair, inner);
-                          }
-                        }
+              // now find all pairs of those paired with the pair
+              if (inner->interacted()) {
+                for (int cell3_index : cells_->neighbor()[cell2_index]) {
+                  FEASST_VISIT_COUNT(cells_visited);
+                  const std::vector<int>& parts3 =
+                    cells_->particle_indices(cell3_index);
+                  const std::vector<int>& sites3 =
+                    cells_->site_indices(cell3_index);
+                  const int num3 = static_cast<int>(parts3.size());
+                  for (int index3 = 0; index3 < num3; ++index3) {
+                    const int part3_index = parts3[index3];
+                    DEBUG("part3_index " << part3_index);
+                    if ((part3_index != part1_index) &&
+                        (part3_index != part2_index)) {
+                      const int site3_index = sites3[index3];
+                      DEBUG("site3_index " << site3_index);
+                      // check if 3 was already found as a neighbor of 1
+                      if (!find_in_pair3body(part3_index, site3_index, num_pair)) {
+                        inner->compute(part3_index, site3_index, part2_index,
+                          site2_index, config, model_params, &ideal_gas, false, relative_.get(), pbc_.get());
+                        record_pair_(part3_index, site3_index, part2_index, site2_index, *relative_, &num_pair, inner);
                       }
                     }
                   }
@@ -519,14 +627,6 @@ void VisitModelCell::position_tracker_(const Select& select,
         const Site& site = part.site(site_index);
         if (group.is_in(site)) {
           const int cell_new = cell_id_opt_(config->domain(), site.position());
-          if (!one_site_select_) {
-            one_site_select_ = std::make_shared<Select>();
-          }
-          if (one_site_select_->num_particles() == 0) {
-            one_site_select_->add_site(0, 0);
-          }
-          one_site_select_->set_particle(0, particle_index);
-          one_site_select_->set_site(0, 0, site_index);
           ParticleFactory * particles = config->get_particles_();
           Site * sitep = particles->get_particle(particle_index)->get_site(site_index);
           if (cells_->type() < site.num_cells()) {
@@ -538,14 +638,13 @@ void VisitModelCell::position_tracker_(const Select& select,
 //              particles->particle(particle_index).site(
 //              site_index).property("cell0"));
             sitep->set_cell(cells_->type(), cell_new);
-            DEBUG(one_site_select_->str());
             DEBUG(cells_->num_total());
-            cells_->update(*one_site_select_, cell_new, cell_old);
+            cells_->update(particle_index, site_index, cell_new, cell_old);
           } else {
             sitep->add_cell(cell_new);
             DEBUG("adding to cell list cllnw "
               << cell_new << " si " << site_index);
-            cells_->add(*one_site_select_, cell_new);
+            cells_->add(particle_index, site_index, cell_new);
           }
         }
       }
@@ -555,6 +654,8 @@ void VisitModelCell::position_tracker_(const Select& select,
 
 void VisitModelCell::finalize(const Select& select, Configuration * config) {
   VisitModel::finalize(select, config);
+  static const int profile_section = Profiler::section("cell_update");
+  ProfileScope profile(profile_section);
   if (select.trial_state() == 2) {
     // remove particles from cell
     for (const int particle_index : select.particle_indices()) {
@@ -568,9 +669,7 @@ void VisitModelCell::finalize(const Select& select, Configuration * config) {
           if (group.is_in(site)) {
             if (cells_->type() < site.num_cells()) {
               const int cell_old = site.cell(cells_->type());
-              Select select;
-              select.add_site(particle_index, site_index);
-              cells_->remove(select, cell_old);
+              cells_->remove(particle_index, site_index, cell_old);
             }
           }
         }
@@ -11,6 +11,7 @@
 #include "system/include/energy_map.h"
 #include "system/include/model_two_body.h"
 #include "system/include/model_three_body.h"
+#include "system/include/visit_counters.h"
 #include "system/include/visit_model_inner.h"
 
 namespace feasst {
@@ -61,6 +62,7 @@ void VisitModelInner::compute(
     if (site2.is_physical()) {
       config->domain().wrap_opt(site1.position(), site2.position(), relative,
                                 pbc, &squared_distance_);
+      FEASST_VISIT_COUNT(pairs_tested);
       const int type1 = site1.type();
       const int type2 = site2.type();
       const double cutoff = model_params.select(cutoff_index()).mixed_values()[type1][type2];
@@ -70,6 +72,7 @@ void VisitModelInner::compute(
       TRACE("indices " << part1_index << " " << site1_index << " " <<
           part2_index << " " << site2_index);
       if (squared_distance_ <= cutoff*cutoff) {
+        FEASST_VISIT_COUNT(pairs_in_cutoff);
         const double energy = weight*model->energy(squared_distance_, type1,
           type2, model_params);
         update_ixn(energy, part1_index, site1_index, type1, part2_index,
@@ -88,6 +91,7 @@ void VisitModelInner::compute(
               if (squared_distance_ > std::pow(cutoff+2.*outer, 2)) {
                 TRACE("skipping! dist: " << squared_distance_ << " > " << std::pow(cutoff+outer, 2));
                 skip_particle_ = true;
+                FEASST_VISIT_COUNT(early_exits);
               }
             }
           }
@@ -72,6 +72,25 @@ void VisitModelIntraMap::precompute(Configuration * config) {
       }
     }
   }
+  build_pair_list_();
+}
+
+void VisitModelIntraMap::build_pair_list_() {
+  pair_list_.clear();
+  pair_list_.resize(include_map_.size());
+  for (int ptype = 0; ptype < static_cast<int>(include_map_.size()); ++ptype) {
+    const int num_sites = static_cast<int>(include_map_[ptype].size());
+    for (int site1 = 0; site1 < num_sites; ++site1) {
+      for (int site2 = site1 + 1; site2 < num_sites; ++site2) {
+        const int map = include_map_[ptype][site1][site2];
+        if (map > 0) {
+          pair_list_[ptype].push_back(site1);
+          pair_list_[ptype].push_back(site2);
+          pair_list_[ptype].push_back(map);
+        }
+      }
+    }
+  }
 }
 
 void VisitModelIntraMap::compute(
@@ -95,13 +114,31 @@ void VisitModelIntraMap::compute(
     const Particle& part1 = config->select_particle(part1_index);
     const int part_type = part1.type();
 
-    // loop through all unique pairs in select
     const std::vector<int>& select_sites = selection.site_indices()[sp1index];
-    for (int s1_index = 0;
-         s1_index < static_cast<int>(select_sites.size()); ++s1_index) {
+    const int num_select_sites = static_cast<int>(select_sites.size());
+
+    // if selection is all sites in particle, loop through the included pairs.
+    if (num_select_sites == part1.num_sites()) {
+      const std::vector<int>& pairs = pair_list_[part_type];
+      for (int index = 0; index < static_cast<int>(pairs.size()); index += 3) {
+        double weight = 1.;
+        if (pairs[index + 2] == 2) {
+          weight = dihedral_weight_;
+        }
+        TRACE("sites: " << pairs[index] << " " << pairs[index + 1]);
+        inner->compute(part1_index, pairs[index], part1_index,
+          pairs[index + 1], config, model_params, model, false,
+          relative_.get(), pbc_.get(), weight);
+      }
+      continue;
+    }
+
+    // otherwise, only loop through pairs which include a site in selection,
+    // such as after a partial regrowth or pivot.
+    // First, loop through all unique pairs in select.
+    for (int s1_index = 0; s1_index < num_select_sites; ++s1_index) {
       const int site1_index = select_sites[s1_index];
-      for (int s2_index = s1_index;
-           s2_index < static_cast<int>(select_sites.size()); ++s2_index) {
+      for (int s2_index = s1_index; s2_index < num_select_sites; ++s2_index) {
         const int site2_index = select_sites[s2_index];
         const int map = include_map_[part_type][site1_index][site2_index];
         if (map > 0) {
@@ -117,27 +154,34 @@ void VisitModelIntraMap::compute(
       }
     }
 
-    // if selection is not all sites in particle, then also loop through all
-    // interactions between sites in particle not in selection
-    if (static_cast<int>(select_sites.size()) < part1.num_sites()) {
-      for (int site1_index = 0; site1_index < part1.num_sites(); ++site1_index) {
-        if (!find_in_list(site1_index, select_sites)) {
-          for (const int site2_index : select_sites) {
-            const int map = include_map_[part_type][site1_index][site2_index];
-            if (map > 0) {
-              double weight = 1.;
-              if (map == 2) {
-                weight = dihedral_weight_;
-              }
-              TRACE("sites: " << site1_index << " " << site2_index);
-              inner->compute(part1_index, site1_index, part1_index,
-                site2_index, config, model_params, model, false, relative_.get(),
-                pbc_.get(), weight);
+    // Second, loop through interactions between sites in selection and the
+    // sites in particle not in selection.
+    if (static_cast<int>(is_selected_.size()) < part1.num_sites()) {
+      is_selected_.resize(part1.num_sites(), 0);
+    }
+    for (const int site_index : select_sites) {
+      is_selected_[site_index] = 1;
+    }
+    for (int site1_index = 0; site1_index < part1.num_sites(); ++site1_index) {
+      if (is_selected_[site1_index] == 0) {
+        for (const int site2_index : select_sites) {
+          const int map = include_map_[part_type][site1_index][site2_index];
+          if (map > 0) {
+            double weight = 1.;
+            if (map == 2) {
+              weight = dihedral_weight_;
             }
+            TRACE("sites: " << site1_index << " " << site2_index);
+            inner->compute(part1_index, site1_index, part1_index,
+              site2_index, config, model_params, model, false, relative_.get(),
+              pbc_.get(), weight);
           }
         }
       }
     }
+    for (const int site_index : select_sites) {
+      is_selected_[site_index] = 0;
+    }
   }
   set_energy(inner->energy());
 }
@@ -152,6 +196,7 @@ VisitModelIntraMap::VisitModelIntraMap(std::istream& istr) : VisitModel(istr) {
     feasst_deserialize(&dihedral_weight_, istr);
   }
   feasst_deserialize(&include_map_, istr);
+  build_pair_list_();
 }
 
 void VisitModelIntraMap::serialize(std::ostream& ostr) const {
@@ -64,4 +64,44 @@ TEST(Cells, cells) {
   EXPECT_EQ(cells.neighbor(), cells2.neighbor());
 }
 
+TEST(Cells, add_remove) {
+  Cells cells;
+  cells.create(1, {6, 6});
+  cells.add(0, 0, 3);
+  cells.add(0, 1, 3);
+  cells.add(2, 0, 3);
+  cells.add(1, 0, 5);
+  EXPECT_EQ(4, cells.num_sites());
+  EXPECT_EQ(3, cells.num_sites(3));
+  EXPECT_EQ(2, cells.particles(3).num_particles());
+  TRY(
+    cells.add(0, 1, 4);
+    CATCH_PHRASE("is already in a cell");
+  );
+
+  // removing the first site swaps the last site into its place
+  cells.remove(0, 0, 3);
+  EXPECT_EQ(std::vector<int>({2, 0}), cells.particle_indices(3));
+  EXPECT_EQ(std::vector<int>({0, 1}), cells.site_indices(3));
+  cells.update(2, 0, 5, 3);
+  EXPECT_EQ(std::vector<int>({0}), cells.particle_indices(3));
+  EXPECT_EQ(std::vector<int>({1}), cells.site_indices(3));
+  EXPECT_EQ(std::vector<int>({1, 2}), cells.particle_indices(5));
+  TRY(
+    cells.remove(2, 0, 3);
+    CATCH_PHRASE("is not in cell");
+  );
+
+  // removing a site that is not in a cell does nothing
+  cells.remove(0, 0, 3);
+  cells.remove(7, 0, 3);
+  EXPECT_EQ(3, cells.num_sites());
+
+  Cells cells2 = test_serialize(cells);
+  EXPECT_EQ(cells.particle_indices(5), cells2.particle_indices(5));
+  cells2.remove(1, 0, 5);
+  EXPECT_EQ(std::vector<int>({2}), cells2.particle_indices(5));
+  EXPECT_EQ(2, cells2.num_sites());
+}
+
 }  // namespace feasst
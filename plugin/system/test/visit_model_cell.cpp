@@ -1,3 +1,6 @@
+#ifdef _OPENMP
+  #include <omp.h>
+#endif // _OPENMP
 #include "utils/test/utils.h"
 #include "math/include/constants.h"
 #include "math/include/random_mt19937.h"
@@ -29,9 +32,9 @@ TEST(VisitModelCell, cells) {
   EXPECT_EQ(cell1, site.cell(0));
   std::vector<int> indices = {0};
 //  EXPECT_EQ(config->domain().cells(0).particles()[0].num_particles(), 0);
-  EXPECT_EQ(visit->cells().particles()[0].num_particles(), 0);
+  EXPECT_EQ(visit->cells().particles(0).num_particles(), 0);
 //  EXPECT_EQ(config->domain().cells(0).particles()[cell0].num_particles(), 1);
-  EXPECT_EQ(visit->cells().particles()[cell1].num_particles(), 1);
+  EXPECT_EQ(visit->cells().particles(cell1).num_particles(), 1);
 //  EXPECT_EQ(config->particle(0).site(0).num_cells(), 2);
   EXPECT_EQ(config->particle(0).site(1).num_cells(), 1);
   Position trajectory({-3.49, -3.49, -3.49});
@@ -51,7 +54,7 @@ TEST(VisitModelCell, cells) {
   EXPECT_EQ(config->particle(0).site(0).num_cells(), 1);
   EXPECT_EQ(config->particle(0).site(1).num_cells(), 1);
   EXPECT_EQ(config->particle(0).site(2).num_cells(), 1);
-  EXPECT_EQ(visit->cells().particles()[cell1].num_particles(), 0);
+  EXPECT_EQ(visit->cells().particles(cell1).num_particles(), 0);
 //  EXPECT_EQ(config->domain().cells(1).particles()[cell1].num_particles(), 0);
   EXPECT_NE(cell1, site.cell(0));
 
@@ -88,12 +91,12 @@ TEST(VisitModelCell, simple_lj) {
   const int center = round(5.*5.*5./2. - 0.5);
   EXPECT_EQ(config->particle(0).site(0).cell(0), center);
   EXPECT_EQ(config->particle(1).site(0).cell(0), center + 1);
-  EXPECT_EQ(cells.particles()[center].num_sites(), 1);
-  EXPECT_EQ(cells.particles()[center].particle_index(0), 0);
-  EXPECT_EQ(cells.particles()[center].site_index(0, 0), 0);
-  EXPECT_EQ(cells.particles()[center + 1].num_sites(), 1);
-  EXPECT_EQ(cells.particles()[center + 1].particle_index(0), 1);
-  EXPECT_EQ(cells.particles()[center + 1].site_index(0, 0), 0);
+  EXPECT_EQ(cells.particles(center).num_sites(), 1);
+  EXPECT_EQ(cells.particles(center).particle_index(0), 0);
+  EXPECT_EQ(cells.particles(center).site_index(0, 0), 0);
+  EXPECT_EQ(cells.particles(center + 1).num_sites(), 1);
+  EXPECT_EQ(cells.particles(center + 1).particle_index(0), 1);
+  EXPECT_EQ(cells.particles(center + 1).site_index(0, 0), 0);
   config->check();
   cell_visit->check(*config);
   VisitModel visit;
@@ -114,12 +117,12 @@ TEST(VisitModelCell, simple_lj) {
   cell_visit->finalize(select, config.get());
   EXPECT_EQ(config->particle(0).site(0).cell(0), center);
   EXPECT_EQ(config->particle(1).site(0).cell(0), center);
-  EXPECT_EQ(cells.particles()[center].num_sites(), 2);
-  EXPECT_EQ(cells.particles()[center].num_particles(), 2);
-  EXPECT_EQ(cells.particles()[center].particle_index(0), 0);
-  EXPECT_EQ(cells.particles()[center].particle_index(1), 1);
-  EXPECT_EQ(cells.particles()[center].site_index(0, 0), 0);
-  EXPECT_EQ(cells.particles()[center].site_index(1, 0), 0);
+  EXPECT_EQ(cells.particles(center).num_sites(), 2);
+  EXPECT_EQ(cells.particles(center).num_particles(), 2);
+  EXPECT_EQ(cells.particles(center).particle_index(0), 0);
+  EXPECT_EQ(cells.particles(center).particle_index(1), 1);
+  EXPECT_EQ(cells.particles(center).site_index(0, 0), 0);
+  EXPECT_EQ(cells.particles(center).site_index(1, 0), 0);
   model.compute(config.get(), &visit);
   model.compute(config.get(), cell_visit.get());
   r2 = 3;
@@ -137,4 +140,79 @@ TEST(VisitModelCell, simple_lj) {
   cell_visit->check_energy(&model, config.get());
 }
 
+TEST(VisitModelCell, change_volume) {
+  auto config = MakeConfiguration({{"particle_type", "lj:../particle/lj.txt"},
+    {"xyz_file", "../plugin/configuration/test/data/lj_sample_config_periodic4.xyz"}});
+  config->set_model_param("cutoff", 0, 1.5);
+  LennardJones model;
+  model.precompute(config.get());
+  VisitModel visit;
+  visit.precompute(config.get());
+  auto cell_visit = MakeVisitModelCell({{"min_length", "1.5"}});
+  cell_visit->precompute(config.get());
+  EXPECT_EQ(5*5*5, cell_visit->cells().num_total());
+  const Cells * cells = &cell_visit->cells();
+
+  // the energy of the selection of all particles uses the cells
+  model.compute(config.get(), &visit);
+  const double en = visit.energy();
+  model.compute(config->selection_of_all(), config.get(), cell_visit.get());
+  EXPECT_NEAR(en, cell_visit->energy(), 1e-12);
+
+  // a small change in volume does not rebuild the cells
+  const double delta_volume = std::pow(8.05, 3) - config->domain().volume();
+  config->change_volume(delta_volume, argtype());
+  cell_visit->change_volume(delta_volume, -1, config.get());
+  EXPECT_EQ(cells, &cell_visit->cells());
+  cell_visit->check(*config);
+  model.compute(config.get(), &visit);
+  model.compute(config->selection_of_all(), config.get(), cell_visit.get());
+  EXPECT_NEAR(visit.energy(), cell_visit->energy(), 1e-12);
+  EXPECT_NE(en, visit.energy());
+
+  // a larger change in volume reduces the number of cells
+  config->change_volume(std::pow(7.4, 3) - config->domain().volume(),
+                        argtype());
+  cell_visit->change_volume(0., -1, config.get());
+  EXPECT_EQ(4*4*4, cell_visit->cells().num_total());
+  cell_visit->check(*config);
+  model.compute(config.get(), &visit);
+  model.compute(config.get(), cell_visit.get());
+  EXPECT_NEAR(visit.energy(), cell_visit->energy(), 1e-12);
+}
+
+TEST(VisitModelCell, parallel) {
+  auto config = MakeConfiguration({{"particle_type", "lj:../particle/lj.txt"},
+    {"xyz_file", "../plugin/configuration/test/data/lj_sample_config_periodic4.xyz"}});
+  config->set_model_param("cutoff", 0, 1.5);
+  LennardJones model;
+  model.precompute(config.get());
+  VisitModel visit;
+  visit.precompute(config.get());
+  model.compute(config.get(), &visit);
+  const double en = visit.energy();
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+  omp_set_num_threads(2);
+  EXPECT_EQ(2, omp_get_max_threads());
+#endif  // _OPENMP
+  auto parallel_visit = MakeVisitModel({{"parallel", "true"}});
+  EXPECT_TRUE(parallel_visit->parallel());
+  parallel_visit->precompute(config.get());
+  model.compute(config.get(), parallel_visit.get());
+  EXPECT_NEAR(en, parallel_visit->energy(), 1e-12);
+  auto cell_visit = MakeVisitModelCell({{"min_length", "1.5"},
+                                        {"parallel", "true"}});
+  cell_visit->precompute(config.get());
+  model.compute(config.get(), cell_visit.get());
+  EXPECT_NEAR(en, cell_visit->energy(), 1e-12);
+  model.compute(config->selection_of_all(), config.get(), cell_visit.get());
+  EXPECT_NEAR(en, cell_visit->energy(), 1e-12);
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif  // _OPENMP
+  auto cell_visit2 = test_serialize<VisitModelCell, VisitModel>(*cell_visit);
+  EXPECT_TRUE(cell_visit2->parallel());
+}
+
 }  // namespace feasst
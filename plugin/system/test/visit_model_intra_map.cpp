@@ -0,0 +1,84 @@
+#include <cmath>
+#include "utils/test/utils.h"
+#include "utils/include/utils.h"
+#include "math/include/position.h"
+#include "configuration/include/particle.h"
+#include "configuration/include/configuration.h"
+#include "configuration/include/model_params.h"
+#include "configuration/include/select.h"
+#include "system/include/lennard_jones.h"
+#include "system/include/visit_model_intra_map.h"
+
+namespace feasst {
+
+// Return the energy of the pairs which include a site in sites, computed
+// directly from the include_map.
+double intra_energy(const std::vector<int>& sites, const Configuration& config,
+    VisitModelIntraMap * visit, LennardJones * model) {
+  const Particle& part = config.particle(0);
+  const ModelParams& params = config.model_params();
+  double en = 0.;
+  for (int site1 = 0; site1 < part.num_sites(); ++site1) {
+    for (int site2 = site1 + 1; site2 < part.num_sites(); ++site2) {
+      if (find_in_list(site1, sites) || find_in_list(site2, sites)) {
+        const int map = visit->include_map(part.type(), site1, site2);
+        if (map > 0) {
+          Position rel = part.site(site1).position();
+          rel.subtract(part.site(site2).position());
+          const double r2 = rel.squared_distance();
+          const int type1 = part.site(site1).type();
+          const int type2 = part.site(site2).type();
+          const double cutoff = params.select("cutoff").mixed_values()[type1][type2];
+          if (r2 <= cutoff*cutoff) {
+            double weight = 1.;
+            if (map == 2) weight = 0.5;
+            en += weight*model->energy(r2, type1, type2, params);
+          }
+        }
+      }
+    }
+  }
+  return en;
+}
+
+TEST(VisitModelIntraMap, pair_list) {
+  auto config = MakeConfiguration({{"cubic_side_length", "40"},
+    {"particle_type", "decane:../particle/n-decane.txt"},
+    {"add_num_decane_particles", "1"}});
+  LennardJones model;
+  model.precompute(config.get());
+  auto visit = MakeVisitModelIntraMap({{"exclude_bonds", "true"},
+    {"exclude_angles", "true"}, {"dihedral_weight", "0.5"}});
+  visit->precompute(config.get());
+  EXPECT_EQ(0, visit->include_map(0, 3, 4));
+  EXPECT_EQ(0, visit->include_map(0, 3, 5));
+  EXPECT_EQ(2, visit->include_map(0, 3, 6));
+  EXPECT_EQ(1, visit->include_map(0, 3, 7));
+
+  // all sites
+  const Select all(0, config->particle(0));
+  model.compute(all, config.get(), visit.get());
+  const double en = intra_energy({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, *config,
+                                 visit.get(), &model);
+  EXPECT_NE(0., en);
+  EXPECT_NEAR(en, visit->energy(), std::abs(en)*1e-12);
+  model.compute(config.get(), visit.get());
+  EXPECT_NEAR(en, visit->energy(), std::abs(en)*1e-12);
+
+  // some sites, such as after a partial regrowth
+  const std::vector<int> sites = {7, 2, 8};
+  Select select;
+  for (const int site : sites) {
+    select.add_site(0, site);
+  }
+  model.compute(select, config.get(), visit.get());
+  const double en_select = intra_energy(sites, *config, visit.get(), &model);
+  EXPECT_NEAR(en_select, visit->energy(), std::abs(en_select)*1e-12);
+
+  // serialization rebuilds the pair list
+  auto visit2 = test_serialize<VisitModelIntraMap, VisitModel>(*visit);
+  model.compute(all, config.get(), visit2.get());
+  EXPECT_NEAR(en, visit2->energy(), std::abs(en)*1e-12);
+}
+
+}  // namespace feasst
@@ -67,6 +67,13 @@ class Checkpoint {
     file.close();
   }
 
+  /// Return true if the next call to check would write or terminate.
+  bool is_due() const {
+    const double hours = cpu_hours();
+    return hours > previous_hours_ + num_hours_ ||
+      (num_hours_terminate_ > 0 && hours > first_hours_ + num_hours_terminate_);
+  }
+
   /// Write object to checkpoint_file if num_hours has passed since previous.
   template <typename T>
   void check(const T& obj) {
@@ -0,0 +1,129 @@
+#ifndef FEASST_UTILS_PROFILER_H_
+#define FEASST_UTILS_PROFILER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace feasst {
+
+/**
+  Profiler records the cycles spent in nested sections of the code, such as
+  the selection, perturbation, each Potential and Criteria of a Trial.
+  Sections are identified by integers obtained once from their name with
+  section(), and timed with a ProfileScope.
+  The time of a section is recorded in a node of a tree given by the stack of
+  sections that are open when the section begins, such that the same Potential
+  is reported separately for each Trial.
+  For each node, the number of calls, the total cycles, a histogram of the
+  cycles in powers of two for approximate percentiles, and a generic counter
+  (e.g., the number of pairs of sites evaluated) are recorded.
+
+  Each thread has its own Profiler, which is disabled by default.
+  When disabled, the cost of a ProfileScope is a single branch.
+  On x86, cycles are measured with rdtsc.
+  Otherwise, cycles are replaced with nanoseconds of a steady clock.
+ */
+class Profiler {
+ public:
+  /// Return the Profiler of the current thread.
+  static Profiler * thread_profiler();
+
+  /// Return the integer that identifies a section with the given name.
+  /// The identifiers are shared by all threads.
+  static int section(const std::string& name);
+
+  /// Return the name of the section.
+  static std::string section_name(const int section);
+
+  /// Enable or disable profiling.
+  void enable(const bool enabled = true) { is_enabled_ = enabled; }
+
+  /// Return true if enabled.
+  bool is_enabled() const { return is_enabled_; }
+
+  /// Begin a section.
+  void begin(const int section);
+
+  /// End the most recent section.
+  void end();
+
+  /// Add to the counter of the most recent section, if enabled.
+  void count(const int64_t num = 1) {
+    if (is_enabled_) counts_[current_] += num;
+  }
+
+  /// Clear all recorded data.
+  void reset();
+
+  /// Return the number of nodes, including the root.
+  int num_nodes() const { return static_cast<int>(section_.size()); }
+
+  /// Return the path of the node as section names separated by "/".
+  std::string path(const int node) const;
+
+  /// Return the node index of the given path, or -1 if not found.
+  int node(const std::string& path) const;
+
+  /// Return the number of calls to the node.
+  int64_t calls(const int node) const { return calls_[node]; }
+
+  /// Return the total cycles of the node.
+  uint64_t cycles(const int node) const { return cycles_[node]; }
+
+  /// Return the counter of the node.
+  int64_t counts(const int node) const { return counts_[node]; }
+
+  /// Return the approximate percentile (between 0 and 1) of the cycles per
+  /// call of the node.
+  double percentile(const int node, const double fraction) const;
+
+  /// Return a comma-separated table with one line per node.
+  std::string csv() const;
+
+  /// Return the same data as above in JSON format.
+  std::string json() const;
+
+  Profiler();
+
+ private:
+  static const int num_hist_ = 64;
+  bool is_enabled_ = false;
+  int current_ = 0;
+  std::vector<int> section_;
+  std::vector<int> parent_;
+  std::vector<std::vector<int> > children_;
+  std::vector<int64_t> calls_;
+  std::vector<uint64_t> cycles_;
+  std::vector<uint64_t> max_cycles_;
+  std::vector<int64_t> counts_;
+  std::vector<std::vector<int64_t> > histogram_;
+  std::vector<uint64_t> start_;
+
+  int add_node_(const int section, const int parent);
+  static uint64_t clock_();
+};
+
+/**
+  Time a section of the code from construction to destruction, if the
+  Profiler of the current thread is enabled.
+ */
+class ProfileScope {
+ public:
+  explicit ProfileScope(const int section)
+    : profiler_(Profiler::thread_profiler()) {
+    if (profiler_->is_enabled()) {
+      profiler_->begin(section);
+    } else {
+      profiler_ = nullptr;
+    }
+  }
+  ~ProfileScope() { if (profiler_) profiler_->end(); }
+
+ private:
+  Profiler * profiler_;
+};
+
+}  // namespace feasst
+
+#endif  // FEASST_UTILS_PROFILER_H_
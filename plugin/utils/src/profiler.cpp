@@ -0,0 +1,215 @@
+#ifdef IS_X86
+  #include <x86intrin.h>
+#endif
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include "utils/include/debug.h"
+#include "utils/include/profiler.h"
+
+namespace feasst {
+
+// section names shared by all threads
+static std::vector<std::string>& section_names_() {
+  static std::vector<std::string> * names = new std::vector<std::string>();
+  return *names;
+}
+
+static std::mutex& section_mutex_() {
+  static std::mutex * mutex = new std::mutex();
+  return *mutex;
+}
+
+Profiler::Profiler() {
+  reset();
+}
+
+Profiler * Profiler::thread_profiler() {
+  static thread_local Profiler profiler;
+  return &profiler;
+}
+
+int Profiler::section(const std::string& name) {
+  std::lock_guard<std::mutex> lock(section_mutex_());
+  std::vector<std::string>& names = section_names_();
+  for (int index = 0; index < static_cast<int>(names.size()); ++index) {
+    if (names[index] == name) {
+      return index;
+    }
+  }
+  names.push_back(name);
+  return static_cast<int>(names.size()) - 1;
+}
+
+std::string Profiler::section_name(const int section) {
+  std::lock_guard<std::mutex> lock(section_mutex_());
+  return section_names_()[section];
+}
+
+uint64_t Profiler::clock_() {
+  #ifdef IS_X86
+    return __rdtsc();
+  #else
+    return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  #endif
+}
+
+void Profiler::reset() {
+  section_.clear();
+  parent_.clear();
+  children_.clear();
+  calls_.clear();
+  cycles_.clear();
+  max_cycles_.clear();
+  counts_.clear();
+  histogram_.clear();
+  start_.clear();
+  add_node_(-1, -1);
+  current_ = 0;
+}
+
+int Profiler::add_node_(const int section, const int parent) {
+  const int node = num_nodes();
+  section_.push_back(section);
+  parent_.push_back(parent);
+  children_.push_back(std::vector<int>());
+  calls_.push_back(0);
+  cycles_.push_back(0);
+  max_cycles_.push_back(0);
+  counts_.push_back(0);
+  histogram_.push_back(std::vector<int64_t>(num_hist_, 0));
+  start_.push_back(0);
+  if (parent != -1) {
+    children_[parent].push_back(node);
+  }
+  return node;
+}
+
+void Profiler::begin(const int section) {
+  int child = -1;
+  for (const int node : children_[current_]) {
+    if (section_[node] == section) {
+      child = node;
+      break;
+    }
+  }
+  if (child == -1) {
+    child = add_node_(section, current_);
+  }
+  current_ = child;
+  start_[current_] = clock_();
+}
+
+void Profiler::end() {
+  if (current_ == 0) {
+    return;
+  }
+  const uint64_t cycles = clock_() - start_[current_];
+  ++calls_[current_];
+  cycles_[current_] += cycles;
+  if (cycles > max_cycles_[current_]) {
+    max_cycles_[current_] = cycles;
+  }
+  int bin = 0;
+  while (bin < num_hist_ - 1 && (cycles >> (bin + 1)) > 0) {
+    ++bin;
+  }
+  ++histogram_[current_][bin];
+  current_ = parent_[current_];
+}
+
+std::string Profiler::path(const int node) const {
+  if (node <= 0) {
+    return std::string("");
+  }
+  std::string name = section_name(section_[node]);
+  if (parent_[node] > 0) {
+    return path(parent_[node]) + "/" + name;
+  }
+  return name;
+}
+
+int Profiler::node(const std::string& path) const {
+  for (int index = 1; index < num_nodes(); ++index) {
+    if (this->path(index) == path) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+double Profiler::percentile(const int node, const double fraction) const {
+  ASSERT(fraction >= 0. && fraction <= 1., "fraction: " << fraction);
+  if (calls_[node] == 0) {
+    return 0.;
+  }
+  const double target = fraction*static_cast<double>(calls_[node]);
+  int64_t sum = 0;
+  for (int bin = 0; bin < num_hist_; ++bin) {
+    sum += histogram_[node][bin];
+    if (static_cast<double>(sum) >= target && histogram_[node][bin] > 0) {
+      // center of [2^bin, 2^(bin+1)), bounded by the maximum
+      const double value = 1.5*static_cast<double>(uint64_t(1) << bin);
+      if (value > static_cast<double>(max_cycles_[node])) {
+        return static_cast<double>(max_cycles_[node]);
+      }
+      return value;
+    }
+  }
+  return static_cast<double>(max_cycles_[node]);
+}
+
+std::string Profiler::csv() const {
+  uint64_t total = 0;
+  for (const int node : children_[0]) {
+    total += cycles_[node];
+  }
+  std::stringstream ss;
+  ss << "path,calls,total_cycles,percent,mean_cycles,p50_cycles,p90_cycles,"
+     << "p99_cycles,max_cycles,counts" << std::endl;
+  for (int node = 1; node < num_nodes(); ++node) {
+    double mean = 0.;
+    if (calls_[node] > 0) {
+      mean = static_cast<double>(cycles_[node])/
+             static_cast<double>(calls_[node]);
+    }
+    double percent = 0.;
+    if (total > 0) {
+      percent = 100.*static_cast<double>(cycles_[node])/
+                static_cast<double>(total);
+    }
+    ss << path(node) << ","
+       << calls_[node] << ","
+       << cycles_[node] << ","
+       << percent << ","
+       << mean << ","
+       << percentile(node, 0.5) << ","
+       << percentile(node, 0.9) << ","
+       << percentile(node, 0.99) << ","
+       << max_cycles_[node] << ","
+       << counts_[node] << std::endl;
+  }
+  return ss.str();
+}
+
+std::string Profiler::json() const {
+  std::stringstream ss;
+  ss << "{\"sections\": [";
+  for (int node = 1; node < num_nodes(); ++node) {
+    if (node > 1) ss << ",";
+    ss << std::endl << "  {\"path\": \"" << path(node) << "\", "
+       << "\"calls\": " << calls_[node] << ", "
+       << "\"total_cycles\": " << cycles_[node] << ", "
+       << "\"p50_cycles\": " << percentile(node, 0.5) << ", "
+       << "\"p90_cycles\": " << percentile(node, 0.9) << ", "
+       << "\"p99_cycles\": " << percentile(node, 0.99) << ", "
+       << "\"max_cycles\": " << max_cycles_[node] << ", "
+       << "\"counts\": " << counts_[node] << "}";
+  }
+  ss << std::endl << "]}" << std::endl;
+  return ss.str();
+}
+
+}  // namespace feasst
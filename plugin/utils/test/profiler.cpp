@@ -0,0 +1,53 @@
+#include "utils/test/utils.h"
+#include "utils/include/profiler.h"
+
+namespace feasst {
+
+TEST(Profiler, nested) {
+  Profiler profiler;
+  profiler.enable();
+  const int outer = Profiler::section("outer");
+  const int inner = Profiler::section("inner");
+  EXPECT_EQ(outer, Profiler::section("outer"));
+  EXPECT_EQ("inner", Profiler::section_name(inner));
+  for (int call = 0; call < 10; ++call) {
+    profiler.begin(outer);
+    profiler.begin(inner);
+    profiler.count(3);
+    profiler.end();
+    profiler.end();
+  }
+  profiler.begin(inner);
+  profiler.end();
+  EXPECT_EQ(4, profiler.num_nodes());
+  const int node = profiler.node("outer/inner");
+  EXPECT_GT(node, 0);
+  EXPECT_EQ("outer/inner", profiler.path(node));
+  EXPECT_EQ(10, profiler.calls(node));
+  EXPECT_EQ(30, profiler.counts(node));
+  EXPECT_EQ(1, profiler.calls(profiler.node("inner")));
+  EXPECT_EQ(-1, profiler.node("inner/outer"));
+  EXPECT_GE(profiler.cycles(profiler.node("outer")), profiler.cycles(node));
+  EXPECT_LE(profiler.percentile(node, 0.5), profiler.percentile(node, 0.99));
+  DEBUG(profiler.csv());
+  DEBUG(profiler.json());
+  profiler.reset();
+  EXPECT_EQ(1, profiler.num_nodes());
+}
+
+TEST(Profiler, scope) {
+  Profiler * profiler = Profiler::thread_profiler();
+  const int section = Profiler::section("scope");
+  { ProfileScope scope(section); }
+  EXPECT_EQ(1, profiler->num_nodes());
+  profiler->enable();
+  { ProfileScope scope(section);
+    profiler->count();
+  }
+  EXPECT_EQ(1, profiler->calls(profiler->node("scope")));
+  EXPECT_EQ(1, profiler->counts(profiler->node("scope")));
+  profiler->enable(false);
+  profiler->reset();
+}
+
+}  // namespace feasst